@@ -0,0 +1,116 @@
+/**
+ * @file batch_lookup_benchmark.cpp
+ * @brief 批量查找与批量修改成绩：逐个调用 vs 预取流水线
+ *
+ * 200 万名学生（远大于缓存），每次随机查找或修改 10 万个学号。
+ * 参数为 0 时使用纯数字学号，为 1 时使用带字母前缀的学号（按字符串比较）。
+ *
+ * 运行示例：
+ *   ./student_manager_benchmark --benchmark_filter=Batch
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "student_manager/student_manager.h"
+
+using namespace student_manager;
+
+namespace {
+
+  constexpr int kStudents = 2'000'000;
+  constexpr int kLookups = 100'000;
+
+  std::string id_of(int i, bool textual) {
+    return (textual ? "S" : "") + std::to_string(2000000000 + i);
+  }
+
+  StudentManager& roster(bool textual) {
+    auto build = [](bool text) {
+      StudentManager result;
+      result.reserve(kStudents);
+      for (int i = 0; i < kStudents; ++i) {
+        result.add_student(Student("学生", id_of(i, text), 60.0));
+      }
+      return result;
+    };
+    static StudentManager numeric = build(false);
+    static StudentManager text = build(true);
+    return textual ? text : numeric;
+  }
+
+  std::vector<std::string> random_ids(bool textual) {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> dist(0, kStudents - 1);
+    std::vector<std::string> ids;
+    ids.reserve(kLookups);
+    for (int i = 0; i < kLookups; ++i) {
+      ids.push_back(id_of(dist(rng), textual));
+    }
+    return ids;
+  }
+
+  void BM_FindLoop(benchmark::State& state) {
+    bool textual = state.range(0) != 0;
+    const auto& manager = roster(textual);
+    auto ids = random_ids(textual);
+    for (auto _ : state) {
+      for (const auto& id : ids) {
+        benchmark::DoNotOptimize(manager.find_student(id));
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * kLookups);
+  }
+
+  void BM_FindBatch(benchmark::State& state) {
+    bool textual = state.range(0) != 0;
+    const auto& manager = roster(textual);
+    auto ids = random_ids(textual);
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(manager.find_students(ids));
+    }
+    state.SetItemsProcessed(state.iterations() * kLookups);
+  }
+
+  std::vector<std::pair<std::string, double>> random_updates(bool textual) {
+    std::vector<std::pair<std::string, double>> updates;
+    double score = 0.0;
+    for (auto& id : random_ids(textual)) {
+      updates.emplace_back(std::move(id), score);
+      score = score < 100.0 ? score + 0.5 : 0.0;
+    }
+    return updates;
+  }
+
+  void BM_UpdateLoop(benchmark::State& state) {
+    bool textual = state.range(0) != 0;
+    auto& manager = roster(textual);
+    auto updates = random_updates(textual);
+    for (auto _ : state) {
+      for (const auto& [id, score] : updates) {
+        benchmark::DoNotOptimize(manager.update_score(id, score));
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * kLookups);
+  }
+
+  void BM_UpdateBatch(benchmark::State& state) {
+    bool textual = state.range(0) != 0;
+    auto& manager = roster(textual);
+    auto updates = random_updates(textual);
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(manager.update_scores(updates));
+    }
+    state.SetItemsProcessed(state.iterations() * kLookups);
+  }
+
+}  // namespace
+
+BENCHMARK(BM_FindLoop)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FindBatch)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_UpdateLoop)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_UpdateBatch)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
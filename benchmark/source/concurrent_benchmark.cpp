@@ -0,0 +1,120 @@
+/**
+ * @file concurrent_benchmark.cpp
+ * @brief 多线程点操作的吞吐量：全局互斥锁 vs 分片读写锁
+ *
+ * 每个线程循环执行 8 次查找 + 1 次改分 + 1 次删除再添加（学号在 10 万名学生中均匀随机），
+ * 线程数从 1 增加到处理器核心数的 2 倍。items_per_second 即所有线程合计每秒完成的操作数。
+ *
+ * 运行示例：
+ *   ./student_manager_benchmark --benchmark_filter=Concurrent
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "student_manager/concurrent_student_manager.h"
+#include "student_manager/student_manager.h"
+
+using namespace student_manager;
+
+namespace {
+
+  constexpr int kStudents = 100'000;
+
+  const std::vector<std::string>& student_ids() {
+    static const std::vector<std::string> ids = [] {
+      std::vector<std::string> result;
+      result.reserve(kStudents);
+      for (int i = 0; i < kStudents; ++i) {
+        result.push_back(std::to_string(2023000000 + i));
+      }
+      return result;
+    }();
+    return ids;
+  }
+
+  /// 对照组：一把全局互斥锁保护的 StudentManager
+  struct LockedManager {
+    std::mutex mutex;
+    StudentManager students;
+
+    bool find(const std::string& id) {
+      std::lock_guard<std::mutex> lock(mutex);
+      return students.find_student(id).has_value();
+    }
+    void update(const std::string& id, double score) {
+      std::lock_guard<std::mutex> lock(mutex);
+      students.update_score(id, score);
+    }
+    void replace(const std::string& id) {
+      std::lock_guard<std::mutex> lock(mutex);
+      students.remove_student(id);
+      students.add_student(Student("学生", id, 60.0));
+    }
+  };
+
+  struct ShardedManager {
+    ConcurrentStudentManager students;
+
+    bool find(const std::string& id) { return students.contains(id); }
+    void update(const std::string& id, double score) { students.update_score(id, score); }
+    void replace(const std::string& id) {
+      students.remove_student(id);
+      students.add_student(Student("学生", id, 60.0));
+    }
+  };
+
+  /// 所有线程共享同一个已填充好的管理器（静态局部变量的初始化是线程安全的）
+  template <typename Manager> Manager& shared_manager() {
+    static Manager* manager = [] {
+      auto* result = new Manager();
+      for (const auto& id : student_ids()) {
+        result->students.add_student(Student("学生", id, 60.0));
+      }
+      return result;
+    }();
+    return *manager;
+  }
+
+  template <typename Manager> void run_point_operations(benchmark::State& state) {
+    Manager& manager = shared_manager<Manager>();
+    const auto& ids = student_ids();
+    std::mt19937 rng(static_cast<unsigned>(state.thread_index()));
+    std::uniform_int_distribution<int> pick(0, kStudents - 1);
+    std::int64_t operations = 0;
+    for (auto _ : state) {
+      for (int i = 0; i < 8; ++i) {
+        benchmark::DoNotOptimize(manager.find(ids[pick(rng)]));
+      }
+      manager.update(ids[pick(rng)], pick(rng) % 101);
+      manager.replace(ids[pick(rng)]);
+      operations += 10;
+    }
+    state.SetItemsProcessed(operations);
+  }
+
+  void BM_ConcurrentGlobalMutex(benchmark::State& state) {
+    run_point_operations<LockedManager>(state);
+  }
+
+  void BM_ConcurrentSharded(benchmark::State& state) {
+    run_point_operations<ShardedManager>(state);
+  }
+
+  void thread_counts(benchmark::internal::Benchmark* bench) {
+    int max_threads = 2 * static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+      bench->Threads(threads);
+    }
+  }
+
+}  // namespace
+
+BENCHMARK(BM_ConcurrentGlobalMutex)->Apply(thread_counts)->UseRealTime();
+BENCHMARK(BM_ConcurrentSharded)->Apply(thread_counts)->UseRealTime();
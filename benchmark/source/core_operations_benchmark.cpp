@@ -0,0 +1,231 @@
+/**
+ * @file core_operations_benchmark.cpp
+ * @brief StudentManager 核心操作的回归测试：添加、查找（命中 / 未命中）、删除、增删交替和统计
+ *
+ * 每个测试有两个参数：
+ * - rows：学生人数，从 1000 到 1000 万
+ * - ids：学号分布
+ *   - 0 顺序：连续的学号按顺序添加，查找和删除访问一段连续的学号（如按班级名单逐个录入）
+ *   - 1 随机：分散的 10 位学号按随机顺序添加，查找和删除均匀随机
+ *   - 2 偏斜：学号与"随机"相同，但查找集中在少数学生上（排名按对数均匀分布，近似 Zipf 分布，
+ *     最热门的 1% 学生约占一半以上的查找）
+ *
+ * 每次迭代处理一批学号，items_per_second 即每秒完成的操作数，倒数就是单次操作的耗时。
+ * 统计函数与学号分布无关，只按学生人数参数化。
+ *
+ * 输出 JSON 供版本之间比较（也可以构建 benchmark_json 目标）：
+ *   ./student_manager_benchmark --benchmark_filter=Core \
+ *       --benchmark_out=results.json --benchmark_out_format=json
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "student_manager/student_manager.h"
+
+using namespace student_manager;
+
+namespace {
+
+  /// 每次迭代查找、删除或增删的学号个数
+  constexpr std::size_t kBatch = 1024;
+
+  enum class IdDistribution { sequential = 0, random = 1, skewed = 2 };
+
+  /// 第 i 个学生的学号：顺序分布为连续整数；随机分布用与 9e9 互素的乘数打散到全部 10 位数上
+  /// （这是一个双射，不同的 i 得到不同的学号，i >= rows 的学号一定不在名单中）
+  std::string id_of(std::uint64_t i, IdDistribution distribution) {
+    if (distribution == IdDistribution::sequential) {
+      return std::to_string(2023000000 + i);
+    }
+    constexpr std::uint64_t kRange = 9'000'000'000;
+    constexpr std::uint64_t kMultiplier = 2654435761;  // 不是 2、3、5 的倍数
+    return std::to_string(1'000'000'000 + (i * kMultiplier + 12345) % kRange);
+  }
+
+  /// 一组测试参数对应的学生名单和查询用的学号
+  struct Dataset {
+    std::size_t rows = 0;
+    IdDistribution distribution = IdDistribution::sequential;
+    StudentManager roster;
+    std::vector<std::string> hits;     ///< 名单中的学号，按查找分布抽取（可能重复）
+    std::vector<std::string> misses;   ///< 不在名单中的学号
+    std::vector<std::string> victims;  ///< 名单中互不相同的学号，用于删除
+  };
+
+  /// 按查找分布抽取 kBatch 个行号
+  std::vector<std::uint64_t> sample_rows(std::size_t rows, IdDistribution distribution) {
+    std::mt19937_64 rng(42);
+    std::vector<std::uint64_t> picked(kBatch);
+    switch (distribution) {
+      case IdDistribution::sequential: {
+        std::uint64_t start = rows > kBatch ? rng() % (rows - kBatch) : 0;
+        for (std::size_t i = 0; i < kBatch; ++i) {
+          picked[i] = (start + i) % rows;
+        }
+        break;
+      }
+      case IdDistribution::random:
+        for (auto& row : picked) {
+          row = rng() % rows;
+        }
+        break;
+      case IdDistribution::skewed: {
+        // 排名 = rows^u - 1，u 在 [0, 1) 上均匀分布：排名越小越热门
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        for (auto& row : picked) {
+          auto rank = static_cast<std::uint64_t>(std::pow(static_cast<double>(rows), unit(rng)));
+          row = std::min<std::uint64_t>(rank, rows) - 1;
+        }
+        break;
+      }
+    }
+    return picked;
+  }
+
+  /**
+   * @brief 取得一组参数的数据集
+   * @note 只缓存最近一组：1000 万名学生的名单占用较多内存，同一个测试的不同参数之间不共享
+   */
+  Dataset& dataset(const benchmark::State& state) {
+    static std::unique_ptr<Dataset> cached;
+    auto rows = static_cast<std::size_t>(state.range(0));
+    auto distribution = static_cast<IdDistribution>(state.range(1));
+    if (cached && cached->rows == rows && cached->distribution == distribution) {
+      return *cached;
+    }
+    cached.reset();
+    auto data = std::make_unique<Dataset>();
+    data->rows = rows;
+    data->distribution = distribution;
+    data->roster.reserve(rows);
+    for (std::size_t i = 0; i < rows; ++i) {
+      data->roster.add_student(
+          Student("学生", id_of(i, distribution), static_cast<double>(i % 10001) / 100.0));
+    }
+    std::unordered_set<std::uint64_t> seen;
+    for (std::uint64_t row : sample_rows(rows, distribution)) {
+      data->hits.push_back(id_of(row, distribution));
+      if (seen.insert(row).second) {
+        data->victims.push_back(data->hits.back());
+      }
+    }
+    for (std::size_t i = 0; i < kBatch; ++i) {
+      data->misses.push_back(id_of(rows + i, distribution));
+    }
+    cached = std::move(data);
+    return *cached;
+  }
+
+  void BM_CoreInsert(benchmark::State& state) {
+    auto rows = static_cast<std::size_t>(state.range(0));
+    auto distribution = static_cast<IdDistribution>(state.range(1));
+    std::vector<std::string> ids;
+    ids.reserve(rows);
+    for (std::size_t i = 0; i < rows; ++i) {
+      ids.push_back(id_of(i, distribution));
+    }
+    for (auto _ : state) {
+      StudentManager manager;
+      for (const auto& id : ids) {
+        manager.add_student(Student("学生", id, 60.0));
+      }
+      benchmark::DoNotOptimize(manager.get_student_count());
+      state.PauseTiming();  // 不计入析构的时间
+      manager.clear();
+      state.ResumeTiming();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * rows));
+  }
+
+  void BM_CoreLookupHit(benchmark::State& state) {
+    const auto& data = dataset(state);
+    for (auto _ : state) {
+      for (const auto& id : data.hits) {
+        benchmark::DoNotOptimize(data.roster.find_student(id));
+      }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * data.hits.size()));
+  }
+
+  void BM_CoreLookupMiss(benchmark::State& state) {
+    const auto& data = dataset(state);
+    for (auto _ : state) {
+      for (const auto& id : data.misses) {
+        benchmark::DoNotOptimize(data.roster.find_student(id));
+      }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * data.misses.size()));
+  }
+
+  void BM_CoreRemove(benchmark::State& state) {
+    auto& data = dataset(state);
+    for (auto _ : state) {
+      for (const auto& id : data.victims) {
+        benchmark::DoNotOptimize(data.roster.remove_student(id));
+      }
+      state.PauseTiming();  // 把删除的学生加回去，名单保持原来的人数
+      for (const auto& id : data.victims) {
+        data.roster.add_student(Student("学生", id, 60.0));
+      }
+      state.ResumeTiming();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * data.victims.size()));
+  }
+
+  void BM_CoreChurn(benchmark::State& state) {
+    auto& data = dataset(state);
+    // 删除一个学生后马上重新添加（学生转班、重新注册），人数保持不变
+    for (auto _ : state) {
+      for (const auto& id : data.victims) {
+        data.roster.remove_student(id);
+        benchmark::DoNotOptimize(data.roster.add_student(Student("学生", id, 75.0)));
+      }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * data.victims.size()));
+  }
+
+  void BM_CoreAggregates(benchmark::State& state) {
+    const auto& data = dataset(state);
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(data.roster.calculate_average_score());
+      benchmark::DoNotOptimize(data.roster.get_max_score());
+      benchmark::DoNotOptimize(data.roster.get_min_score());
+    }
+  }
+
+  void BM_CoreStatistics(benchmark::State& state) {
+    const auto& data = dataset(state);
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(data.roster.compute_statistics());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * data.rows));
+  }
+
+  const std::vector<std::int64_t> kRowCounts = {1'000, 10'000, 100'000, 1'000'000, 10'000'000};
+
+  void all_distributions(benchmark::internal::Benchmark* bench) {
+    bench->ArgNames({"rows", "ids"})->ArgsProduct({kRowCounts, {0, 1, 2}});
+  }
+
+  void sequential_only(benchmark::internal::Benchmark* bench) {
+    bench->ArgNames({"rows", "ids"})->ArgsProduct({kRowCounts, {0}});
+  }
+
+}  // namespace
+
+BENCHMARK(BM_CoreInsert)->Apply(all_distributions)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CoreLookupHit)->Apply(all_distributions);
+BENCHMARK(BM_CoreLookupMiss)->Apply(all_distributions);
+BENCHMARK(BM_CoreRemove)->Apply(all_distributions);
+BENCHMARK(BM_CoreChurn)->Apply(all_distributions);
+BENCHMARK(BM_CoreAggregates)->Apply(sequential_only);
+BENCHMARK(BM_CoreStatistics)->Apply(sequential_only)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,78 @@
+/**
+ * @file name_index_benchmark.cpp
+ * @brief 按姓名查找：姓名索引 vs 遍历学生列表
+ *
+ * 100 万名学生，姓名由常见姓氏和名字随机组合（大量重名）。
+ * 分别测试精确查找、前缀查找（最多 20 个，模拟输入时的自动补全）和包含查找。
+ *
+ * 运行示例：
+ *   ./student_manager_benchmark --benchmark_filter=Name
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "student_manager/student_manager.h"
+
+using namespace student_manager;
+
+namespace {
+
+  constexpr int kStudents = 1'000'000;
+
+  /// state.range(0) 为 1 时启用姓名索引
+  const StudentManager& roster(bool indexed) {
+    static const StudentManager plain = [] {
+      const std::vector<std::string> surnames
+          = {"张", "王", "李", "赵", "刘", "陈", "杨", "黄", "周", "吴", "欧阳", "司马"};
+      const std::vector<std::string> given = {"伟", "芳", "娜", "敏", "静", "丽", "强", "磊",
+                                              "军", "洋", "勇", "艳", "杰", "涛", "明", "超"};
+      std::mt19937 rng(2024);
+      StudentManager result;
+      result.reserve(kStudents);
+      for (int i = 0; i < kStudents; ++i) {
+        std::string name = surnames[rng() % surnames.size()] + given[rng() % given.size()];
+        if (rng() % 2 == 0) {
+          name += given[rng() % given.size()];
+        }
+        result.add_student(Student(name, std::to_string(2000000000 + i), 60.0));
+      }
+      return result;
+    }();
+    static const StudentManager with_index = [] {
+      StudentManager result(plain);
+      result.enable_name_index();
+      return result;
+    }();
+    return indexed ? with_index : plain;
+  }
+
+  void BM_NameExact(benchmark::State& state) {
+    const auto& manager = roster(state.range(0) != 0);
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(manager.find_students_by_name("司马伟杰"));
+    }
+  }
+
+  void BM_NamePrefix(benchmark::State& state) {
+    const auto& manager = roster(state.range(0) != 0);
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(manager.find_students_by_name_prefix("欧阳明", 20));
+    }
+  }
+
+  void BM_NameSubstring(benchmark::State& state) {
+    const auto& manager = roster(state.range(0) != 0);
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(manager.find_students_by_name_substring("涛超"));
+    }
+  }
+
+}  // namespace
+
+BENCHMARK(BM_NameExact)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_NamePrefix)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_NameSubstring)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
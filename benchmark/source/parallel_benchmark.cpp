@@ -0,0 +1,84 @@
+/**
+ * @file parallel_benchmark.cpp
+ * @brief 并行扫描的扩展性：线程数从 1 增加到处理器核心数
+ *
+ * 对 1000 万个成绩计算完整统计报告、求和，以及按条件统计学生人数。
+ * 参数是使用的线程数，结果与线程数无关，只有耗时不同。
+ *
+ * 运行示例：
+ *   ./student_manager_benchmark --benchmark_filter=Parallel
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "student_manager/parallel.h"
+#include "student_manager/student_manager.h"
+
+using namespace student_manager;
+
+namespace {
+
+  constexpr std::size_t kRows = 10'000'000;
+
+  const StudentManager& roster() {
+    static const StudentManager manager = [] {
+      std::mt19937 rng(2024);
+      std::uniform_real_distribution<double> dist(0.0, 100.0);
+      StudentManager result;
+      result.reserve(kRows);
+      for (std::size_t i = 0; i < kRows; ++i) {
+        result.add_student(Student("学生", std::to_string(i), dist(rng)));
+      }
+      return result;
+    }();
+    return manager;
+  }
+
+  ParallelOptions threads_of(const benchmark::State& state) {
+    return ParallelOptions{static_cast<std::size_t>(state.range(0))};
+  }
+
+  void BM_ParallelStatistics(benchmark::State& state) {
+    const auto& manager = roster();
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(manager.compute_statistics(threads_of(state)));
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kRows));
+  }
+
+  void BM_ParallelSum(benchmark::State& state) {
+    const auto& scores = roster().get_scores();
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(parallel::sum(scores.data(), scores.size(), threads_of(state)));
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kRows));
+  }
+
+  void BM_ParallelCountIf(benchmark::State& state) {
+    const auto& manager = roster();
+    auto failed = [](const Student& student) { return student.get_score() < 60.0; };
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(manager.count_students_if(failed, threads_of(state)));
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kRows));
+  }
+
+  void thread_counts(benchmark::internal::Benchmark* bench) {
+    int max_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (int threads = 1; threads < max_threads; threads *= 2) {
+      bench->Arg(threads);
+    }
+    bench->Arg(max_threads);
+  }
+
+}  // namespace
+
+BENCHMARK(BM_ParallelStatistics)->Apply(thread_counts)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParallelSum)->Apply(thread_counts)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParallelCountIf)->Apply(thread_counts)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,98 @@
+/**
+ * @file report_writer_benchmark.cpp
+ * @brief 输出全部学生：ReportWriter vs 逐个字段 std::setw
+ *
+ * 10 万名学生，输出到一个丢弃数据的流，只测量格式化和写入流的开销。
+ * BM_ReportSetw 是原来交互程序中"显示所有学生"的写法；BM_ReportWriter 的参数为
+ * 排序方式（0 不排序，1 按学号，2 按姓名，3 按成绩），包括创建报表（排序、计算列宽）的时间。
+ *
+ * 运行示例：
+ *   ./student_manager_benchmark --benchmark_filter=Report
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <iomanip>
+#include <ostream>
+#include <random>
+#include <streambuf>
+#include <string>
+
+#include "student_manager/report_writer.h"
+#include "student_manager/student_manager.h"
+
+using namespace student_manager;
+
+namespace {
+
+  constexpr int kStudents = 100'000;
+
+  /// 丢弃所有数据的流缓冲区，记录写入的字节数
+  class NullBuffer : public std::streambuf {
+  public:
+    std::size_t written = 0;
+
+  protected:
+    int_type overflow(int_type c) override {
+      ++written;
+      return c;
+    }
+
+    std::streamsize xsputn(const char* /*data*/, std::streamsize count) override {
+      written += static_cast<std::size_t>(count);
+      return count;
+    }
+  };
+
+  const StudentManager& roster() {
+    static const StudentManager manager = [] {
+      const char* surnames[] = {"张", "王", "李", "赵", "欧阳", "Smith", "García"};
+      const char* given[] = {"伟", "芳", "娜", "敏", "静", "John", "María"};
+      std::mt19937 rng(2024);
+      StudentManager result;
+      result.reserve(kStudents);
+      for (int i = 0; i < kStudents; ++i) {
+        std::string name = std::string(surnames[rng() % 7]) + given[rng() % 7];
+        double score = static_cast<double>(rng() % 10001) / 100.0;
+        result.add_student(Student(name, std::to_string(2000000000 + rng() % 900000000), score));
+      }
+      return result;
+    }();
+    return manager;
+  }
+
+  void BM_ReportSetw(benchmark::State& state) {
+    const auto& manager = roster();
+    NullBuffer buffer;
+    std::ostream out(&buffer);
+    for (auto _ : state) {
+      out << std::left << std::setw(15) << "姓名" << std::setw(15) << "学号" << std::setw(10)
+          << "成绩" << "\n";
+      out << std::string(40, '-') << "\n";
+      for (const auto& student : manager) {
+        out << std::setw(15) << student.get_name() << std::setw(15) << student.get_id()
+            << std::setw(10) << student.get_score() << "\n";
+      }
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(buffer.written));
+    state.SetItemsProcessed(state.iterations() * kStudents);
+  }
+
+  void BM_ReportWriter(benchmark::State& state) {
+    const auto& manager = roster();
+    NullBuffer buffer;
+    std::ostream out(&buffer);
+    ReportOptions options;
+    options.order = static_cast<ReportOrder>(state.range(0));
+    for (auto _ : state) {
+      ReportWriter report(manager, options);
+      report.write_all(out);
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(buffer.written));
+    state.SetItemsProcessed(state.iterations() * kStudents);
+  }
+
+}  // namespace
+
+BENCHMARK(BM_ReportSetw)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ReportWriter)->DenseRange(0, 3)->Unit(benchmark::kMillisecond);
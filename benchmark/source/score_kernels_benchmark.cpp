@@ -0,0 +1,189 @@
+/**
+ * @file score_kernels_benchmark.cpp
+ * @brief 成绩统计内核的吞吐量测试
+ *
+ * 对 1000 万个成绩分别用三种指令集求和、求最小值、求最大值，
+ * 并与直接遍历 std::vector<Student> 的写法对比；另外对同样的成绩按定点格式
+ * （std::uint16_t，0.01 分为单位）运行 *Fixed 系列内核。
+ * 输出中的 bytes_per_second 即每秒处理的成绩数据量。
+ *
+ * 运行示例：
+ *   ./student_manager_benchmark --benchmark_filter=Kernel
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "student_manager/fixed_score.h"
+#include "student_manager/score_kernels.h"
+#include "student_manager/student_manager.h"
+
+using namespace student_manager;
+
+namespace {
+
+  constexpr std::size_t kRows = 10'000'000;
+
+  const std::vector<double>& score_column() {
+    static const std::vector<double> scores = [] {
+      std::mt19937 rng(2024);
+      std::uniform_real_distribution<double> dist(0.0, 100.0);
+      std::vector<double> column(kRows);
+      for (auto& score : column) {
+        score = dist(rng);
+      }
+      return column;
+    }();
+    return scores;
+  }
+
+  const std::vector<std::uint16_t>& fixed_column() {
+    static const std::vector<std::uint16_t> scores = [] {
+      std::vector<std::uint16_t> column;
+      column.reserve(kRows);
+      for (double score : score_column()) {
+        column.push_back(FixedScore::from_double(score)->raw());
+      }
+      return column;
+    }();
+    return scores;
+  }
+
+  const std::vector<Student>& student_rows() {
+    static const std::vector<Student> rows = [] {
+      const auto& scores = score_column();
+      std::vector<Student> students;
+      students.reserve(kRows);
+      for (std::size_t i = 0; i < kRows; ++i) {
+        students.emplace_back("学生", std::to_string(i), scores[i]);
+      }
+      return students;
+    }();
+    return rows;
+  }
+
+  template <typename Kernel> void run_kernel(benchmark::State& state, Kernel kernel) {
+    auto level = static_cast<kernels::SimdLevel>(state.range(0));
+    if (static_cast<int>(level) > static_cast<int>(kernels::detect_simd_level())) {
+      state.SkipWithError("CPU 不支持该指令集");
+      return;
+    }
+    const auto& scores = score_column();
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(kernel(scores.data(), scores.size(), level));
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations())
+                            * static_cast<std::int64_t>(scores.size() * sizeof(double)));
+    state.SetLabel(kernels::to_string(level));
+  }
+
+  template <typename Kernel> void run_fixed_kernel(benchmark::State& state, Kernel kernel) {
+    auto level = static_cast<kernels::SimdLevel>(state.range(0));
+    if (static_cast<int>(level) > static_cast<int>(kernels::detect_simd_level())) {
+      state.SkipWithError("CPU 不支持该指令集");
+      return;
+    }
+    const auto& scores = fixed_column();
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(kernel(scores.data(), scores.size(), level));
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations())
+                            * static_cast<std::int64_t>(scores.size() * sizeof(std::uint16_t)));
+    state.SetLabel(kernels::to_string(level));
+  }
+
+  void BM_KernelSum(benchmark::State& state) {
+    run_kernel(state, [](const double* data, std::size_t count, kernels::SimdLevel level) {
+      return kernels::sum(data, count, level);
+    });
+  }
+
+  void BM_KernelMin(benchmark::State& state) {
+    run_kernel(state, [](const double* data, std::size_t count, kernels::SimdLevel level) {
+      return kernels::min(data, count, level);
+    });
+  }
+
+  void BM_KernelMax(benchmark::State& state) {
+    run_kernel(state, [](const double* data, std::size_t count, kernels::SimdLevel level) {
+      return kernels::max(data, count, level);
+    });
+  }
+
+  void BM_KernelSumFixed(benchmark::State& state) {
+    run_fixed_kernel(state, [](const std::uint16_t* data, std::size_t count,
+                               kernels::SimdLevel level) {
+      return kernels::sum_fixed(data, count, level);
+    });
+  }
+
+  void BM_KernelMaxFixed(benchmark::State& state) {
+    run_fixed_kernel(state, [](const std::uint16_t* data, std::size_t count,
+                               kernels::SimdLevel level) {
+      return kernels::max_fixed(data, count, level);
+    });
+  }
+
+  void BM_StatisticsDouble(benchmark::State& state) {
+    const auto& scores = score_column();
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(compute_score_statistics(scores.data(), scores.size()));
+    }
+  }
+
+  void BM_StatisticsFixed(benchmark::State& state) {
+    const auto& scores = fixed_column();
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(compute_fixed_score_statistics(scores.data(), scores.size()));
+    }
+  }
+
+  /// 对照组：直接遍历学生对象（每行约 70 字节，只用到其中 8 字节）
+  void BM_RowSum(benchmark::State& state) {
+    const auto& students = student_rows();
+    for (auto _ : state) {
+      double total = std::accumulate(
+          students.begin(), students.end(), 0.0,
+          [](double sum, const Student& student) { return sum + student.get_score(); });
+      benchmark::DoNotOptimize(total);
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations())
+                            * static_cast<std::int64_t>(students.size() * sizeof(double)));
+  }
+
+  void BM_RowMax(benchmark::State& state) {
+    const auto& students = student_rows();
+    for (auto _ : state) {
+      auto it = std::max_element(
+          students.begin(), students.end(),
+          [](const Student& a, const Student& b) { return a.get_score() < b.get_score(); });
+      benchmark::DoNotOptimize(it->get_score());
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations())
+                            * static_cast<std::int64_t>(students.size() * sizeof(double)));
+  }
+
+  void simd_levels(benchmark::internal::Benchmark* bench) {
+    for (auto level :
+         {kernels::SimdLevel::scalar, kernels::SimdLevel::sse2, kernels::SimdLevel::avx2}) {
+      bench->Arg(static_cast<std::int64_t>(level));
+    }
+  }
+
+}  // namespace
+
+BENCHMARK(BM_KernelSum)->Apply(simd_levels)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_KernelMin)->Apply(simd_levels)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_KernelMax)->Apply(simd_levels)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_KernelSumFixed)->Apply(simd_levels)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_KernelMaxFixed)->Apply(simd_levels)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StatisticsDouble)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StatisticsFixed)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RowSum)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RowMax)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,79 @@
+/**
+ * @file score_matrix_benchmark.cpp
+ * @brief 多科目成绩：按列统计 vs 逐个学生计算
+ *
+ * 100 万名学生、10 个科目，每科约 90% 的学生有成绩。
+ * BM_SubjectAverage 计算一个科目的平均分（整列向量化求和）；
+ * BM_ComputeGpas 一次计算所有学生的 GPA（按列累加），BM_StudentGpaLoop 逐个学号调用 student_gpa()。
+ *
+ * 运行示例：
+ *   ./student_manager_benchmark --benchmark_filter=Subject\|Gpa
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <string>
+
+#include "student_manager/student_manager.h"
+
+using namespace student_manager;
+
+namespace {
+
+  constexpr int kStudents = 1'000'000;
+  constexpr int kSubjects = 10;
+
+  const StudentManager& roster() {
+    static const StudentManager manager = [] {
+      std::mt19937 rng(2024);
+      StudentManager result;
+      result.reserve(kStudents);
+      for (int i = 0; i < kStudents; ++i) {
+        result.add_student(Student("学生", std::to_string(2000000000 + i), 60.0));
+      }
+      for (int s = 0; s < kSubjects; ++s) {
+        std::size_t subject = *result.add_subject("科目" + std::to_string(s), 1.0 + s % 4);
+        for (int i = 0; i < kStudents; ++i) {
+          if (rng() % 10 != 0) {
+            result.set_subject_score(std::to_string(2000000000 + i), subject,
+                                     static_cast<double>(rng() % 10001) / 100.0);
+          }
+        }
+      }
+      return result;
+    }();
+    return manager;
+  }
+
+  void BM_SubjectAverage(benchmark::State& state) {
+    const auto& manager = roster();
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(manager.subject_average(3));
+    }
+    state.SetItemsProcessed(state.iterations() * kStudents);
+  }
+
+  void BM_ComputeGpas(benchmark::State& state) {
+    const auto& manager = roster();
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(manager.compute_gpas());
+    }
+    state.SetItemsProcessed(state.iterations() * kStudents);
+  }
+
+  void BM_StudentGpaLoop(benchmark::State& state) {
+    const auto& manager = roster();
+    for (auto _ : state) {
+      for (const Student& student : manager) {
+        benchmark::DoNotOptimize(manager.student_gpa(student.get_id()));
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * kStudents);
+  }
+
+}  // namespace
+
+BENCHMARK(BM_SubjectAverage)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ComputeGpas)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StudentGpaLoop)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,164 @@
+/**
+ * @file compact_string.h
+ * @brief 紧凑字符串 - 16 字节的只读字符串，短字符串直接存放在对象内部
+ *
+ * @details
+ * std::string 在 64 位平台上占 32 字节。学生的姓名和学号通常很短，
+ * 用 16 字节的紧凑表示就能放下绝大多数情况：
+ *
+ * - 不超过 15 字节的字符串直接存放在对象内部，不分配内存
+ * - 更长的字符串存放在外部：要么是自己申请的堆内存，
+ *   要么是 StudentManager 的字符串区（StringArena）中的一段，后者由字符串区统一释放
+ *
+ * 最后一个字节是标记：0-15 表示内部字符串的长度，kHeap / kArena 表示外部字符串。
+ */
+
+#pragma once
+
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint8_t, std::uint32_t
+#include <cstring>      // std::memcpy
+#include <stdexcept>    // std::length_error
+#include <string_view>  // std::string_view
+#include <utility>      // std::move
+
+namespace student_manager {
+
+  /**
+   * @brief 16 字节的只读字符串
+   */
+  class CompactString {
+  public:
+    /// 能直接存放在对象内部的最大长度
+    static constexpr std::size_t kInlineCapacity = 15;
+
+    CompactString() noexcept = default;
+
+    CompactString(std::string_view text) { assign(text); }  // NOLINT: 允许隐式转换
+
+    /**
+     * @brief 拷贝构造：外部字符串总是复制到新申请的堆内存中
+     */
+    CompactString(const CompactString& other) { assign(other.view()); }
+
+    /**
+     * @brief 移动构造：直接接管对方的存储，对方变为空字符串
+     */
+    CompactString(CompactString&& other) noexcept {
+      std::memcpy(bytes_, other.bytes_, sizeof(bytes_));
+      other.bytes_[kTagByte] = 0;
+    }
+
+    CompactString& operator=(const CompactString& other) {
+      if (this != &other) {
+        CompactString copy(other);
+        *this = std::move(copy);
+      }
+      return *this;
+    }
+
+    CompactString& operator=(CompactString&& other) noexcept {
+      if (this != &other) {
+        release();
+        std::memcpy(bytes_, other.bytes_, sizeof(bytes_));
+        other.bytes_[kTagByte] = 0;
+      }
+      return *this;
+    }
+
+    ~CompactString() { release(); }
+
+    /**
+     * @brief 字符串内容
+     */
+    [[nodiscard]] std::string_view view() const noexcept {
+      if (is_inline()) {
+        return {reinterpret_cast<const char*>(bytes_), bytes_[kTagByte]};
+      }
+      return {external_data(), external_size()};
+    }
+
+    operator std::string_view() const noexcept { return view(); }  // NOLINT: 允许隐式转换
+
+    [[nodiscard]] std::size_t size() const noexcept {
+      return is_inline() ? bytes_[kTagByte] : external_size();
+    }
+
+    /**
+     * @brief 字符串是否直接存放在对象内部
+     */
+    [[nodiscard]] bool is_inline() const noexcept { return bytes_[kTagByte] <= kInlineCapacity; }
+
+    /**
+     * @brief 字符串是否存放在字符串区中（不由自己释放）
+     */
+    [[nodiscard]] bool in_arena() const noexcept { return bytes_[kTagByte] == kArena; }
+
+    /**
+     * @brief 字符串是否存放在自己申请的堆内存中
+     */
+    [[nodiscard]] bool on_heap() const noexcept { return bytes_[kTagByte] == kHeap; }
+
+    /**
+     * @brief 把外部字符串搬到 storage 中，之后不再由自己释放
+     * @param storage 至少 size() 字节、寿命不短于本对象的存储（通常来自 StringArena）
+     * @note 只应对外部字符串调用
+     */
+    void move_to_arena(char* storage) noexcept {
+      std::uint32_t size = external_size();
+      std::memcpy(storage, external_data(), size);
+      release();
+      set_external(storage, size, kArena);
+    }
+
+  private:
+    static constexpr std::size_t kTagByte = 15;
+    static constexpr std::uint8_t kHeap = 0x40;
+    static constexpr std::uint8_t kArena = 0x80;
+
+    /// 内部字符串：[0, 15) 为内容；外部字符串：[0, 8) 为指针，[8, 12) 为长度
+    alignas(8) std::uint8_t bytes_[16] = {};
+
+    [[nodiscard]] const char* external_data() const noexcept {
+      const char* data;
+      std::memcpy(&data, bytes_, sizeof(data));
+      return data;
+    }
+
+    [[nodiscard]] std::uint32_t external_size() const noexcept {
+      std::uint32_t size;
+      std::memcpy(&size, bytes_ + 8, sizeof(size));
+      return size;
+    }
+
+    void set_external(const char* data, std::uint32_t size, std::uint8_t tag) noexcept {
+      std::memcpy(bytes_, &data, sizeof(data));
+      std::memcpy(bytes_ + 8, &size, sizeof(size));
+      bytes_[kTagByte] = tag;
+    }
+
+    void assign(std::string_view text) {
+      if (text.size() <= kInlineCapacity) {
+        if (!text.empty()) {
+          std::memcpy(bytes_, text.data(), text.size());
+        }
+        bytes_[kTagByte] = static_cast<std::uint8_t>(text.size());
+        return;
+      }
+      if (text.size() > 0xFFFFFFFFu) {
+        throw std::length_error("CompactString: 字符串过长");
+      }
+      char* data = new char[text.size()];
+      std::memcpy(data, text.data(), text.size());
+      set_external(data, static_cast<std::uint32_t>(text.size()), kHeap);
+    }
+
+    void release() noexcept {
+      if (on_heap()) {
+        delete[] external_data();
+      }
+      bytes_[kTagByte] = 0;
+    }
+  };
+
+}  // namespace student_manager
@@ -0,0 +1,210 @@
+/**
+ * @file concurrent_student_manager.h
+ * @brief 线程安全的学生管理类 - 按学号分片，每个分片一把读写锁
+ *
+ * @details
+ * StudentManager 本身没有任何同步。用一把全局互斥锁保护它时，所有线程都在同一把锁上排队，
+ * 核心数一多吞吐量反而下降。ConcurrentStudentManager 按学号哈希把学生分到 N 个分片中，
+ * 每个分片是一个独立的 StudentManager，配一把 std::shared_mutex：
+ *
+ * - 单个学生的操作（添加、查找、删除、改分）只锁学号所在的分片，
+ *   不同分片上的操作互不影响，读操作之间也不互斥
+ * - 统计操作按分片编号依次加共享锁，锁住全部分片后合并各分片的部分结果，
+ *   得到的是某一时刻的一致结果
+ *
+ * 分片编号取学号哈希的高位，分片内的学号索引使用低位，两者互不干扰。
+ */
+
+#pragma once
+
+#include <cstddef>       // std::size_t
+#include <cstdint>       // std::uint64_t
+#include <mutex>         // std::unique_lock
+#include <optional>      // std::optional
+#include <shared_mutex>  // std::shared_mutex, std::shared_lock
+#include <string_view>   // std::string_view
+#include <vector>        // std::vector
+
+#include "student_manager/id_key.h"
+#include "student_manager/student_manager.h"
+
+namespace student_manager {
+
+  /**
+   * @brief 线程安全的学生管理类
+   *
+   * 所有方法都可以被多个线程同时调用。查找返回学生的副本而不是引用：
+   * 引用在锁释放后可能被其他线程修改或删除。需要在锁内读取多个字段时使用 visit_student()。
+   *
+   * @example
+   * @code
+   * ConcurrentStudentManager manager;
+   * // 多个线程中：
+   * manager.add_student(Student("张三", "2023001", 85.5));
+   * manager.update_score("2023001", 90.0);
+   * if (auto student = manager.find_student("2023001")) {
+   *   std::cout << student->get_name() << "\n";
+   * }
+   * @endcode
+   */
+  class ConcurrentStudentManager {
+  public:
+    using size_type = StudentManager::size_type;
+
+    /**
+     * @brief 创建管理器
+     * @param shard_count 分片数，向上取整到 2 的幂；为 0 时使用处理器核心数的 4 倍（至少 16）
+     */
+    explicit ConcurrentStudentManager(std::size_t shard_count = 0);
+
+    ConcurrentStudentManager(const ConcurrentStudentManager&) = delete;
+    ConcurrentStudentManager& operator=(const ConcurrentStudentManager&) = delete;
+
+    /**
+     * @brief 分片数
+     */
+    [[nodiscard]] std::size_t shard_count() const noexcept { return shards_.size(); }
+
+    // ==================== 单个学生的操作 ====================
+    // 只锁学号所在的分片
+
+    /**
+     * @brief 添加学生
+     * @return 添加成功返回 true，学号已存在返回 false
+     */
+    bool add_student(const Student& student);
+    bool add_student(Student&& student);
+
+    /**
+     * @brief 根据学号删除学生
+     * @return 删除成功返回 true，学号不存在返回 false
+     */
+    bool remove_student(std::string_view student_id);
+
+    /**
+     * @brief 根据学号查找学生
+     * @return 学生的副本，未找到返回 std::nullopt
+     */
+    [[nodiscard]] std::optional<Student> find_student(std::string_view student_id) const;
+
+    /**
+     * @brief 学号是否存在
+     */
+    [[nodiscard]] bool contains(std::string_view student_id) const;
+
+    /**
+     * @brief 在分片的共享锁内读取学生
+     * @param visit 以 const Student& 为参数的回调，不能再调用本管理器的方法
+     * @return 找到学生返回 true
+     */
+    template <typename Visitor>
+    bool visit_student(std::string_view student_id, Visitor&& visit) const {
+      const Shard& shard = shard_of(student_id);
+      std::shared_lock<std::shared_mutex> lock(shard.mutex);
+      auto student = shard.students.find_student(student_id);
+      if (!student) {
+        return false;
+      }
+      visit(student->get());
+      return true;
+    }
+
+    /**
+     * @brief 修改学生成绩
+     * @return 修改成功返回 true，学号不存在返回 false
+     */
+    bool update_score(std::string_view student_id, double new_score);
+
+    /**
+     * @brief 在分片的独占锁内根据旧成绩计算新成绩（读-改-写是原子的）
+     * @param adjust 以旧成绩为参数、返回新成绩的回调
+     * @return 修改成功返回 true，学号不存在返回 false
+     *
+     * @example
+     * @code
+     * manager.adjust_score("2023001", [](double score) { return std::min(score + 5.0, 100.0); });
+     * @endcode
+     */
+    template <typename Adjust> bool adjust_score(std::string_view student_id, Adjust&& adjust) {
+      Shard& shard = shard_of(student_id);
+      std::unique_lock<std::shared_mutex> lock(shard.mutex);
+      auto student = shard.students.find_student(student_id);
+      if (!student) {
+        return false;
+      }
+      student->get().set_score(adjust(student->get().get_score()));
+      return true;
+    }
+
+    // ==================== 整体操作 ====================
+    // 依次锁住全部分片，结果对应同一时刻的数据
+
+    [[nodiscard]] bool empty() const;
+
+    [[nodiscard]] int get_student_count() const;
+
+    /**
+     * @brief 平均成绩：合并各分片的总分和人数
+     * @return 平均成绩，没有学生时返回 0.0
+     */
+    [[nodiscard]] double calculate_average_score() const;
+
+    [[nodiscard]] std::optional<double> get_max_score() const;
+    [[nodiscard]] std::optional<double> get_min_score() const;
+
+    /**
+     * @brief 复制所有学生（按分片排列，顺序不固定）
+     */
+    [[nodiscard]] std::vector<Student> get_all_students() const;
+
+    /**
+     * @brief 合并各分片的性能统计（见 StudentManager::metrics()）
+     */
+    [[nodiscard]] MetricsReport metrics() const;
+
+    /**
+     * @brief 为大约 count 名学生预留空间（平均分到每个分片）
+     */
+    void reserve(size_type count);
+
+    /**
+     * @brief 清空所有学生（保留性能统计）
+     */
+    void clear();
+
+  private:
+    /// 每个分片单独占满缓存行，避免不同分片的锁互相干扰（伪共享）
+    struct alignas(64) Shard {
+      mutable std::shared_mutex mutex;
+      StudentManager students;
+    };
+
+    std::vector<Shard> shards_;
+    unsigned shard_shift_;  ///< 哈希右移多少位得到分片编号
+
+    [[nodiscard]] std::size_t shard_index(std::string_view student_id) const noexcept {
+      return static_cast<std::size_t>(std::uint64_t{IdKey(student_id).hash()} >> shard_shift_);
+    }
+
+    [[nodiscard]] Shard& shard_of(std::string_view student_id) noexcept {
+      return shards_[shard_index(student_id)];
+    }
+
+    [[nodiscard]] const Shard& shard_of(std::string_view student_id) const noexcept {
+      return shards_[shard_index(student_id)];
+    }
+
+    /// 按分片编号依次加共享锁，锁住全部分片后调用 visit(const StudentManager&)
+    template <typename Visitor> void visit_all(Visitor&& visit) const {
+      std::vector<std::shared_lock<std::shared_mutex>> locks;
+      locks.reserve(shards_.size());
+      for (const Shard& shard : shards_) {
+        locks.emplace_back(shard.mutex);
+      }
+      for (const Shard& shard : shards_) {
+        visit(shard.students);
+      }
+    }
+  };
+
+}  // namespace student_manager
@@ -0,0 +1,100 @@
+/**
+ * @file csv.h
+ * @brief CSV 导入导出 - 分块读取、多线程解析
+ *
+ * @details
+ * 文件格式：每行一个学生，三个字段依次为姓名、学号、成绩，例如
+ *
+ * @code
+ * 姓名,学号,成绩
+ * 张三,2023001,85.5
+ * "Smith, John",2023002,92
+ * @endcode
+ *
+ * - 字段可以用双引号括起来，引号内的 "" 表示一个双引号；引号内可以换行，
+ *   这样的记录占多行，出错时报告它开始的行号
+ * - 行尾的 \r 和字段两端的空格会被去掉，空行会被跳过，文件开头的 UTF-8 BOM 会被忽略
+ *
+ * 导入时按大块读取文件（默认 4 MB，在不处于引号内的换行处切开），多个块交给多个线程同时解析，
+ * 字段直接在块上以 std::string_view 切分，成绩用 std::from_chars 解析，不为字段构造临时字符串；
+ * 解析好的学生再按文件中的顺序依次加入管理器，因此学号重复时总是保留先出现的那一行。
+ */
+
+#pragma once
+
+#include <cstddef>  // std::size_t
+#include <iosfwd>   // std::istream, std::ostream
+#include <string>   // std::string
+#include <vector>   // std::vector
+
+namespace student_manager {
+
+  class StudentManager;
+
+  /**
+   * @brief CSV 读写选项
+   */
+  struct CsvOptions {
+    char delimiter = ',';              ///< 字段分隔符
+    bool has_header = true;            ///< 第一行是否为表头（导入时跳过，导出时写出）
+    std::size_t chunk_size = 4 << 20;  ///< 导入时每次读取的字节数
+    unsigned threads = 0;              ///< 解析线程数，0 表示使用全部处理器核心
+    std::size_t max_errors = 1000;     ///< 最多记录多少条错误（超出的只计数）
+  };
+
+  /**
+   * @brief 导入时某一行的错误
+   */
+  struct CsvError {
+    std::size_t line = 0;  ///< 行号（从 1 开始，包括表头）
+    std::string message;   ///< 错误说明
+  };
+
+  /**
+   * @brief 导入结果
+   */
+  struct CsvImportResult {
+    bool opened = true;            ///< 文件是否成功打开
+    std::size_t rows = 0;          ///< 读到的数据行数（不包括表头和空行）
+    std::size_t added = 0;         ///< 成功添加的学生数
+    std::size_t error_count = 0;   ///< 出错的行数（格式错误、成绩无效、学号重复）
+    std::vector<CsvError> errors;  ///< 前 CsvOptions::max_errors 条错误，按行号排列
+  };
+
+  /**
+   * @brief 从 CSV 文件导入学生
+   * @return 导入结果；有错误的行会被跳过，其余行照常导入
+   *
+   * @example
+   * @code
+   * auto result = import_csv(manager, "roster.csv");
+   * for (const auto& error : result.errors) {
+   *   std::cerr << "第 " << error.line << " 行: " << error.message << "\n";
+   * }
+   * @endcode
+   */
+  [[nodiscard]] CsvImportResult import_csv(StudentManager& manager, const std::string& path,
+                                           const CsvOptions& options = {});
+
+  /**
+   * @brief 从输入流导入学生
+   */
+  [[nodiscard]] CsvImportResult import_csv(StudentManager& manager, std::istream& in,
+                                           const CsvOptions& options = {});
+
+  /**
+   * @brief 把所有学生导出为 CSV 文件
+   * @return 写入成功返回 true
+   *
+   * @note 输出先在内存中攒成大块再写出；包含分隔符、引号或换行的字段会加上引号
+   */
+  [[nodiscard]] bool export_csv(const StudentManager& manager, const std::string& path,
+                                const CsvOptions& options = {});
+
+  /**
+   * @brief 把所有学生写到输出流
+   */
+  [[nodiscard]] bool export_csv(const StudentManager& manager, std::ostream& out,
+                                const CsvOptions& options = {});
+
+}  // namespace student_manager
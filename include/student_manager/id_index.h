@@ -0,0 +1,250 @@
+/**
+ * @file id_index.h
+ * @brief 学号哈希索引 - 开放寻址哈希表
+ *
+ * @details
+ * StudentManager 内部使用的学号索引，把"学号 -> 行号"的查找从 O(n) 降到平均 O(1)。
+ *
+ * 设计说明：
+ * - 开放寻址 + 线性探测：所有槽位存放在一个连续的 std::vector 中，对缓存友好
+ * - 槽位只保存"32 位哈希 + 行号"，不保存学号本身，比较学号时通过 matches 回调读取学生数据
+ * - 查找使用 IdKey（学号视图 + 压缩键），纯数字学号只做整数比较，探测过程不会分配内存
+ * - 删除采用"向后移位"（backward shift deletion），不需要墓碑标记
+ */
+
+#pragma once
+
+#include <cstddef>      // std::size_t
+#include <cstdint>  // std::uint32_t
+#include <vector>   // std::vector
+
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+#  include <xmmintrin.h>  // _mm_prefetch
+#endif
+
+#include "student_manager/id_key.h"
+
+namespace student_manager {
+
+  namespace detail {
+    /// 提示处理器把 address 所在的缓存行提前读入缓存（不支持的平台上什么也不做）
+    inline void prefetch(const void* address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+      __builtin_prefetch(address);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+      _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+      (void)address;
+#endif
+    }
+  }  // namespace detail
+
+  /**
+   * @brief 学号到行号的开放寻址哈希索引
+   *
+   * 索引本身不知道学生数据存放在哪里，所有需要比较学号的操作都接受一个 matches 回调，
+   * 形如 `bool matches(const IdKey& key, std::uint32_t row)`，判断某一行的学号是否就是 key。
+   *
+   * @note 行号使用 32 位无符号整数，单个索引最多容纳约 42 亿行
+   */
+  class IdIndex {
+  public:
+    /// 表示"未找到"的行号
+    static constexpr std::uint32_t npos = 0xFFFFFFFFu;
+
+    /**
+     * @brief 获取已索引的条目数
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+    /**
+     * @brief 预留至少能容纳 count 个条目而不需要扩容的空间
+     */
+    void reserve(std::size_t count) {
+      std::size_t wanted = min_capacity_for(count);
+      if (wanted > slots_.size()) {
+        rehash(wanted);
+      }
+    }
+
+    /**
+     * @brief 清空索引（保留已分配的槽位）
+     */
+    void clear() noexcept {
+      for (auto& slot : slots_) {
+        slot = Slot{};
+      }
+      size_ = 0;
+    }
+
+    /**
+     * @brief 查找学号对应的行号
+     * @param key 学号
+     * @param matches 判断某一行是否为该学号的回调
+     * @return 找到返回行号，否则返回 npos
+     */
+    template <typename Matches>
+    [[nodiscard]] std::uint32_t find(const IdKey& key, Matches&& matches) const {
+      std::size_t pos = locate(key, matches);
+      return pos == kNoSlot ? npos : slots_[pos].row;
+    }
+
+    /**
+     * @brief 预取 key 的探测起点所在的缓存行
+     *
+     * 批量查找时提前几个学号调用，等真正查找时槽位已经在缓存中，多个学号的内存访问可以重叠进行
+     */
+    void prefetch(const IdKey& key) const noexcept {
+      if (!slots_.empty()) {
+        detail::prefetch(&slots_[key.hash() & mask()]);
+      }
+    }
+
+    /**
+     * @brief 探测链上第一个哈希值与 key 相同的条目的行号，没有时返回 npos
+     * @note 不比较学号（可能只是哈希冲突），只用于提前预取这一行的数据
+     */
+    [[nodiscard]] std::uint32_t candidate(const IdKey& key) const noexcept {
+      if (size_ == 0) {
+        return npos;
+      }
+      std::uint32_t h = key.hash();
+      for (std::size_t pos = h & mask();; pos = (pos + 1) & mask()) {
+        const Slot& slot = slots_[pos];
+        if (slot.row == npos || slot.hash == h) {
+          return slot.row;
+        }
+      }
+    }
+
+    /**
+     * @brief 插入一个新条目
+     * @param key 学号（调用者需保证此学号尚未被索引）
+     * @param row 学号所在的行号
+     */
+    void insert(const IdKey& key, std::uint32_t row) {
+      if ((size_ + 1) * 4 > slots_.size() * 3) {
+        rehash(slots_.empty() ? kMinCapacity : slots_.size() * 2);
+      }
+      place(Slot{key.hash(), row});
+      ++size_;
+    }
+
+    /**
+     * @brief 删除学号对应的条目
+     * @return 被删除条目的行号，未找到返回 npos
+     */
+    template <typename Matches> std::uint32_t erase(const IdKey& key, Matches&& matches) {
+      std::size_t pos = locate(key, matches);
+      if (pos == kNoSlot) {
+        return npos;
+      }
+      std::uint32_t row = slots_[pos].row;
+      erase_at(pos);
+      return row;
+    }
+
+    /**
+     * @brief 修改某个学号记录的行号（元素在存储中被移动后调用）
+     */
+    template <typename Matches>
+    void update_row(const IdKey& key, std::uint32_t new_row, Matches&& matches) {
+      std::size_t pos = locate(key, matches);
+      if (pos != kNoSlot) {
+        slots_[pos].row = new_row;
+      }
+    }
+
+    /**
+     * @brief 索引占用的字节数
+     */
+    [[nodiscard]] std::size_t memory_bytes() const noexcept {
+      return slots_.capacity() * sizeof(Slot);
+    }
+
+  private:
+    /// 一个槽位：保存哈希值，用于定位并在比较学号前快速排除不匹配的条目
+    struct Slot {
+      std::uint32_t hash = 0;
+      std::uint32_t row = npos;  ///< npos 表示空槽位
+    };
+
+    static constexpr std::size_t kMinCapacity = 16;
+    static constexpr std::size_t kNoSlot = static_cast<std::size_t>(-1);
+
+    std::vector<Slot> slots_;  ///< 槽位数组，容量总是 2 的幂
+    std::size_t size_ = 0;     ///< 已使用的槽位数
+
+    [[nodiscard]] std::size_t mask() const noexcept { return slots_.size() - 1; }
+
+    /// 负载因子上限为 3/4
+    [[nodiscard]] static std::size_t min_capacity_for(std::size_t count) noexcept {
+      std::size_t capacity = kMinCapacity;
+      while (capacity * 3 < count * 4) {
+        capacity *= 2;
+      }
+      return capacity;
+    }
+
+    template <typename Matches>
+    [[nodiscard]] std::size_t locate(const IdKey& key, Matches& matches) const {
+      if (size_ == 0) {
+        return kNoSlot;
+      }
+      std::uint32_t h = key.hash();
+      for (std::size_t pos = h & mask();; pos = (pos + 1) & mask()) {
+        const Slot& slot = slots_[pos];
+        if (slot.row == npos) {
+          return kNoSlot;
+        }
+        if (slot.hash == h && matches(key, slot.row)) {
+          return pos;
+        }
+      }
+    }
+
+    /// 把条目放到从它的理想位置开始的第一个空槽位
+    void place(Slot slot) noexcept {
+      std::size_t pos = slot.hash & mask();
+      while (slots_[pos].row != npos) {
+        pos = (pos + 1) & mask();
+      }
+      slots_[pos] = slot;
+    }
+
+    /**
+     * @brief 向后移位删除
+     *
+     * 删除一个槽位后，把探测链上后续的条目向前挪，保证查找时遇到空槽位就可以停止。
+     */
+    void erase_at(std::size_t hole) noexcept {
+      std::size_t pos = hole;
+      for (;;) {
+        pos = (pos + 1) & mask();
+        if (slots_[pos].row == npos) {
+          break;
+        }
+        std::size_t home = slots_[pos].hash & mask();
+        // 判断 home 是否落在 (hole, pos] 之外（循环区间），是则可以把该条目挪到 hole
+        bool movable = hole <= pos ? (home <= hole || home > pos) : (home <= hole && home > pos);
+        if (movable) {
+          slots_[hole] = slots_[pos];
+          hole = pos;
+        }
+      }
+      slots_[hole] = Slot{};
+      --size_;
+    }
+
+    void rehash(std::size_t new_capacity) {
+      std::vector<Slot> old(new_capacity);
+      old.swap(slots_);
+      for (const Slot& slot : old) {
+        if (slot.row != npos) {
+          place(slot);
+        }
+      }
+    }
+  };
+
+}  // namespace student_manager
@@ -0,0 +1,125 @@
+/**
+ * @file id_key.h
+ * @brief 学号键 - 把纯数字学号压缩成 64 位整数
+ *
+ * @details
+ * 学号通常是定长的十进制数字串（如 "2023001"、"001234"）。这样的学号可以无损地压缩成
+ * 一个 64 位整数：高 5 位记录位数（保留前导零），低 59 位记录数值。
+ * 压缩之后，比较学号只需要一次整数比较，哈希也只需要几条整数指令。
+ *
+ * 不是纯数字、或者超过 17 位的学号不压缩（键为 0），仍然按字符串比较。
+ * 由于压缩结果只取决于字符串本身，两个学号相同当且仅当：
+ * - 都能压缩，且键相同；或者
+ * - 都不能压缩，且字符串相同
+ */
+
+#pragma once
+
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint32_t, std::uint64_t
+#include <functional>   // std::hash
+#include <string_view>  // std::string_view
+
+namespace student_manager {
+
+  /**
+   * @brief 用于查找的学号：原始字符串 + 压缩后的键
+   */
+  class IdKey {
+  public:
+    /// 能压缩的最大位数（10^17 < 2^59）
+    static constexpr std::size_t kMaxDigits = 17;
+
+    /// 表示"不能压缩"的键
+    static constexpr std::uint64_t kNotNumeric = 0;
+
+    explicit IdKey(std::string_view id) noexcept
+        : text_(id), packed_(pack(id)), hash_(compute_hash(text_, packed_)) {}
+
+    /**
+     * @brief 把学号压缩成 64 位整数
+     * @return 纯数字且不超过 17 位时返回压缩后的键（不为 0），否则返回 kNotNumeric
+     *
+     * @example
+     * @code
+     * IdKey::pack("001234") != IdKey::pack("1234");  // 位数不同，键也不同
+     * IdKey::pack("S2023") == IdKey::kNotNumeric;
+     * @endcode
+     */
+    [[nodiscard]] static std::uint64_t pack(std::string_view id) noexcept {
+      if (id.empty() || id.size() > kMaxDigits) {
+        return kNotNumeric;
+      }
+      std::uint64_t value = 0;
+      for (char c : id) {
+        if (c < '0' || c > '9') {
+          return kNotNumeric;
+        }
+        value = value * 10 + static_cast<std::uint64_t>(c - '0');
+      }
+      return (static_cast<std::uint64_t>(id.size()) << kWidthShift) | value;
+    }
+
+    /**
+     * @brief 压缩键记录的位数
+     */
+    [[nodiscard]] static std::size_t width(std::uint64_t packed) noexcept {
+      return static_cast<std::size_t>(packed >> kWidthShift);
+    }
+
+    /**
+     * @brief 压缩键记录的数值
+     */
+    [[nodiscard]] static std::uint64_t value(std::uint64_t packed) noexcept {
+      return packed & kValueMask;
+    }
+
+    [[nodiscard]] std::string_view text() const noexcept { return text_; }
+    [[nodiscard]] std::uint64_t packed() const noexcept { return packed_; }
+    [[nodiscard]] bool is_numeric() const noexcept { return packed_ != kNotNumeric; }
+
+    /**
+     * @brief 判断另一行的学号（压缩键为 packed，字符串由 text_of() 按需读取）是否与本学号相同
+     * @note 本学号能压缩时只比较整数，不会调用 text_of
+     */
+    template <typename TextOf>
+    [[nodiscard]] bool matches(std::uint64_t packed, TextOf&& text_of) const {
+      if (packed_ != kNotNumeric || packed != kNotNumeric) {
+        return packed_ == packed;
+      }
+      return text_of() == text_;
+    }
+
+    /**
+     * @brief 32 位哈希值（构造时计算一次，批量查找时预取和查找都要用到）
+     * @note 能压缩的学号对整数做一次混合（MurmurHash3 的 fmix64），不再逐个字符计算
+     */
+    [[nodiscard]] std::uint32_t hash() const noexcept { return hash_; }
+
+  private:
+    static constexpr unsigned kWidthShift = 59;
+    static constexpr std::uint64_t kValueMask = (std::uint64_t{1} << kWidthShift) - 1;
+
+    std::string_view text_;
+    std::uint64_t packed_;
+    std::uint32_t hash_;
+
+    [[nodiscard]] static std::uint32_t compute_hash(std::string_view text,
+                                                    std::uint64_t packed) noexcept {
+      std::uint64_t h;
+      if (packed != kNotNumeric) {
+        h = packed;
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 33;
+        h *= 0xC4CEB9FE1A85EC53ull;
+        h ^= h >> 33;
+      } else {
+        h = static_cast<std::uint64_t>(std::hash<std::string_view>{}(text));
+        h ^= h >> 32;
+      }
+      return static_cast<std::uint32_t>(h);
+    }
+  };
+
+}  // namespace student_manager
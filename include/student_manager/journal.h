@@ -0,0 +1,224 @@
+/**
+ * @file journal.h
+ * @brief 预写日志 - 记录两次快照之间的每一次修改，崩溃后可以恢复
+ *
+ * @details
+ * 日志模式下（StudentManager::open_journal），添加、删除、改分和清空都会追加一条二进制记录：
+ *
+ * | 字段     | 内容                                                   |
+ * |----------|--------------------------------------------------------|
+ * | 记录长度 | uint32，包括本字段和校验和，8 的倍数                   |
+ * | 类型     | uint8，见 JournalRecordType；之后补 3 个零字节         |
+ * | 序号     | uint64，从 1 开始连续递增                              |
+ * | 成绩     | double                                                 |
+ * | 字符串长 | uint32 姓名长度 + uint32 学号长度                      |
+ * | 字符串   | 姓名和学号，末尾补零到 8 字节对齐                      |
+ * | 校验和   | uint64，本记录中之前所有字节的校验和（见 checksum.h）  |
+ *
+ * 记录先放进内存缓冲区，由后台线程成批写入文件并调用一次 fsync（group commit）：
+ * 攒够 JournalOptions::group_commit_records 条记录，或者最早的记录已经等了
+ * JournalOptions::group_commit_delay，就同步一次。成绩批量录入时，
+ * 几百次改分只需要一次 fsync；需要立即落盘时调用 StudentManager::sync_journal()。
+ *
+ * 快照的文件头记录了它已包含的最后一条日志序号。压缩日志时，当前日志先改名为
+ * "<日志路径>.old"，新的修改写入新日志，后台线程把改名时刻的数据写成新快照，
+ * 快照落盘后再删除旧日志。恢复时先加载快照，再依次回放旧日志和新日志中序号更大的记录，
+ * 因此在压缩的任何阶段崩溃都不会丢失或重复记录。
+ *
+ * 断电时最后一批记录可能只写了一半，回放遇到长度或校验和不对的记录就停止，
+ * 之后的内容会被截掉。
+ */
+
+#pragma once
+
+#include <chrono>              // std::chrono::milliseconds
+#include <condition_variable>  // std::condition_variable
+#include <cstddef>             // std::size_t
+#include <cstdint>             // std::intptr_t, std::uint8_t, std::uint64_t
+#include <functional>          // std::function
+#include <future>              // std::future
+#include <mutex>               // std::mutex
+#include <string>              // std::string
+#include <string_view>         // std::string_view
+#include <thread>              // std::thread
+#include <vector>              // std::vector
+
+#include "student_manager/snapshot.h"
+
+namespace student_manager {
+
+  class Student;
+
+  /**
+   * @brief 日志模式的选项
+   */
+  struct JournalOptions {
+    /// 攒够多少条记录就立即同步一次
+    std::size_t group_commit_records = 512;
+    /// 每条记录最多等待多久就会被同步（延迟预算）；崩溃时最多丢失这段时间内的修改
+    std::chrono::milliseconds group_commit_delay{10};
+    /// 日志超过多少字节时自动在后台压缩成新快照，0 表示只在调用 compact_journal() 时压缩
+    std::uint64_t compact_threshold_bytes = std::uint64_t{64} << 20;
+  };
+
+  /**
+   * @brief 日志记录的类型
+   */
+  enum class JournalRecordType : std::uint8_t {
+    add = 1,     ///< 添加学生（姓名、学号、成绩）
+    remove = 2,  ///< 删除学生（学号）
+    score = 3,   ///< 修改成绩（学号、新成绩）
+    clear = 4,   ///< 清空所有学生
+  };
+
+  /**
+   * @brief 回放时读出的一条记录
+   * @note name 和 id 指向回放缓冲区，只在回调期间有效
+   */
+  struct JournalRecord {
+    JournalRecordType type = JournalRecordType::add;
+    std::uint64_t sequence = 0;
+    std::string_view name;
+    std::string_view id;
+    double score = 0.0;
+  };
+
+  /**
+   * @brief 回放结果
+   */
+  struct JournalReplay {
+    SnapshotStatus status = SnapshotStatus::ok;  ///< 文件不存在时为 open_failed
+    std::uint64_t last_sequence = 0;  ///< 文件中最后一条完整记录的序号（没有记录时为 0）
+    std::uint64_t valid_bytes = 0;    ///< 完整记录结束的位置，之后是写了一半的残缺记录
+    std::size_t applied = 0;          ///< 交给回调的记录数
+  };
+
+  /**
+   * @brief 依次读出日志中序号大于 after_sequence 的记录并交给 apply
+   */
+  [[nodiscard]] JournalReplay replay_journal(
+      const std::string& path, std::uint64_t after_sequence,
+      const std::function<void(const JournalRecord&)>& apply);
+
+  /**
+   * @brief 预写日志：追加记录、成批同步、压缩成快照
+   *
+   * 由 StudentManager 在日志模式下持有，一般不需要直接使用。
+   * 追加记录只写入内存缓冲区，文件写入和 fsync 都在后台线程中完成。
+   *
+   * @warning 追加记录的方法不能被多个线程同时调用（与 StudentManager 本身一致）
+   */
+  class Journal {
+  public:
+    Journal(std::string snapshot_path, std::string journal_path, const JournalOptions& options);
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    /**
+     * @brief 等待后台压缩完成，把剩余记录同步到磁盘，然后关闭文件
+     */
+    ~Journal();
+
+    /**
+     * @brief 打开日志文件准备追加
+     * @param last_sequence 已有的最后一条记录的序号，新记录从下一个序号开始
+     * @param valid_bytes 已有文件中完整记录的长度（见 JournalReplay），之后的内容会被截掉；
+     *        为 0 时重新创建文件
+     */
+    [[nodiscard]] SnapshotStatus open(std::uint64_t last_sequence, std::uint64_t valid_bytes);
+
+    void log_add(std::string_view name, std::string_view id, double score);
+    void log_remove(std::string_view id);
+    void log_score(std::string_view id, double score);
+    void log_clear();
+
+    /**
+     * @brief 立即同步所有已追加的记录，返回时它们都已落盘
+     * @return 成功返回 ok；之前某次后台写入失败时返回 io_error
+     */
+    [[nodiscard]] SnapshotStatus sync();
+
+    /**
+     * @brief 最后追加的记录序号
+     */
+    [[nodiscard]] std::uint64_t last_sequence() const;
+
+    /**
+     * @brief 已经落盘的最后一条记录的序号
+     */
+    [[nodiscard]] std::uint64_t durable_sequence() const;
+
+    /**
+     * @brief 日志已超过压缩阈值，且没有正在进行的压缩
+     */
+    [[nodiscard]] bool wants_compaction() const;
+
+    /**
+     * @brief 同步压缩：把 students 写成快照，然后清空日志
+     * @param students 包含了所有已追加记录的当前数据
+     */
+    [[nodiscard]] SnapshotStatus checkpoint(const std::vector<Student>& students);
+
+    /**
+     * @brief 后台压缩：换用新的日志文件，在后台线程中把 students 写成快照
+     * @param students 包含了所有已追加记录的当前数据（副本，由后台线程持有）
+     * @note 上一次压缩还没结束时先等待它完成
+     */
+    [[nodiscard]] SnapshotStatus start_compaction(std::vector<Student> students);
+
+    /**
+     * @brief 等待后台压缩完成
+     * @return 最近一次压缩的结果，没有进行过压缩时返回 ok
+     */
+    [[nodiscard]] SnapshotStatus wait_for_compaction();
+
+    [[nodiscard]] const std::string& snapshot_path() const noexcept { return snapshot_path_; }
+    [[nodiscard]] const std::string& journal_path() const noexcept { return journal_path_; }
+
+    /// 压缩期间旧日志的路径
+    [[nodiscard]] std::string old_journal_path() const { return old_journal_path(journal_path_); }
+
+    [[nodiscard]] static std::string old_journal_path(const std::string& journal_path) {
+      return journal_path + ".old";
+    }
+
+  private:
+    std::string snapshot_path_;
+    std::string journal_path_;
+    JournalOptions options_;
+
+    std::intptr_t file_ = -1;  ///< 文件描述符（Windows 上是文件句柄），未打开时为 -1
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_flusher_;  ///< 有新记录、要求同步或要关闭时通知后台线程
+    std::condition_variable synced_;        ///< 每次同步完成后通知等待者
+    std::string buffer_;                    ///< 还没写入文件的记录
+    std::string spare_buffer_;              ///< 与 buffer_ 轮换使用，避免反复分配
+    std::size_t pending_records_ = 0;
+    std::chrono::steady_clock::time_point first_pending_;  ///< 缓冲区中最早一条记录的时间
+    std::uint64_t last_sequence_ = 0;
+    std::uint64_t durable_sequence_ = 0;
+    std::uint64_t file_bytes_ = 0;  ///< 日志文件当前的长度（包括缓冲区中的记录）
+    bool sync_requested_ = false;
+    bool stopping_ = false;
+    bool failed_ = false;  ///< 后台写入失败过
+    std::thread flusher_;
+
+    std::future<SnapshotStatus> compaction_;
+    SnapshotStatus last_compaction_ = SnapshotStatus::ok;
+
+    void append(JournalRecordType type, std::string_view name, std::string_view id, double score);
+    void flusher_loop();
+
+    /// 以下文件操作都要求后台线程空闲（缓冲区已经同步完）
+    [[nodiscard]] bool open_file(bool truncate);
+    void close_file() noexcept;
+    [[nodiscard]] bool write_file(const char* data, std::size_t size);
+    [[nodiscard]] bool sync_file();
+    [[nodiscard]] bool truncate_file(std::uint64_t size);
+    [[nodiscard]] bool write_file_header();
+
+    void stop_flusher();
+  };
+
+}  // namespace student_manager
@@ -0,0 +1,303 @@
+/**
+ * @file metrics.h
+ * @brief 性能统计 - 每个操作的调用次数、耗时分布，以及查找命中率和重复学号计数
+ *
+ * @details
+ * 性能统计默认关闭，关闭时没有任何开销：StudentManager 中不记录任何数据，
+ * 统计宏展开为空语句。编译时定义 STUDENT_MANAGER_METRICS=1（CMake 选项
+ * STUDENT_MANAGER_ENABLE_METRICS）开启后，每次调用被统计的方法要读两次时钟、
+ * 做几次原子加法，大约增加几十纳秒。
+ *
+ * 设计说明：
+ * - 耗时直方图与 HdrHistogram 的分桶方式相同：小于 16 纳秒的值每纳秒一个桶，
+ *   之后每个 2 的幂区间平分为 16 个桶，相对误差不超过 1/16（约 6%），
+ *   用固定的 592 个桶覆盖 1 纳秒到约 18 分钟，记录一次只是一次数组下标加一
+ * - 计数器都是 std::atomic，使用 memory_order_relaxed：多个线程同时读取同一个
+ *   StudentManager（例如 ConcurrentStudentManager 的共享锁）时也能正确计数
+ * - 统计所有不是 O(1) 的查询和修改（见 Operation）。以下公开方法不统计：
+ *   - O(1) 的读取：empty()、get_student_count()、calculate_average_score()、get_total_score()、
+ *     get_max_score()、get_min_score()、subject_count()、contains()、get_student(handle)
+ *     和各个 has_*()，只需几纳秒，计时本身的开销比它还大
+ *   - 按学号访问单个学生的辅助方法：get_handle()、find_subject()、get_subject_score()、
+ *     set_subject_score()、clear_subject_score()、student_average()、student_gpa()，
+ *     与 find_student() 走同一个学号索引，耗时分布相同，不重复统计
+ *   - 配置和维护操作：reserve()、enable_*() / disable_*()、add_subject()、remove_subject()、
+ *     clear_sorted_views()、enable_read_snapshots()、publish_read_snapshot()、reset_metrics()，
+ *     以及日志的 close_journal()、sync_journal()、checkpoint()、compact_journal()
+ *     （耗时取决于磁盘，不反映管理器本身的性能）
+ */
+
+#pragma once
+
+#include <array>        // std::array
+#include <atomic>       // std::atomic
+#include <chrono>       // std::chrono::steady_clock
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint64_t, std::uint8_t
+#include <string>       // std::string
+#include <string_view>  // std::string_view
+#include <vector>       // std::vector
+
+#ifndef STUDENT_MANAGER_METRICS
+#  define STUDENT_MANAGER_METRICS 0
+#endif
+
+namespace student_manager {
+
+  /**
+   * @brief 被统计的操作
+   */
+  enum class Operation : std::uint8_t {
+    add_student,             ///< add_student()
+    add_students,            ///< add_students()
+    insert_student,          ///< insert_student()
+    remove_student,          ///< remove_student()
+    find_student,            ///< find_student()
+    find_students,           ///< find_students()
+    update_score,            ///< update_score()
+    update_scores,           ///< update_scores()
+    rank_of,                 ///< rank_of()
+    kth_score,               ///< kth_score()
+    top_k,                   ///< top_k()
+    bottom_k,                ///< bottom_k()
+    count_in_range,          ///< count_in_range()
+    grade_distribution,      ///< grade_distribution()
+    approximate_percentile,  ///< approximate_percentile()
+    find_by_name,            ///< find_students_by_name() 及前缀、包含查找
+    scan,                    ///< count_students_if() / find_students_if()
+    sorted_by,               ///< sorted_by()
+    compute_statistics,      ///< compute_statistics()
+    subject_average,         ///< subject_average()
+    subject_statistics,      ///< compute_subject_statistics()
+    compute_gpas,            ///< compute_gpas()
+    memory_usage,            ///< memory_usage()
+    clear,                   ///< clear()
+    save_snapshot,           ///< save_snapshot()
+    load_snapshot,           ///< load_snapshot()
+    open_journal,            ///< open_journal()
+  };
+
+  /// 被统计的操作个数
+  inline constexpr std::size_t kOperationCount
+      = static_cast<std::size_t>(Operation::open_journal) + 1;
+
+  /**
+   * @brief 操作的名称（与方法名相同）
+   */
+  [[nodiscard]] std::string_view to_string(Operation operation) noexcept;
+
+  /**
+   * @brief 耗时直方图（纳秒），分桶方式见文件开头的说明
+   */
+  class LatencyHistogram {
+  public:
+    static constexpr std::size_t kSubBuckets = 16;  ///< 每个 2 的幂区间的桶数
+    static constexpr unsigned kMaxExponent = 40;    ///< 不小于 2^40 纳秒的值都记入最后一个桶
+    static constexpr std::size_t kBuckets = kSubBuckets + (kMaxExponent - 4) * kSubBuckets;
+
+    /**
+     * @brief 记录一次耗时
+     */
+    void record(std::uint64_t nanoseconds) noexcept;
+
+    /**
+     * @brief 把另一个直方图的记录合并进来
+     */
+    void merge(const LatencyHistogram& other) noexcept;
+
+    /**
+     * @brief 记录的次数
+     */
+    [[nodiscard]] std::uint64_t count() const noexcept { return count_; }
+
+    /**
+     * @brief 平均耗时，没有记录时为 0
+     */
+    [[nodiscard]] double mean() const noexcept {
+      return count_ == 0 ? 0.0 : static_cast<double>(total_) / static_cast<double>(count_);
+    }
+
+    /**
+     * @brief 最大耗时（精确值）
+     */
+    [[nodiscard]] std::uint64_t max() const noexcept { return max_; }
+
+    /**
+     * @brief 第 percentile 百分位数（0 到 100）
+     * @return 该记录所在桶的上界（不超过最大耗时），没有记录时为 0
+     * @note 时间复杂度: O(桶数)
+     */
+    [[nodiscard]] std::uint64_t percentile(double percentile) const noexcept;
+
+    /**
+     * @brief 耗时所在的桶
+     */
+    [[nodiscard]] static std::size_t bucket_of(std::uint64_t nanoseconds) noexcept;
+
+    /**
+     * @brief 桶中最大的耗时
+     */
+    [[nodiscard]] static std::uint64_t bucket_upper(std::size_t bucket) noexcept;
+
+  private:
+    friend class MetricsRecorder;
+
+    std::array<std::uint64_t, kBuckets> buckets_{};
+    std::uint64_t count_ = 0;
+    std::uint64_t total_ = 0;
+    std::uint64_t max_ = 0;
+  };
+
+  /**
+   * @brief 某一时刻的性能统计报告
+   *
+   * @example
+   * @code
+   * MetricsReport report = manager.metrics();
+   * std::cout << report.calls(Operation::find_student) << " 次查找，命中率 "
+   *           << report.find_hit_ratio() * 100 << "%\n";
+   * std::cout << report.to_text();
+   * @endcode
+   */
+  struct MetricsReport {
+    bool enabled = false;                   ///< 编译时是否开启了性能统计，未开启时其余字段都是 0
+    std::vector<LatencyHistogram> latency;  ///< 每个操作的耗时分布，下标为 Operation 的值
+    std::uint64_t find_hits = 0;            ///< find_student() 找到学生的次数
+    std::uint64_t find_misses = 0;          ///< find_student() 未找到的次数
+    std::uint64_t duplicates_rejected = 0;  ///< 添加时因学号重复被拒绝的学生数
+
+    MetricsReport() : latency(kOperationCount) {}
+
+    /**
+     * @brief 某个操作的耗时分布
+     */
+    [[nodiscard]] const LatencyHistogram& of(Operation operation) const noexcept {
+      return latency[static_cast<std::size_t>(operation)];
+    }
+
+    /**
+     * @brief 某个操作的调用次数
+     */
+    [[nodiscard]] std::uint64_t calls(Operation operation) const noexcept {
+      return of(operation).count();
+    }
+
+    /**
+     * @brief find_student() 的命中率（0 到 1），没有调用过时为 0
+     */
+    [[nodiscard]] double find_hit_ratio() const noexcept {
+      std::uint64_t total = find_hits + find_misses;
+      return total == 0 ? 0.0 : static_cast<double>(find_hits) / static_cast<double>(total);
+    }
+
+    /**
+     * @brief 把另一份报告合并进来（如合并多个分片的统计）
+     */
+    void merge(const MetricsReport& other);
+
+    /**
+     * @brief 文本格式的报告：每个调用过的操作一行（次数、平均值、p50/p90/p99、最大值，单位微秒），
+     *        然后是查找命中率和重复学号计数
+     */
+    [[nodiscard]] std::string to_text() const;
+  };
+
+  /**
+   * @brief 性能统计的记录者，StudentManager 在开启性能统计时持有一个
+   *
+   * 所有记录方法都可以被多个线程同时调用。
+   */
+  class MetricsRecorder {
+  public:
+    /// 额外的事件计数
+    enum class Event : std::uint8_t { find_hit, find_miss, duplicate_rejected };
+
+    MetricsRecorder() = default;
+    MetricsRecorder(const MetricsRecorder& other) noexcept;
+    MetricsRecorder& operator=(const MetricsRecorder&) = delete;
+
+    /**
+     * @brief 记录一次操作的耗时
+     */
+    void record(Operation operation, std::uint64_t nanoseconds) noexcept;
+
+    /**
+     * @brief 事件计数加 n
+     */
+    void count(Event event, std::uint64_t n = 1) noexcept {
+      events_[static_cast<std::size_t>(event)].fetch_add(n, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 当前的统计报告
+     */
+    [[nodiscard]] MetricsReport report() const;
+
+  private:
+    struct Counters {
+      std::array<std::atomic<std::uint64_t>, LatencyHistogram::kBuckets> buckets{};
+      std::atomic<std::uint64_t> count{0};
+      std::atomic<std::uint64_t> total{0};
+      std::atomic<std::uint64_t> max{0};
+    };
+
+    std::array<Counters, kOperationCount> operations_;
+    std::array<std::atomic<std::uint64_t>, 3> events_{};  ///< 下标为 Event 的值
+  };
+
+  namespace detail {
+    /**
+     * @brief 作用域计时器：析构时把经过的时间记入 recorder（recorder 为空时什么也不做）
+     */
+    class OperationTimer {
+    public:
+      OperationTimer(MetricsRecorder* recorder, Operation operation) noexcept
+          : recorder_(recorder), operation_(operation) {
+        if (recorder_ != nullptr) {
+          start_ = std::chrono::steady_clock::now();
+        }
+      }
+
+      OperationTimer(const OperationTimer&) = delete;
+      OperationTimer& operator=(const OperationTimer&) = delete;
+
+      ~OperationTimer() {
+        if (recorder_ != nullptr) {
+          auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::steady_clock::now() - start_);
+          recorder_->record(operation_, static_cast<std::uint64_t>(elapsed.count()));
+        }
+      }
+
+    private:
+      MetricsRecorder* recorder_;
+      Operation operation_;
+      std::chrono::steady_clock::time_point start_{};
+    };
+  }  // namespace detail
+
+}  // namespace student_manager
+
+/**
+ * @def STUDENT_MANAGER_TIME_OPERATION(operation)
+ * @brief 在 StudentManager 的成员函数中统计本次调用的耗时（到函数返回为止）
+ *
+ * @def STUDENT_MANAGER_COUNT_EVENT(event, n)
+ * @brief 在 StudentManager 的成员函数中把事件计数加 n
+ *
+ * 未开启性能统计时两个宏都展开为空语句，不产生任何代码。
+ */
+#if STUDENT_MANAGER_METRICS
+#  define STUDENT_MANAGER_TIME_OPERATION(operation)           \
+    ::student_manager::detail::OperationTimer metrics_timer_( \
+        metrics_.get(), ::student_manager::Operation::operation)
+#  define STUDENT_MANAGER_COUNT_EVENT(event, n)                                  \
+    do {                                                                         \
+      if (metrics_) {                                                            \
+        metrics_->count(::student_manager::MetricsRecorder::Event::event, (n)); \
+      }                                                                          \
+    } while (false)
+#else
+#  define STUDENT_MANAGER_TIME_OPERATION(operation) static_cast<void>(0)
+#  define STUDENT_MANAGER_COUNT_EVENT(event, n) static_cast<void>(0)
+#endif
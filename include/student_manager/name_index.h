@@ -0,0 +1,125 @@
+/**
+ * @file name_index.h
+ * @brief 姓名索引 - 按姓名精确查找、前缀查找和包含查找
+ *
+ * @details
+ * 学号唯一，姓名却经常重复（同名同姓的学生很常见），而且查询时常常只知道姓名的一部分。
+ * 姓名索引把三种查询都变成只访问少量候选者，而不是遍历全部学生。
+ *
+ * 设计说明：
+ * - 按 (姓名, 槽位) 排序的 std::set：同名学生排在一起，精确查找是一次 equal_range；
+ *   UTF-8 编码按字节比较的顺序与按码点比较的顺序相同，并且不会把一个字符的一部分
+ *   当成另一个字符，所以前缀查找就是一次 lower_bound 之后顺序遍历。都是 O(log n + k)
+ * - 包含查找使用 n-gram 倒排表：每个姓名的每个字符（1-gram）和每两个相邻字符（2-gram）
+ *   都记录"哪些槽位的姓名含有它"。查询时取查询串中倒排表最短的一个 gram 作为候选集，
+ *   再逐个确认候选者的姓名确实包含查询串
+ * - 删除学生时不从倒排表中逐个删除（那需要遍历很长的表），只记录失效条目的个数，
+ *   查询时的确认步骤会自然跳过它们；失效条目超过有效条目时整体重建，均摊 O(1)
+ * - 与排名索引一样按句柄槽位记录学生，不受 swap-and-pop 删除移动元素的影响
+ */
+
+#pragma once
+
+#include <cstddef>        // std::size_t
+#include <cstdint>        // std::uint32_t, std::uint64_t
+#include <limits>         // std::numeric_limits
+#include <set>            // std::set
+#include <string>         // std::string
+#include <string_view>    // std::string_view
+#include <unordered_map>  // std::unordered_map
+#include <utility>        // std::pair
+#include <vector>         // std::vector
+
+namespace student_manager {
+
+  /**
+   * @brief 姓名索引：槽位 -> 姓名，支持按姓名查找槽位
+   */
+  class NameIndex {
+  public:
+    NameIndex() = default;
+    NameIndex(const NameIndex& other);
+    NameIndex(NameIndex&& other) noexcept = default;
+    NameIndex& operator=(const NameIndex& other);
+    NameIndex& operator=(NameIndex&& other) noexcept = default;
+    ~NameIndex() = default;
+
+    /**
+     * @brief 索引中的条目数
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return by_name_.size(); }
+
+    /**
+     * @brief 插入一个槽位（槽位当前不能在索引中）
+     */
+    void insert(std::uint32_t slot, std::string_view name);
+
+    /**
+     * @brief 删除一个槽位（槽位必须在索引中）
+     */
+    void erase(std::uint32_t slot);
+
+    /**
+     * @brief 预留能容纳编号小于 slot_count 的槽位的空间
+     */
+    void reserve(std::size_t slot_count) { by_slot_.reserve(slot_count); }
+
+    /**
+     * @brief 清空索引
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief 姓名恰好为 name 的所有槽位（按槽位编号排列）
+     * @note 时间复杂度: O(log n + k)
+     */
+    [[nodiscard]] std::vector<std::uint32_t> find_exact(std::string_view name) const;
+
+    /**
+     * @brief 姓名以 prefix 开头的槽位（按姓名排列，同名按槽位编号）
+     * @param prefix 前缀；末尾不完整的 UTF-8 字符会被忽略
+     * @param limit 最多返回的个数
+     * @note 时间复杂度: O(log n + k)
+     */
+    [[nodiscard]] std::vector<std::uint32_t> find_prefix(
+        std::string_view prefix,
+        std::size_t limit = std::numeric_limits<std::size_t>::max()) const;
+
+    /**
+     * @brief 姓名中包含 text 的所有槽位（按槽位编号排列）
+     * @note 时间复杂度: O(候选者个数)，候选者是含有 text 中最少见的一个（或两个相邻）字符的姓名
+     */
+    [[nodiscard]] std::vector<std::uint32_t> find_substring(std::string_view text) const;
+
+    /**
+     * @brief 去掉末尾不完整的 UTF-8 字符（用户输入被截断时，不把半个字符当作前缀）
+     */
+    [[nodiscard]] static std::string_view complete_prefix(std::string_view text) noexcept;
+
+    /**
+     * @brief 估算占用的内存（std::set 和 std::unordered_map 的节点大小是估算值）
+     */
+    [[nodiscard]] std::size_t memory_bytes() const noexcept;
+
+  private:
+    using Entry = std::pair<std::string, std::uint32_t>;
+
+    /// 按 (姓名, 槽位) 排序；也可以直接与姓名比较，用于 equal_range 和 lower_bound
+    struct EntryLess {
+      using is_transparent = void;
+      bool operator()(const Entry& a, const Entry& b) const noexcept { return a < b; }
+      bool operator()(const Entry& a, std::string_view b) const noexcept { return a.first < b; }
+      bool operator()(std::string_view a, const Entry& b) const noexcept { return a < b.first; }
+    };
+
+    std::set<Entry, EntryLess> by_name_;
+    std::vector<const Entry*> by_slot_;  ///< 槽位 -> by_name_ 中的条目，不在索引中时为空
+    std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> grams_;  ///< gram -> 槽位
+    std::size_t gram_entries_ = 0;  ///< 倒排表中的条目总数（包括失效的）
+    std::size_t stale_grams_ = 0;   ///< 倒排表中已经失效的条目数
+
+    void add_grams(std::uint32_t slot, std::string_view name);
+    void rebuild_grams();
+  };
+
+}  // namespace student_manager
@@ -0,0 +1,192 @@
+/**
+ * @file parallel.h
+ * @brief 并行扫描 - 把大数组分块交给线程池，按块的顺序合并结果
+ *
+ * @details
+ * 几百万名学生的遍历和统计可以分给多个核心同时完成。这里的并行执行遵循两条规则：
+ *
+ * - 分块只取决于元素个数和块大小，与线程数无关；每块先算出自己的部分结果，
+ *   最后由调用线程按块的顺序依次合并。因此无论用几个线程（包括串行执行），
+ *   浮点求和的顺序都完全相同，结果逐位一致
+ * - 元素少于 ParallelOptions::serial_cutoff 时直接在调用线程中执行，
+ *   避免唤醒线程的开销超过计算本身
+ *
+ * 线程池在第一次使用时创建，工作线程数为处理器核心数减 1（调用线程也参与计算）。
+ * 各线程通过一个原子计数器领取下一块，先做完的线程自动多领，负载不均时也能保持所有核心忙碌。
+ */
+
+#pragma once
+
+#include <algorithm>           // std::min
+#include <atomic>              // std::atomic
+#include <condition_variable>  // std::condition_variable
+#include <cstddef>             // std::size_t
+#include <cstdint>             // std::uint64_t
+#include <exception>           // std::exception_ptr
+#include <functional>          // std::function
+#include <mutex>               // std::mutex
+#include <thread>              // std::thread
+#include <vector>              // std::vector
+
+namespace student_manager {
+
+  /**
+   * @brief 并行执行的选项
+   *
+   * @example
+   * @code
+   * auto stats = manager.compute_statistics();  // 默认：成绩较多时使用全部核心
+   * auto serial = manager.compute_statistics(ParallelOptions::serial());
+   * // stats 与 serial 逐位一致
+   * @endcode
+   */
+  struct ParallelOptions {
+    std::size_t threads = 0;              ///< 最多使用的线程数（包括调用线程），0 表示全部核心
+    std::size_t serial_cutoff = 1 << 16;  ///< 元素个数少于此值时串行执行
+
+    /// 总是在调用线程中串行执行
+    [[nodiscard]] static ParallelOptions serial() noexcept { return {1, 0}; }
+  };
+
+  /**
+   * @brief 固定大小的线程池，一次执行一批编号为 0 到 n-1 的任务
+   *
+   * 同一时刻只执行一批任务：线程池正忙（另一个线程正在使用，或者在任务内部再次调用）时，
+   * run() 直接在调用线程中串行执行，不会死锁。
+   */
+  class ThreadPool {
+  public:
+    /**
+     * @param threads 参与计算的线程总数（包括调用 run() 的线程），会创建 threads - 1 个工作线程
+     */
+    explicit ThreadPool(std::size_t threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief 进程内共享的线程池，线程数为处理器核心数
+     */
+    [[nodiscard]] static ThreadPool& shared();
+
+    /**
+     * @brief 参与计算的线程总数（包括调用线程）
+     */
+    [[nodiscard]] std::size_t thread_count() const noexcept { return workers_.size() + 1; }
+
+    /**
+     * @brief 执行 task(0) 到 task(count - 1)，全部完成后返回
+     * @param count 任务个数
+     * @param max_threads 最多使用的线程数（包括调用线程），0 表示不限制
+     * @param task 任务，可能在任意线程中被调用，各任务之间不能有先后依赖
+     * @note 任务抛出异常时，其余任务照常执行完，然后在调用线程中重新抛出第一个异常
+     */
+    void run(std::size_t count, std::size_t max_threads,
+             const std::function<void(std::size_t)>& task);
+
+  private:
+    std::vector<std::thread> workers_;
+    std::mutex run_mutex_;  ///< 保证同一时刻只有一批任务
+    std::mutex mutex_;      ///< 保护以下状态
+    std::condition_variable wake_;
+    std::condition_variable finished_;
+    bool stopping_ = false;
+    std::uint64_t generation_ = 0;  ///< 每批任务加 1，用于唤醒工作线程
+    std::size_t helpers_wanted_ = 0;
+    std::size_t helpers_joined_ = 0;
+    std::size_t helpers_busy_ = 0;
+    const std::function<void(std::size_t)>* task_ = nullptr;
+    std::size_t task_count_ = 0;
+    std::atomic<std::size_t> next_task_{0};
+    std::exception_ptr error_;
+
+    void worker_loop();
+    void drain();
+  };
+
+  namespace parallel {
+
+    /// 扫描时每块的元素个数
+    inline constexpr std::size_t kChunkSize = 16384;
+
+    /**
+     * @brief 把 [0, count) 按 chunk_size 分块，对每块求部分结果
+     * @param map 以 (begin, end) 为参数、返回 Partial 的函数，可能在多个线程中同时调用
+     * @return 按块顺序排列的部分结果
+     */
+    template <typename Partial, typename Map>
+    [[nodiscard]] std::vector<Partial> map_chunks(std::size_t count, std::size_t chunk_size,
+                                                  const ParallelOptions& options, Map&& map) {
+      std::size_t chunks = (count + chunk_size - 1) / chunk_size;
+      std::vector<Partial> partials(chunks);
+      auto run_chunk = [&](std::size_t chunk) {
+        std::size_t begin = chunk * chunk_size;
+        partials[chunk] = map(begin, std::min(begin + chunk_size, count));
+      };
+      if (chunks <= 1 || options.threads == 1 || count < options.serial_cutoff) {
+        for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+          run_chunk(chunk);
+        }
+      } else {
+        ThreadPool::shared().run(chunks, options.threads, run_chunk);
+      }
+      return partials;
+    }
+
+    /**
+     * @brief 统计满足条件的元素个数
+     * @param test 以下标为参数、返回 bool 的函数
+     */
+    template <typename Test>
+    [[nodiscard]] std::size_t count_if(std::size_t count, const ParallelOptions& options,
+                                       Test&& test) {
+      auto partials = map_chunks<std::size_t>(count, kChunkSize, options,
+                                              [&](std::size_t begin, std::size_t end) {
+                                                std::size_t matched = 0;
+                                                for (std::size_t i = begin; i < end; ++i) {
+                                                  matched += test(i) ? 1 : 0;
+                                                }
+                                                return matched;
+                                              });
+      std::size_t total = 0;
+      for (std::size_t matched : partials) {
+        total += matched;
+      }
+      return total;
+    }
+
+    /**
+     * @brief 按原来的顺序列出满足条件的下标
+     * @param test 以下标为参数、返回 bool 的函数
+     */
+    template <typename Test>
+    [[nodiscard]] std::vector<std::size_t> find_if(std::size_t count,
+                                                   const ParallelOptions& options, Test&& test) {
+      auto partials = map_chunks<std::vector<std::size_t>>(
+          count, kChunkSize, options, [&](std::size_t begin, std::size_t end) {
+            std::vector<std::size_t> matched;
+            for (std::size_t i = begin; i < end; ++i) {
+              if (test(i)) {
+                matched.push_back(i);
+              }
+            }
+            return matched;
+          });
+      std::vector<std::size_t> result;
+      for (const auto& matched : partials) {
+        result.insert(result.end(), matched.begin(), matched.end());
+      }
+      return result;
+    }
+
+    /**
+     * @brief 求和：每块用 kernels::sum 求部分和，再按块的顺序相加
+     * @note 结果与线程数无关，但与对整个数组直接调用 kernels::sum 的结果可能有舍入差异
+     */
+    [[nodiscard]] double sum(const double* data, std::size_t count,
+                             const ParallelOptions& options = {});
+
+  }  // namespace parallel
+
+}  // namespace student_manager
@@ -0,0 +1,141 @@
+/**
+ * @file rank_index.h
+ * @brief 成绩排名索引 - 带子树大小的平衡树（顺序统计树）
+ *
+ * @details
+ * 支持在 O(log n) 时间内回答"某个成绩排第几"和"第 k 名是多少分"，
+ * 不需要每次复制并排序整个学生列表。
+ *
+ * 设计说明：
+ * - 使用树堆（treap）：按 (成绩, 槽位) 有序的二叉搜索树，同时按随机优先级满足堆性质，
+ *   期望树高 O(log n)；每个节点额外记录子树大小，用来做排名和选择
+ * - 节点直接按学生的句柄槽位编号存放在 std::vector 中，节点编号就是槽位编号，
+ *   不需要额外的映射表，也不需要为每个节点单独分配内存
+ * - 成绩相同的学生按槽位编号排序，因此键总是唯一的
+ */
+
+#pragma once
+
+#include <cstddef>  // std::size_t
+#include <cstdint>  // std::uint32_t, std::uint64_t
+#include <vector>   // std::vector
+
+namespace student_manager {
+
+  /**
+   * @brief 顺序统计树：槽位 -> 成绩，按成绩排序
+   */
+  class RankIndex {
+  public:
+    /**
+     * @brief 索引中的条目数
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+    /**
+     * @brief 插入一个槽位（槽位当前不能在索引中）
+     */
+    void insert(std::uint32_t slot, double score);
+
+    /**
+     * @brief 删除一个槽位（槽位必须在索引中）
+     */
+    void erase(std::uint32_t slot);
+
+    /**
+     * @brief 修改槽位对应的成绩
+     */
+    void update(std::uint32_t slot, double score) {
+      erase(slot);
+      insert(slot, score);
+    }
+
+    /**
+     * @brief 预留能容纳编号小于 slot_count 的槽位的空间
+     */
+    void reserve(std::size_t slot_count) { nodes_.reserve(slot_count); }
+
+    /**
+     * @brief 清空索引
+     */
+    void clear() noexcept {
+      nodes_.clear();
+      root_ = kNil;
+      size_ = 0;
+    }
+
+    /**
+     * @brief 统计成绩严格高于 score 的条目数
+     * @note 时间复杂度: 期望 O(log n)
+     */
+    [[nodiscard]] std::size_t count_greater(double score) const noexcept;
+
+    /**
+     * @brief 获取成绩第 k 高的槽位（k 从 0 开始，必须小于 size()）
+     * @note 时间复杂度: 期望 O(log n)
+     */
+    [[nodiscard]] std::uint32_t kth_largest(std::size_t k) const noexcept;
+
+    /**
+     * @brief 获取槽位当前记录的成绩
+     */
+    [[nodiscard]] double score_of(std::uint32_t slot) const noexcept { return nodes_[slot].score; }
+
+    /**
+     * @brief 按成绩从高到低列出前 k 个槽位
+     * @note 时间复杂度: 期望 O(log n + k)
+     */
+    [[nodiscard]] std::vector<std::uint32_t> top(std::size_t k) const;
+
+    /**
+     * @brief 按成绩从低到高列出前 k 个槽位
+     * @note 时间复杂度: 期望 O(log n + k)
+     */
+    [[nodiscard]] std::vector<std::uint32_t> bottom(std::size_t k) const;
+
+    /**
+     * @brief 索引占用的字节数
+     */
+    [[nodiscard]] std::size_t memory_bytes() const noexcept {
+      return nodes_.capacity() * sizeof(Node);
+    }
+
+  private:
+    static constexpr std::uint32_t kNil = 0xFFFFFFFFu;
+
+    /// 树节点，下标就是槽位编号
+    struct Node {
+      double score = 0.0;
+      std::uint32_t priority = 0;  ///< 随机优先级，父节点的优先级不小于子节点
+      std::uint32_t left = kNil;
+      std::uint32_t right = kNil;
+      std::uint32_t size = 1;  ///< 子树大小（包括自己）
+    };
+
+    std::vector<Node> nodes_;
+    std::uint32_t root_ = kNil;
+    std::size_t size_ = 0;
+    std::uint64_t random_state_ = 0x9E3779B97F4A7C15ull;  ///< 生成优先级的随机数状态
+
+    [[nodiscard]] std::uint32_t subtree_size(std::uint32_t node) const noexcept {
+      return node == kNil ? 0 : nodes_[node].size;
+    }
+
+    /// 键比较：先比成绩，成绩相同再比槽位编号
+    [[nodiscard]] bool key_less(std::uint32_t a, double score, std::uint32_t slot) const noexcept {
+      const Node& node = nodes_[a];
+      return node.score < score || (node.score == score && a < slot);
+    }
+
+    void pull(std::uint32_t node) noexcept;
+    std::uint32_t next_priority() noexcept;
+
+    /// 把 tree 拆成键小于 (score, slot) 的部分和其余部分
+    void split(std::uint32_t tree, double score, std::uint32_t slot, std::uint32_t& less,
+               std::uint32_t& rest) noexcept;
+
+    /// 合并两棵树，要求 left 中的键都小于 right 中的键
+    std::uint32_t merge(std::uint32_t left, std::uint32_t right) noexcept;
+  };
+
+}  // namespace student_manager
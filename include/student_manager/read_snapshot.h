@@ -0,0 +1,217 @@
+/**
+ * @file read_snapshot.h
+ * @brief 只读快照 - 统计和报表线程不加锁地读取某一时刻的全部数据
+ *
+ * @details
+ * 写线程修改 StudentManager 的同时，报表线程需要遍历全部学生、计算统计量。
+ * 加锁遍历会让写线程在整个遍历期间等待，ReadSnapshot 采用 RCU（读-复制-更新）的思路：
+ *
+ * - 快照是不可变的，按 kChunkRows 行一块分块存放；读线程拿到快照之后随意遍历，不需要任何锁
+ * - 写线程修改数据时只标记受影响的块；发布新版本时只复制这些块，其余块与旧版本共享。
+ *   只改成绩时只复制成绩块（kChunkRows 个 double），姓名和学号块继续共享
+ * - 新版本通过原子地替换一个 std::shared_ptr 发布，读线程原子地读取这个指针，
+ *   两边都只在交换指针的瞬间同步，读线程不会让写线程等待遍历结束
+ * - 旧版本由引用计数回收：最后一个持有它的读线程放手时，只属于旧版本的块被释放
+ *
+ * 读线程总是看到某一次发布时的完整数据，不会看到"改了一半"的状态：
+ * 关闭自动发布后，在两次 publish_read_snapshot() 之间的几次修改，读线程要么全部看到，
+ * 要么全部看不到。
+ */
+
+#pragma once
+
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint8_t, std::uint32_t, std::uint64_t
+#include <memory>       // std::shared_ptr
+#include <optional>     // std::optional
+#include <string_view>  // std::string_view
+#include <vector>       // std::vector
+
+#include "student_manager/compact_string.h"
+#include "student_manager/statistics.h"
+
+namespace student_manager {
+
+  class Student;
+
+  /**
+   * @brief 某一时刻全部学生的不可变快照
+   *
+   * 通过 StudentManager::read_snapshot() 获得，可以在任意线程中使用，也可以一直持有。
+   * 行号与发布时 StudentManager::get_all_students() 中的下标一致。
+   *
+   * @example
+   * @code
+   * // 报表线程
+   * auto snapshot = manager.read_snapshot();
+   * std::cout << "人数: " << snapshot->size()
+   *           << " 平均分: " << snapshot->calculate_average_score() << "\n";
+   * snapshot->for_each([](std::string_view name, std::string_view id, double score) {
+   *   std::cout << name << " " << id << " " << score << "\n";
+   * });
+   * @endcode
+   */
+  class ReadSnapshot {
+  public:
+    /// 每块的行数
+    static constexpr std::size_t kChunkRows = 1024;
+
+    /// 一块学生的姓名和学号（只在增删学生时复制）
+    struct RowBlock {
+      std::vector<CompactString> names;
+      std::vector<CompactString> ids;
+    };
+
+    /// 一块学生：共享的姓名学号块 + 本块的成绩和部分统计量
+    struct Chunk {
+      std::shared_ptr<const RowBlock> rows;
+      std::vector<double> scores;
+      double sum = 0.0;
+      double min = 0.0;  ///< 块为空时无意义
+      double max = 0.0;
+    };
+
+    using ChunkTable = std::vector<std::shared_ptr<const Chunk>>;
+
+    ReadSnapshot(ChunkTable chunks, std::size_t rows, std::uint64_t version);
+
+    /**
+     * @brief 发布序号，同一个发布者每次发布加 1
+     */
+    [[nodiscard]] std::uint64_t version() const noexcept { return version_; }
+
+    [[nodiscard]] std::size_t size() const noexcept { return rows_; }
+    [[nodiscard]] bool empty() const noexcept { return rows_ == 0; }
+    [[nodiscard]] int get_student_count() const noexcept { return static_cast<int>(rows_); }
+
+    [[nodiscard]] std::string_view name(std::size_t row) const noexcept {
+      return chunk_of(row).rows->names[row % kChunkRows].view();
+    }
+
+    [[nodiscard]] std::string_view id(std::size_t row) const noexcept {
+      return chunk_of(row).rows->ids[row % kChunkRows].view();
+    }
+
+    [[nodiscard]] double score(std::size_t row) const noexcept {
+      return chunk_of(row).scores[row % kChunkRows];
+    }
+
+    /**
+     * @brief 按行号顺序访问每个学生
+     * @param visit 以 (std::string_view 姓名, std::string_view 学号, double 成绩) 为参数的回调
+     */
+    template <typename Visitor> void for_each(Visitor&& visit) const {
+      for (const auto& chunk : chunks_) {
+        for (std::size_t i = 0; i < chunk->scores.size(); ++i) {
+          visit(chunk->rows->names[i].view(), chunk->rows->ids[i].view(), chunk->scores[i]);
+        }
+      }
+    }
+
+    /**
+     * @brief 平均成绩，没有学生时返回 0.0
+     * @note 时间复杂度 O(块数)：合并各块发布时算好的部分和
+     */
+    [[nodiscard]] double calculate_average_score() const noexcept;
+
+    /**
+     * @brief 最高分 / 最低分，没有学生时返回 std::nullopt
+     * @note 时间复杂度 O(块数)
+     */
+    [[nodiscard]] std::optional<double> get_max_score() const noexcept;
+    [[nodiscard]] std::optional<double> get_min_score() const noexcept;
+
+    /**
+     * @brief 完整的成绩统计报告（见 statistics.h）
+     * @note 需要把成绩复制到一个连续数组中，时间复杂度 O(n)
+     */
+    [[nodiscard]] ScoreStatistics compute_statistics() const;
+
+    /**
+     * @brief 复制出所有学生
+     */
+    [[nodiscard]] std::vector<Student> get_all_students() const;
+
+  private:
+    ChunkTable chunks_;
+    std::size_t rows_;
+    std::uint64_t version_;
+
+    [[nodiscard]] const Chunk& chunk_of(std::size_t row) const noexcept {
+      return *chunks_[row / kChunkRows];
+    }
+  };
+
+  /**
+   * @brief 写线程一侧：记录哪些块被修改过，并发布新的快照
+   *
+   * 由 StudentManager 在启用只读快照后持有。除 current() 之外的方法都只能由写线程调用；
+   * current() 可以被任意线程同时调用。
+   */
+  class ReadSnapshotPublisher {
+  public:
+    /**
+     * @param publish_every 每累计多少次修改自动发布一次，0 表示只在调用 publish() 时发布
+     */
+    explicit ReadSnapshotPublisher(std::size_t publish_every) noexcept
+        : publish_every_(publish_every) {}
+
+    ReadSnapshotPublisher(const ReadSnapshotPublisher& other);
+    ReadSnapshotPublisher(ReadSnapshotPublisher&& other) noexcept;
+    ReadSnapshotPublisher& operator=(const ReadSnapshotPublisher& other);
+    ReadSnapshotPublisher& operator=(ReadSnapshotPublisher&& other) noexcept;
+    ~ReadSnapshotPublisher() = default;
+
+    /**
+     * @brief 第 row 行的姓名、学号（或者行本身）变了
+     */
+    void mark_row(std::size_t row);
+
+    /**
+     * @brief 第 row 行只有成绩变了
+     */
+    void mark_score(std::size_t row);
+
+    /**
+     * @brief 所有行都变了（清空、整体替换）
+     */
+    void mark_all() noexcept;
+
+    /**
+     * @brief 记录一次修改
+     * @return 达到自动发布的间隔时返回 true
+     */
+    [[nodiscard]] bool count_change() noexcept {
+      return publish_every_ != 0 && ++pending_changes_ >= publish_every_;
+    }
+
+    /**
+     * @brief 根据当前数据发布新版本
+     * @param students 学生列表
+     * @param scores 成绩列，与 students 一一对应
+     * @note 时间复杂度 O(块数 + 被修改的块数 × kChunkRows)
+     */
+    void publish(const std::vector<Student>& students, const std::vector<double>& scores);
+
+    /**
+     * @brief 最近一次发布的快照（线程安全）
+     */
+    [[nodiscard]] std::shared_ptr<const ReadSnapshot> current() const;
+
+    [[nodiscard]] std::size_t publish_every() const noexcept { return publish_every_; }
+
+  private:
+    enum : std::uint8_t { kClean = 0, kScoresDirty = 1, kRowsDirty = 2 };
+
+    std::size_t publish_every_;
+    std::size_t pending_changes_ = 0;
+    std::uint64_t version_ = 0;
+    ReadSnapshot::ChunkTable chunks_;    ///< 最近一次发布的块表
+    std::vector<std::uint8_t> dirty_;    ///< 每块的修改状态，下标超出 chunks_ 的块都要新建
+    bool all_dirty_ = true;
+    std::shared_ptr<const ReadSnapshot> published_;  ///< 只通过 std::atomic_load/store 访问
+
+    void mark(std::size_t row, std::uint8_t state);
+  };
+
+}  // namespace student_manager
@@ -0,0 +1,127 @@
+/**
+ * @file report_writer.h
+ * @brief 学生列表报表 - 排序、分页，按显示宽度对齐的表格输出
+ *
+ * @details
+ * 用 std::setw 逐个字段输出时，每个字段都要经过一次 iostream 的格式化和虚函数调用，
+ * 学生多时输出全部学生的时间主要花在格式化上。而且 std::setw 按字节计算宽度：
+ * 一个汉字占 3 个字节、在终端中占 2 列，含有汉字的列无法对齐。
+ *
+ * ReportWriter 的做法：
+ * - 创建时确定行的顺序（按学号、姓名或成绩排序时使用管理器缓存的排序视图，
+ *   数据没有变化时不重新排序），并计算每个姓名和学号的显示宽度
+ *   （东亚宽字符算 2 列，组合字符算 0 列），得到整张表统一的列宽，各页的列对齐一致
+ * - 输出时把整行拼接在一个复用的缓冲区中：补齐用的空格直接追加，成绩用 std::to_chars
+ *   格式化；缓冲区攒到 1 MB 左右才写到输出流一次
+ * - 分页时逐页输出，每页重复表头，也可以只输出某一页（交互式翻页）
+ */
+
+#pragma once
+
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint8_t, std::uint16_t, std::uint32_t
+#include <iosfwd>       // std::ostream
+#include <string>       // std::string
+#include <string_view>  // std::string_view
+#include <vector>       // std::vector
+
+namespace student_manager {
+
+  class StudentManager;
+
+  /**
+   * @brief 报表中行的顺序
+   */
+  enum class ReportOrder : std::uint8_t {
+    insertion,  ///< 与 get_all_students() 相同
+    by_id,      ///< 与 StudentManager::sorted_by(SortKey::id) 相同
+    by_name,    ///< 与 StudentManager::sorted_by(SortKey::name) 相同
+    by_score,   ///< 与 StudentManager::sorted_by(SortKey::score) 相同（从低到高，同分按学号）
+  };
+
+  /**
+   * @brief 报表选项
+   */
+  struct ReportOptions {
+    ReportOrder order = ReportOrder::insertion;  ///< 行的顺序
+    bool descending = false;                     ///< 倒序（如按成绩从高到低），整个顺序反过来
+    std::size_t page_size = 0;                   ///< 每页的行数，0 表示不分页
+    int score_precision = 2;                     ///< 成绩保留的小数位数
+  };
+
+  /**
+   * @brief 学生列表报表
+   *
+   * @warning 报表引用管理器中的学生，创建之后添加、删除或修改学生会使报表失效
+   *
+   * @example
+   * @code
+   * ReportOptions options;
+   * options.order = ReportOrder::by_score;
+   * options.descending = true;
+   * options.page_size = 50;
+   * ReportWriter report(manager, options);
+   * report.write_page(0, std::cout);  // 成绩最高的 50 名学生
+   * report.write_all(std::cout);      // 全部学生，每 50 行重复一次表头
+   * @endcode
+   */
+  class ReportWriter {
+  public:
+    /// 缓冲区攒到这么多字节时写到输出流
+    static constexpr std::size_t kFlushSize = 1 << 20;
+
+    /**
+     * @brief 创建报表：确定行的顺序，计算列宽
+     * @note 时间复杂度: O(n)，另加取得排序视图的时间（见 StudentManager::sorted_by()）
+     */
+    explicit ReportWriter(const StudentManager& manager, const ReportOptions& options = {});
+
+    /**
+     * @brief 报表的行数（学生人数）
+     */
+    [[nodiscard]] std::size_t row_count() const noexcept { return order_.size(); }
+
+    /**
+     * @brief 页数（不分页或没有学生时为 1）
+     */
+    [[nodiscard]] std::size_t page_count() const noexcept;
+
+    /**
+     * @brief 输出某一页：表头、这一页的行，分页时再加一行页码
+     * @param page 页码（从 0 开始），超出范围时只输出表头
+     */
+    void write_page(std::size_t page, std::ostream& out);
+
+    /**
+     * @brief 依次输出所有页，页与页之间空一行
+     */
+    void write_all(std::ostream& out);
+
+    /**
+     * @brief 文本在终端中占的列数：东亚宽字符和全角字符算 2 列，组合字符算 0 列，其余算 1 列
+     * @note 不合法的 UTF-8 字节按 1 列计算
+     */
+    [[nodiscard]] static std::size_t display_width(std::string_view text) noexcept;
+
+  private:
+    const StudentManager& manager_;
+    ReportOptions options_;
+    std::vector<std::uint32_t> order_;        ///< 报表的第 i 行是第 order_[i] 个学生
+    std::vector<std::uint16_t> name_widths_;  ///< 每个学生姓名的显示宽度（按学生下标）
+    std::vector<std::uint16_t> id_widths_;    ///< 每个学生学号的显示宽度（按学生下标）
+    std::size_t name_column_ = 0;             ///< 姓名列的宽度（不含列间距）
+    std::size_t id_column_ = 0;               ///< 学号列的宽度
+    std::size_t score_column_ = 0;            ///< 成绩列的宽度
+    std::string buffer_;                      ///< 复用的输出缓冲区
+
+    void sort_rows();
+    void append_page(std::size_t page, std::ostream& out);
+    void append_header();
+    void append_row(std::uint32_t index);
+    void append_padded(std::string_view text, std::size_t width, std::size_t column);
+    void append_score(double score);
+    void flush_if_full(std::ostream& out);
+    void flush(std::ostream& out);
+  };
+
+}  // namespace student_manager
@@ -0,0 +1,135 @@
+/**
+ * @file score_aggregates.h
+ * @brief 增量维护的成绩统计量（总分、人数、最高分、最低分）
+ *
+ * @details
+ * 每次添加、删除学生或修改成绩时只更新一次统计量，
+ * 查询平均分 O(1)，查询最高分/最低分 O(1)，更新 O(log n)。
+ *
+ * 设计说明：
+ * - 总分使用 Neumaier 补偿求和，反复加减后也不会明显漂移
+ * - 最高分/最低分使用 std::multiset 维护有序成绩，允许重复分数
+ * - 修改成绩时通过 C++17 的节点句柄（extract）复用树节点，不需要重新分配内存
+ */
+
+#pragma once
+
+#include <cmath>     // std::fabs
+#include <cstddef>   // std::size_t
+#include <optional>  // std::optional
+#include <set>       // std::multiset
+#include <utility>   // std::move
+
+namespace student_manager {
+
+  /**
+   * @brief 成绩统计量
+   */
+  class ScoreAggregates {
+  public:
+    /**
+     * @brief 记录一个新成绩
+     */
+    void add(double score) {
+      accumulate(score);
+      ordered_.insert(score);
+    }
+
+    /**
+     * @brief 移除一个已记录的成绩
+     */
+    void remove(double score) {
+      auto it = ordered_.find(score);
+      if (it != ordered_.end()) {
+        ordered_.erase(it);
+        accumulate(-score);
+      }
+    }
+
+    /**
+     * @brief 把一个已记录的成绩改为新成绩
+     */
+    void replace(double old_score, double new_score) noexcept {
+      auto it = ordered_.find(old_score);
+      if (it == ordered_.end() || old_score == new_score) {
+        return;
+      }
+      auto node = ordered_.extract(it);
+      node.value() = new_score;
+      ordered_.insert(std::move(node));
+      accumulate(-old_score);
+      accumulate(new_score);
+    }
+
+    /**
+     * @brief 清空所有统计量
+     */
+    void clear() noexcept {
+      ordered_.clear();
+      sum_ = 0.0;
+      compensation_ = 0.0;
+    }
+
+    /**
+     * @brief 已记录的成绩个数
+     */
+    [[nodiscard]] std::size_t count() const noexcept { return ordered_.size(); }
+
+    /**
+     * @brief 成绩总和
+     */
+    [[nodiscard]] double sum() const noexcept { return sum_ + compensation_; }
+
+    /**
+     * @brief 平均成绩，没有成绩时返回 0.0
+     */
+    [[nodiscard]] double average() const noexcept {
+      return ordered_.empty() ? 0.0 : sum() / static_cast<double>(ordered_.size());
+    }
+
+    /**
+     * @brief 最高分，没有成绩时返回 std::nullopt
+     */
+    [[nodiscard]] std::optional<double> max() const noexcept {
+      if (ordered_.empty()) {
+        return std::nullopt;
+      }
+      return *ordered_.rbegin();
+    }
+
+    /**
+     * @brief 最低分，没有成绩时返回 std::nullopt
+     */
+    [[nodiscard]] std::optional<double> min() const noexcept {
+      if (ordered_.empty()) {
+        return std::nullopt;
+      }
+      return *ordered_.begin();
+    }
+
+    /**
+     * @brief 估算占用的字节数
+     * @note std::multiset 的每个节点约为一个 double 加上三个指针和颜色标记
+     */
+    [[nodiscard]] std::size_t memory_bytes() const noexcept {
+      return ordered_.size() * (sizeof(double) + 4 * sizeof(void*));
+    }
+
+  private:
+    std::multiset<double> ordered_;  ///< 有序成绩，用于最高分/最低分
+    double sum_ = 0.0;               ///< 总分的主要部分
+    double compensation_ = 0.0;      ///< Neumaier 补偿项，记录被舍入丢掉的低位
+
+    /// Neumaier 补偿求和的一步
+    void accumulate(double value) noexcept {
+      double t = sum_ + value;
+      if (std::fabs(sum_) >= std::fabs(value)) {
+        compensation_ += (sum_ - t) + value;
+      } else {
+        compensation_ += (value - t) + sum_;
+      }
+      sum_ = t;
+    }
+  };
+
+}  // namespace student_manager
@@ -0,0 +1,125 @@
+/**
+ * @file score_histogram.h
+ * @brief 成绩直方图 - 按 0.01 分分桶的树状数组（Fenwick tree）
+ *
+ * @details
+ * 成绩范围固定为 0-100（见 Student::is_valid_score），按 0.01 分划分为 10001 个桶，
+ * 用树状数组记录每个桶的人数，于是：
+ *
+ * - 修改一个成绩：O(log B)，B = 10001，约 14 步
+ * - 统计某个分数段的人数：O(log B)，与学生人数无关
+ * - 近似百分位数：在树状数组上二分下降，O(log B)
+ *
+ * 整个直方图只占约 40 KB，查询时完全不需要访问学生数据。
+ */
+
+#pragma once
+
+#include <cstddef>  // std::size_t
+#include <cstdint>  // std::uint32_t
+#include <vector>   // std::vector
+
+namespace student_manager {
+
+  /**
+   * @brief 0.01 分精度的成绩直方图
+   *
+   * 成绩 s 落入第 floor(s * 100) 个桶，因此 69.995 与 69.99 同属一个桶。
+   * 不在 0-100 范围内的成绩不进入任何桶，只单独计数。
+   */
+  class ScoreHistogram {
+  public:
+    /// 桶的个数：0.00, 0.01, ..., 100.00
+    static constexpr std::size_t kBucketCount = 10001;
+
+    ScoreHistogram() : tree_(kBucketCount + 1, 0) {}
+
+    /**
+     * @brief 记录一个成绩
+     */
+    void add(double score) noexcept { change(score, 1); }
+
+    /**
+     * @brief 移除一个已记录的成绩
+     */
+    void remove(double score) noexcept { change(score, -1); }
+
+    /**
+     * @brief 把一个已记录的成绩改为新成绩
+     */
+    void replace(double old_score, double new_score) noexcept {
+      remove(old_score);
+      add(new_score);
+    }
+
+    /**
+     * @brief 清空直方图
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief 已记录的成绩总数（包括超出范围的）
+     */
+    [[nodiscard]] std::size_t total() const noexcept { return total_; }
+
+    /**
+     * @brief 不在 0-100 范围内的成绩个数
+     */
+    [[nodiscard]] std::size_t out_of_range() const noexcept { return out_of_range_; }
+
+    /**
+     * @brief 统计成绩在 [low, high] 之间的人数（两端都包含，精度 0.01 分）
+     */
+    [[nodiscard]] std::size_t count_in_range(double low, double high) const noexcept;
+
+    /**
+     * @brief 统计成绩低于 score 的人数（精度 0.01 分）
+     */
+    [[nodiscard]] std::size_t count_below(double score) const noexcept;
+
+    /**
+     * @brief 按分数段统计人数
+     * @param boundaries 严格递增的分数段边界 b0 < b1 < ... < bm
+     * @return m 个计数，第 i 个是 [b(i), b(i+1)) 内的人数；最后一段包含上边界
+     *
+     * @example
+     * @code
+     * // 不及格 / 及格 / 中等 / 良好 / 优秀
+     * auto bands = histogram.distribution({0, 60, 70, 80, 90, 100});
+     * @endcode
+     */
+    [[nodiscard]] std::vector<std::size_t> distribution(const std::vector<double>& boundaries) const;
+
+    /**
+     * @brief 近似百分位数（最近秩法）
+     * @param percentile 0-100 之间的百分位
+     * @return 至少有 percentile% 的成绩不高于返回值的最小桶下界；没有成绩时返回 -1
+     *
+     * @note 结果精确到 0.01 分：对于最多两位小数的成绩，结果就是准确值
+     */
+    [[nodiscard]] double percentile(double percentile) const noexcept;
+
+    /**
+     * @brief 直方图占用的字节数
+     */
+    [[nodiscard]] std::size_t memory_bytes() const noexcept {
+      return tree_.capacity() * sizeof(std::uint32_t);
+    }
+
+    /**
+     * @brief 成绩所在的桶，超出范围返回 kBucketCount
+     */
+    [[nodiscard]] static std::size_t bucket_of(double score) noexcept;
+
+  private:
+    std::vector<std::uint32_t> tree_;  ///< 树状数组，下标从 1 开始
+    std::size_t total_ = 0;
+    std::size_t out_of_range_ = 0;
+
+    void change(double score, int delta) noexcept;
+
+    /// 桶 [0, bucket] 的人数之和
+    [[nodiscard]] std::size_t prefix(std::size_t bucket) const noexcept;
+  };
+
+}  // namespace student_manager
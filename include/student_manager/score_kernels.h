@@ -0,0 +1,137 @@
+/**
+ * @file score_kernels.h
+ * @brief 成绩列的向量化统计内核（求和、最高分、最低分）
+ *
+ * @details
+ * 这些函数作用在连续存放的 double 数组上（StudentManager::get_scores() 返回的成绩列），
+ * 运行时根据 CPU 支持的指令集选择实现：
+ *
+ * - avx2：每条指令处理 4 个 double，两组累加器交替使用
+ * - sse2：每条指令处理 2 个 double（x86-64 上总是可用）
+ * - scalar：普通循环，适用于所有平台（例如 ARM）
+ *
+ * 求和的结果与所选实现无关：三种实现都按照相同的"8 路交错累加 + 固定顺序合并"
+ * 计算，浮点加法的顺序完全一致，因此结果逐位相同。
+ *
+ * 另有一组作用在 std::uint16_t 数组上的版本，用于定点成绩（以 0.01 分为单位，见 fixed_score.h）：
+ * 每条 AVX2 指令处理 16 个成绩、SSE2 处理 8 个；整数求和没有舍入误差，结果总是精确的。
+ *
+ * @note 数组中不应包含 NaN，否则最高分/最低分的结果取决于实现
+ */
+
+#pragma once
+
+#include <cstddef>  // std::size_t
+#include <cstdint>  // std::uint16_t, std::uint64_t
+
+namespace student_manager::kernels {
+
+  /**
+   * @brief 向量指令集级别
+   */
+  enum class SimdLevel {
+    scalar,  ///< 不使用向量指令
+    sse2,    ///< SSE2（128 位）
+    avx2,    ///< AVX2（256 位）
+  };
+
+  /**
+   * @brief 检测当前 CPU 支持的最高级别（结果会被缓存）
+   */
+  [[nodiscard]] SimdLevel detect_simd_level() noexcept;
+
+  /**
+   * @brief 获取级别名称，例如 "avx2"
+   */
+  [[nodiscard]] const char* to_string(SimdLevel level) noexcept;
+
+  /**
+   * @brief 求和
+   * @param data 成绩数组
+   * @param count 元素个数，可以为 0
+   * @param level 使用的指令集，高于 CPU 支持的级别时自动降级
+   */
+  [[nodiscard]] double sum(const double* data, std::size_t count, SimdLevel level) noexcept;
+
+  /**
+   * @brief 最小值
+   * @param count 元素个数，必须大于 0
+   */
+  [[nodiscard]] double min(const double* data, std::size_t count, SimdLevel level) noexcept;
+
+  /**
+   * @brief 最大值
+   * @param count 元素个数，必须大于 0
+   */
+  [[nodiscard]] double max(const double* data, std::size_t count, SimdLevel level) noexcept;
+
+  // ==================== 定点成绩（std::uint16_t） ====================
+
+  /**
+   * @brief 求和（精确）
+   * @param count 元素个数，可以为 0
+   */
+  [[nodiscard]] std::uint64_t sum_fixed(const std::uint16_t* data, std::size_t count,
+                                        SimdLevel level) noexcept;
+
+  /**
+   * @brief 最小值
+   * @param count 元素个数，必须大于 0
+   */
+  [[nodiscard]] std::uint16_t min_fixed(const std::uint16_t* data, std::size_t count,
+                                        SimdLevel level) noexcept;
+
+  /**
+   * @brief 最大值
+   * @param count 元素个数，必须大于 0
+   */
+  [[nodiscard]] std::uint16_t max_fixed(const std::uint16_t* data, std::size_t count,
+                                        SimdLevel level) noexcept;
+
+  /**
+   * @brief 统计每个值出现的次数：counts[v] 加上 v 出现的次数
+   * @param counts 调用者提供的计数数组（不会先清零），长度为 bucket_count
+   * @param bucket_count 不小于 bucket_count 的值不计数
+   * @note 向量指令没有冲突检测的 scatter（AVX-512 之前），这里只能逐个计数；
+   *       用 4 张交替使用的计数表，避免相同成绩连续出现时每次都等待上一次写入
+   */
+  void histogram(const std::uint16_t* data, std::size_t count, std::uint64_t* counts,
+                 std::size_t bucket_count);
+
+  /**
+   * @brief 使用检测到的最高级别求和
+   */
+  [[nodiscard]] inline double sum(const double* data, std::size_t count) noexcept {
+    return sum(data, count, detect_simd_level());
+  }
+
+  /**
+   * @brief 使用检测到的最高级别求最小值
+   */
+  [[nodiscard]] inline double min(const double* data, std::size_t count) noexcept {
+    return min(data, count, detect_simd_level());
+  }
+
+  /**
+   * @brief 使用检测到的最高级别求最大值
+   */
+  [[nodiscard]] inline double max(const double* data, std::size_t count) noexcept {
+    return max(data, count, detect_simd_level());
+  }
+
+  [[nodiscard]] inline std::uint64_t sum_fixed(const std::uint16_t* data,
+                                                std::size_t count) noexcept {
+    return sum_fixed(data, count, detect_simd_level());
+  }
+
+  [[nodiscard]] inline std::uint16_t min_fixed(const std::uint16_t* data,
+                                                std::size_t count) noexcept {
+    return min_fixed(data, count, detect_simd_level());
+  }
+
+  [[nodiscard]] inline std::uint16_t max_fixed(const std::uint16_t* data,
+                                                std::size_t count) noexcept {
+    return max_fixed(data, count, detect_simd_level());
+  }
+
+}  // namespace student_manager::kernels
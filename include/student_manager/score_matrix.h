@@ -0,0 +1,246 @@
+/**
+ * @file score_matrix.h
+ * @brief 多科目成绩矩阵 - 每个科目一列连续存放，缺考/未录入用位图标记
+ *
+ * @details
+ * 每个学生有多门课的成绩时，如果为每门课各建一个 StudentManager，每个姓名和学号都要
+ * 在每门课中重复保存一次。成绩矩阵只在已有的学生列表旁边为每个科目增加一列：
+ *
+ * - 按列存放（column-major）：第 s 个科目的成绩是一个连续的 double 数组，
+ *   第 i 个元素对应 get_all_students()[i]，与成绩列 get_scores() 的对应方式相同
+ * - 每列另有一个有效位图（每 64 名学生一个 std::uint64_t），记录哪些学生有这门课的成绩；
+ *   没有成绩的位置存 0.0，因此求和可以直接交给向量化内核 kernels::sum，不需要逐个判断
+ * - 每增加一个科目，每个学生只多占 8 字节加 1 位，姓名和学号不会重复保存
+ * - 删除学生时与学生列表一样 swap-and-pop，每列只移动一个元素
+ * - 科目可以选择定点存放（ScoreStorage::hundredths）：成绩四舍五入到 0.01 分，
+ *   每个只占 2 字节，总和与平均分用整数精确计算（见 fixed_score.h）
+ *
+ * 绩点（GPA）使用常见的 4.0 分制连续公式：60 分以上为 4 - 3 × (100 - 成绩)² / 1600，
+ * 不及格为 0；学生的 GPA 是有成绩的科目按学分加权的平均绩点。
+ */
+
+#pragma once
+
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint64_t
+#include <string>       // std::string
+#include <string_view>  // std::string_view
+#include <vector>       // std::vector
+
+#include "student_manager/fixed_score.h"
+
+namespace student_manager {
+
+  /**
+   * @brief 科目成绩的存放方式
+   */
+  enum class ScoreStorage {
+    binary64,    ///< double，保持录入时的精度，每个成绩 8 字节
+    hundredths,  ///< 定点，四舍五入到 0.01 分，每个成绩 2 字节
+  };
+
+  /**
+   * @brief 多科目成绩矩阵，行与学生列表一一对应
+   */
+  class ScoreMatrix {
+  public:
+    /// 表示"没有这个科目"
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    /**
+     * @brief 成绩对应的绩点（4.0 分制）
+     */
+    [[nodiscard]] static constexpr double grade_point(double score) noexcept {
+      return score >= 60.0 ? 4.0 - 3.0 * (100.0 - score) * (100.0 - score) / 1600.0 : 0.0;
+    }
+
+    // ==================== 科目 ====================
+
+    /**
+     * @brief 科目数
+     */
+    [[nodiscard]] std::size_t subject_count() const noexcept { return columns_.size(); }
+
+    /**
+     * @brief 增加一个科目（所有学生都还没有成绩）
+     * @return 新科目的编号
+     * @note 调用者需保证名称不重复、学分大于 0
+     */
+    std::size_t add_subject(std::string_view name, double credits,
+                            ScoreStorage storage = ScoreStorage::binary64);
+
+    /**
+     * @brief 删除一个科目，后面的科目编号依次减 1
+     */
+    void remove_subject(std::size_t subject);
+
+    /**
+     * @brief 按名称查找科目
+     * @return 科目编号，不存在时返回 npos
+     */
+    [[nodiscard]] std::size_t find_subject(std::string_view name) const noexcept;
+
+    [[nodiscard]] std::string_view name(std::size_t subject) const noexcept {
+      return columns_[subject].name;
+    }
+
+    [[nodiscard]] double credits(std::size_t subject) const noexcept {
+      return columns_[subject].credits;
+    }
+
+    [[nodiscard]] ScoreStorage storage(std::size_t subject) const noexcept {
+      return columns_[subject].storage;
+    }
+
+    /**
+     * @brief 复制另一个矩阵的科目定义（名称、学分和存放方式），不复制成绩；当前必须没有行
+     */
+    void copy_subjects_from(const ScoreMatrix& other);
+
+    // ==================== 行（学生） ====================
+
+    /**
+     * @brief 行数（学生人数）
+     */
+    [[nodiscard]] std::size_t rows() const noexcept { return rows_; }
+
+    /**
+     * @brief 在末尾增加一行（新学生没有任何科目的成绩）
+     */
+    void push_row();
+
+    /**
+     * @brief 删除一行：用最后一行填补（swap-and-pop）
+     */
+    void swap_remove(std::size_t row) noexcept;
+
+    /**
+     * @brief 删除所有行，保留科目
+     */
+    void clear_rows() noexcept;
+
+    /**
+     * @brief 为 rows 行预留空间
+     */
+    void reserve(std::size_t rows);
+
+    // ==================== 成绩 ====================
+
+    /**
+     * @brief 是否有成绩
+     */
+    [[nodiscard]] bool has(std::size_t subject, std::size_t row) const noexcept {
+      return (columns_[subject].valid[row / 64] >> (row % 64) & 1U) != 0;
+    }
+
+    /**
+     * @brief 成绩（没有成绩时为 0.0）
+     */
+    [[nodiscard]] double get(std::size_t subject, std::size_t row) const noexcept {
+      const Column& column = columns_[subject];
+      return column.storage == ScoreStorage::hundredths
+                 ? FixedScore::from_raw(column.fixed[row]).to_double()
+                 : column.values[row];
+    }
+
+    /**
+     * @brief 录入或修改成绩
+     * @note 调用者需保证成绩在 0-100 范围内；定点科目四舍五入到 0.01 分
+     */
+    void set(std::size_t subject, std::size_t row, double score) noexcept;
+
+    /**
+     * @brief 删除成绩（变为没有成绩）
+     */
+    void unset(std::size_t subject, std::size_t row) noexcept;
+
+    /**
+     * @brief 一个科目的整列成绩，没有成绩的位置为 0.0；定点科目的这一列为空
+     */
+    [[nodiscard]] const std::vector<double>& column(std::size_t subject) const noexcept {
+      return columns_[subject].values;
+    }
+
+    /**
+     * @brief 定点科目的整列原始值（0.01 分为单位），没有成绩的位置为 0；double 科目的这一列为空
+     */
+    [[nodiscard]] const std::vector<std::uint16_t>& fixed_column(
+        std::size_t subject) const noexcept {
+      return columns_[subject].fixed;
+    }
+
+    /**
+     * @brief 一个科目的有效位图：第 i 名学生对应第 i / 64 个元素的第 i % 64 位
+     */
+    [[nodiscard]] const std::vector<std::uint64_t>& validity(std::size_t subject) const noexcept {
+      return columns_[subject].valid;
+    }
+
+    // ==================== 统计 ====================
+
+    /**
+     * @brief 有这门课成绩的学生人数
+     * @note 时间复杂度: O(1)
+     */
+    [[nodiscard]] std::size_t count(std::size_t subject) const noexcept {
+      return columns_[subject].count;
+    }
+
+    /**
+     * @brief 这门课的成绩总和
+     * @note 时间复杂度: O(n)，使用向量化求和内核
+     */
+    [[nodiscard]] double sum(std::size_t subject) const noexcept;
+
+    /**
+     * @brief 这门课的平均分，没有成绩时返回负数
+     * @note 定点科目的总和是精确的整数，平均分只在最后一次除法中舍入
+     */
+    [[nodiscard]] double average(std::size_t subject) const noexcept;
+
+    /**
+     * @brief 这门课所有成绩（按行的顺序，跳过没有成绩的学生）
+     */
+    [[nodiscard]] std::vector<double> valid_scores(std::size_t subject) const;
+
+    /**
+     * @brief 定点科目的所有原始值（按行的顺序，跳过没有成绩的学生）
+     */
+    [[nodiscard]] std::vector<std::uint16_t> valid_hundredths(std::size_t subject) const;
+
+    /**
+     * @brief 一名学生有成绩的科目的平均分，没有任何成绩时返回负数
+     */
+    [[nodiscard]] double row_average(std::size_t row) const noexcept;
+
+    /**
+     * @brief 一名学生的 GPA，没有任何成绩时返回负数
+     */
+    [[nodiscard]] double row_gpa(std::size_t row) const noexcept;
+
+    /**
+     * @brief 所有学生的 GPA（按列累加，每列一次顺序遍历），没有任何成绩的学生为负数
+     */
+    [[nodiscard]] std::vector<double> gpas() const;
+
+    /**
+     * @brief 占用的字节数
+     */
+    [[nodiscard]] std::size_t memory_bytes() const noexcept;
+
+  private:
+    struct Column {
+      std::string name;
+      double credits = 1.0;
+      ScoreStorage storage = ScoreStorage::binary64;
+      std::vector<double> values;         ///< binary64 科目的成绩，没有成绩的位置为 0.0
+      std::vector<std::uint16_t> fixed;   ///< hundredths 科目的原始值，没有成绩的位置为 0
+      std::vector<std::uint64_t> valid;   ///< 有效位图
+      std::size_t count = 0;              ///< 有成绩的学生人数
+    };
+
+    std::vector<Column> columns_;
+    std::size_t rows_ = 0;
+  };
+
+}  // namespace student_manager
@@ -0,0 +1,143 @@
+/**
+ * @file slot_table.h
+ * @brief 学生句柄与槽位表（slot map）
+ *
+ * @details
+ * StudentManager 的学生列表是紧凑存储的（删除时 swap-and-pop），元素的下标会变化，
+ * 引用也会在扩容时失效。槽位表在"句柄"和"当前下标"之间加了一层间接：
+ *
+ * - 每个学生占用一个槽位，槽位记录该学生当前所在的行号
+ * - 句柄 = 槽位编号 + 代数（generation）
+ * - 槽位被释放时代数加一，旧句柄的代数对不上，因此会被安全地判定为无效
+ * - 释放的槽位通过空闲链表复用，分配和释放都是 O(1)
+ */
+
+#pragma once
+
+#include <cstddef>  // std::size_t
+#include <cstdint>  // std::uint32_t
+#include <vector>   // std::vector
+
+namespace student_manager {
+
+  /**
+   * @brief 学生句柄
+   *
+   * 句柄在学生被删除之前一直有效，不受其他学生的添加、删除或存储扩容影响。
+   * 学生被删除（或管理器被清空）后，句柄会被判定为无效，不会指向别的学生。
+   */
+  struct StudentHandle {
+    std::uint32_t slot = 0xFFFFFFFFu;  ///< 槽位编号
+    std::uint32_t generation = 0;      ///< 分配时槽位的代数
+
+    friend bool operator==(StudentHandle a, StudentHandle b) noexcept {
+      return a.slot == b.slot && a.generation == b.generation;
+    }
+    friend bool operator!=(StudentHandle a, StudentHandle b) noexcept { return !(a == b); }
+  };
+
+  /**
+   * @brief 槽位表：句柄 -> 行号
+   *
+   * @note 代数是 32 位的，同一个槽位被复用约 42 亿次后会回绕，实际使用中可以忽略
+   */
+  class SlotTable {
+  public:
+    /// 表示"无效"的行号
+    static constexpr std::uint32_t npos = 0xFFFFFFFFu;
+
+    /**
+     * @brief 分配一个槽位并记录行号
+     * @return 新句柄
+     */
+    StudentHandle allocate(std::uint32_t row) {
+      std::uint32_t slot;
+      if (free_head_ != npos) {
+        slot = free_head_;
+        free_head_ = entries_[slot].row;  // 空闲槽位的 row 字段保存下一个空闲槽位
+      } else {
+        slot = static_cast<std::uint32_t>(entries_.size());
+        entries_.push_back(Entry{});
+      }
+      entries_[slot].row = row;
+      entries_[slot].live = true;
+      return StudentHandle{slot, entries_[slot].generation};
+    }
+
+    /**
+     * @brief 释放槽位，之前发出的该槽位句柄全部失效
+     */
+    void release(std::uint32_t slot) noexcept {
+      Entry& entry = entries_[slot];
+      entry.live = false;
+      ++entry.generation;
+      entry.row = free_head_;
+      free_head_ = slot;
+    }
+
+    /**
+     * @brief 查询句柄当前对应的行号
+     * @return 句柄有效返回行号，否则返回 npos
+     */
+    [[nodiscard]] std::uint32_t row_of(StudentHandle handle) const noexcept {
+      if (handle.slot >= entries_.size()) {
+        return npos;
+      }
+      const Entry& entry = entries_[handle.slot];
+      return entry.live && entry.generation == handle.generation ? entry.row : npos;
+    }
+
+    /**
+     * @brief 获取使用中的槽位当前对应的行号（不做代数校验，供内部索引使用）
+     */
+    [[nodiscard]] std::uint32_t row_of_slot(std::uint32_t slot) const noexcept {
+      return entries_[slot].row;
+    }
+
+    /**
+     * @brief 获取槽位当前的句柄（槽位必须处于使用中）
+     */
+    [[nodiscard]] StudentHandle handle_of(std::uint32_t slot) const noexcept {
+      return StudentHandle{slot, entries_[slot].generation};
+    }
+
+    /**
+     * @brief 元素在存储中被移动后，更新槽位记录的行号
+     */
+    void set_row(std::uint32_t slot, std::uint32_t row) noexcept { entries_[slot].row = row; }
+
+    /**
+     * @brief 预留槽位空间
+     */
+    void reserve(std::size_t count) { entries_.reserve(count); }
+
+    /**
+     * @brief 释放所有使用中的槽位，所有已发出的句柄都会失效
+     */
+    void clear() noexcept {
+      for (std::size_t slot = 0; slot < entries_.size(); ++slot) {
+        if (entries_[slot].live) {
+          release(static_cast<std::uint32_t>(slot));
+        }
+      }
+    }
+
+    /**
+     * @brief 槽位表占用的字节数
+     */
+    [[nodiscard]] std::size_t memory_bytes() const noexcept {
+      return entries_.capacity() * sizeof(Entry);
+    }
+
+  private:
+    struct Entry {
+      std::uint32_t row = npos;      ///< 使用中：学生所在行号；空闲：下一个空闲槽位
+      std::uint32_t generation = 0;  ///< 代数，每次释放加一
+      bool live = false;             ///< 槽位是否正在使用
+    };
+
+    std::vector<Entry> entries_;
+    std::uint32_t free_head_ = npos;  ///< 空闲链表头
+  };
+
+}  // namespace student_manager
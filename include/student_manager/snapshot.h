@@ -0,0 +1,180 @@
+/**
+ * @file snapshot.h
+ * @brief 二进制快照 - 带版本号和校验和的存档格式，支持内存映射读取
+ *
+ * @details
+ * 快照把所有学生按列写入一个文件：
+ *
+ * | 区段     | 内容                                               |
+ * |----------|----------------------------------------------------|
+ * | 文件头   | 魔数、版本号、字节序标记、行数、各区段偏移、日志序号、校验和 |
+ * | 成绩列   | double[n]                                          |
+ * | 学号键列 | uint64[n]，见 IdKey::pack                          |
+ * | 字符串表 | uint64[2n + 1]，第 i 行的姓名和学号在字符区中的范围 |
+ * | 字符区   | 所有姓名和学号依次排列，末尾补零到 8 字节对齐       |
+ *
+ * 所有区段都按 8 字节对齐，内存映射之后可以直接当作数组使用，不需要解析或复制。
+ * 文件头有单独的校验和，打开时总是检查；其余数据的校验和需要读完整个文件，
+ * 由 SnapshotView::verify() 按需检查（StudentManager::load_snapshot 总是检查）。
+ *
+ * @note 快照按本机字节序写入，字节序不同的机器会拒绝打开（SnapshotStatus::unsupported_format）
+ */
+
+#pragma once
+
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint8_t, std::uint64_t
+#include <optional>     // std::optional
+#include <string>       // std::string
+#include <string_view>  // std::string_view
+#include <utility>      // std::move
+#include <vector>       // std::vector
+
+#include "student_manager/id_index.h"
+
+namespace student_manager {
+
+  class Student;
+
+  /**
+   * @brief 快照读写的结果
+   */
+  enum class SnapshotStatus : std::uint8_t {
+    ok,                  ///< 成功
+    open_failed,         ///< 无法打开或创建文件
+    io_error,            ///< 读写或内存映射失败
+    not_a_snapshot,      ///< 文件太短或魔数不对
+    unsupported_format,  ///< 版本号或字节序不受支持
+    corrupted,           ///< 校验和不匹配或区段越界
+  };
+
+  /**
+   * @brief 结果的文字说明
+   */
+  [[nodiscard]] const char* to_string(SnapshotStatus status) noexcept;
+
+  /**
+   * @brief 把学生列表写成快照
+   *
+   * 先写入同目录下的临时文件，全部写完并刷到磁盘后再替换目标文件，
+   * 写到一半失败或断电都不会破坏已有的快照。返回 ok 时替换也已经落盘。
+   *
+   * @param journal_sequence 快照已包含的最后一条日志记录的序号（见 journal.h），
+   *        从日志恢复时只回放序号更大的记录
+   */
+  [[nodiscard]] SnapshotStatus write_snapshot(const std::string& path,
+                                              const std::vector<Student>& students,
+                                              std::uint64_t journal_sequence = 0);
+
+  /**
+   * @brief 把 path 所在目录的目录项刷到磁盘
+   *
+   * 新建或改名文件之后，只刷文件本身不能保证断电后目录中还能找到它，
+   * 在删除或截断依赖这个文件的其他文件之前调用。Windows 上改名时使用
+   * MOVEFILE_WRITE_THROUGH，目录项随文件系统日志落盘，此函数不做任何事。
+   */
+  [[nodiscard]] bool sync_parent_directory(const std::string& path);
+
+  /**
+   * @brief 内存映射的只读快照
+   *
+   * 打开快照只需要映射文件并检查文件头，与行数无关；姓名、学号和成绩直接从映射中读取，
+   * 按学号查找所需的哈希索引在第一次调用 find() 时才建立。
+   *
+   * @warning find() 会在第一次调用时修改内部状态，多个线程同时使用同一个对象时需要自行加锁
+   *
+   * @example
+   * @code
+   * SnapshotView view;
+   * if (view.open("students.snap") == SnapshotStatus::ok) {
+   *   double total = kernels::sum(view.scores(), view.size());
+   *   if (auto row = view.find("2023001")) {
+   *     std::cout << view.name(*row) << "\n";
+   *   }
+   * }
+   * @endcode
+   */
+  class SnapshotView {
+  public:
+    SnapshotView() = default;
+    SnapshotView(const SnapshotView&) = delete;
+    SnapshotView& operator=(const SnapshotView&) = delete;
+    SnapshotView(SnapshotView&& other) noexcept { *this = std::move(other); }
+    SnapshotView& operator=(SnapshotView&& other) noexcept;
+    ~SnapshotView() { close(); }
+
+    /**
+     * @brief 映射快照文件并检查文件头
+     * @note 失败时对象保持关闭状态
+     */
+    [[nodiscard]] SnapshotStatus open(const std::string& path);
+
+    /**
+     * @brief 解除映射
+     */
+    void close() noexcept;
+
+    [[nodiscard]] bool is_open() const noexcept { return data_ != nullptr; }
+
+    /**
+     * @brief 行数
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return rows_; }
+
+    [[nodiscard]] std::string_view name(std::size_t row) const noexcept {
+      return text(2 * row);
+    }
+
+    [[nodiscard]] std::string_view id(std::size_t row) const noexcept {
+      return text(2 * row + 1);
+    }
+
+    [[nodiscard]] double score(std::size_t row) const noexcept { return scores_[row]; }
+
+    /**
+     * @brief 成绩列，可以直接交给 kernels::sum 等函数
+     */
+    [[nodiscard]] const double* scores() const noexcept { return scores_; }
+
+    /**
+     * @brief 快照已包含的最后一条日志记录的序号，不是由日志模式写出的快照为 0
+     */
+    [[nodiscard]] std::uint64_t journal_sequence() const noexcept { return journal_sequence_; }
+
+    /**
+     * @brief 按学号查找行号
+     * @note 第一次调用时建立哈希索引（O(n)），之后平均 O(1)
+     */
+    [[nodiscard]] std::optional<std::size_t> find(std::string_view id) const;
+
+    /**
+     * @brief 检查数据区的校验和以及字符串表是否有效
+     * @note 需要读完整个文件，时间复杂度 O(文件大小)
+     */
+    [[nodiscard]] SnapshotStatus verify() const noexcept;
+
+  private:
+    const std::uint8_t* data_ = nullptr;
+    std::size_t file_size_ = 0;
+    void* file_handle_ = nullptr;     ///< Windows：文件句柄
+    void* mapping_handle_ = nullptr;  ///< Windows：映射对象句柄
+
+    std::size_t rows_ = 0;
+    const double* scores_ = nullptr;
+    const std::uint64_t* id_keys_ = nullptr;
+    const std::uint64_t* string_offsets_ = nullptr;
+    const char* strings_ = nullptr;
+    std::uint64_t journal_sequence_ = 0;
+
+    mutable std::optional<IdIndex> index_;  ///< 学号索引，第一次查找时建立
+
+    [[nodiscard]] std::string_view text(std::size_t index) const noexcept {
+      std::uint64_t begin = string_offsets_[index];
+      return {strings_ + begin, static_cast<std::size_t>(string_offsets_[index + 1] - begin)};
+    }
+
+    [[nodiscard]] SnapshotStatus map(const std::string& path);
+    [[nodiscard]] SnapshotStatus check_header() noexcept;
+  };
+
+}  // namespace student_manager
@@ -0,0 +1,187 @@
+/**
+ * @file sorted_index.h
+ * @brief 排序索引 - 缓存的行排列，修改后按需增量修补
+ *
+ * @details
+ * 按学号、成绩或姓名列出学生时，如果每次都复制一份学生列表再排序，
+ * 即使数据没有变化也要付出 O(n log n)。排序索引把排好的顺序（行号的排列）缓存下来：
+ *
+ * - 数据没有变化时直接返回缓存的排列，不做任何计算
+ * - 添加、删除学生或修改排序依据时，只记下受影响的槽位（O(1)），不立即修补，
+ *   因此批量导入时不会为每个学生移动一次整个排列
+ * - 下一次取得排列时一次修补：去掉受影响的旧条目，把受影响的学生单独排序后
+ *   与其余部分归并，总共 O(n + k log k)（k 为受影响的学生数）
+ * - 受影响的学生比总人数还多时，放弃缓存，下一次整体重新排序
+ *
+ * 条目按句柄槽位记录，删除时 swap-and-pop 移动了最后一个学生，排序位置不变，
+ * 只需要重新从槽位换算行号。
+ */
+
+#pragma once
+
+#include <algorithm>  // std::sort, std::merge, std::remove_if
+#include <cstddef>    // std::size_t
+#include <cstdint>    // std::uint8_t, std::uint32_t
+#include <numeric>    // std::iota
+#include <utility>    // std::move
+#include <vector>     // std::vector
+
+#include "student_manager/slot_table.h"
+
+namespace student_manager {
+
+  /**
+   * @brief 排序依据
+   */
+  enum class SortKey : std::uint8_t {
+    id,     ///< 按学号：纯数字学号按数值（位数少的在前），排在其他学号之前，其余按字节
+    score,  ///< 按成绩从低到高，同分按学号
+    name,   ///< 按姓名的 UTF-8 编码（即 Unicode 码点顺序，不是拼音顺序），同名按学号
+  };
+
+  /// 排序依据的个数
+  inline constexpr std::size_t kSortKeyCount = 3;
+
+  /**
+   * @brief 一种排序依据的排序索引
+   *
+   * 比较函数 less(a, b) 比较两个行号，必须是全序（不存在相等的两行），
+   * 这样修补后的结果与整体重新排序完全相同。
+   */
+  class SortedIndex {
+  public:
+    /**
+     * @brief 是否已经建立（没有建立时修改不需要记录）
+     */
+    [[nodiscard]] bool built() const noexcept { return built_; }
+
+    /**
+     * @brief 排好序的行号；调用前需要先 refresh()
+     */
+    [[nodiscard]] const std::vector<std::uint32_t>& rows() const noexcept { return rows_; }
+
+    /**
+     * @brief 记录一个槽位的学生被添加、删除或排序依据被修改
+     */
+    void mark(std::uint32_t slot) {
+      if (!built_) {
+        return;
+      }
+      if (slot >= marked_.size()) {
+        marked_.resize(static_cast<std::size_t>(slot) + 1, 0);
+      }
+      if (marked_[slot] == 0) {
+        marked_[slot] = 1;
+        pending_.push_back(slot);
+        if (pending_.size() > order_.size() + kMinPending) {
+          reset();  // 修补已经不比重新排序便宜
+        }
+      }
+    }
+
+    /**
+     * @brief 记录学生在列表中的位置发生了移动（排序依据不变）
+     */
+    void mark_moved() noexcept { rows_stale_ = true; }
+
+    /**
+     * @brief 放弃缓存，下一次 refresh() 时整体重新排序
+     */
+    void reset() noexcept {
+      built_ = false;
+      rows_stale_ = false;
+      order_.clear();
+      rows_.clear();
+      pending_.clear();
+      marked_.clear();
+    }
+
+    /**
+     * @brief 让 rows() 反映当前数据：没有建立时整体排序，否则修补记录下来的变化
+     * @param slots 槽位表
+     * @param row_slots 行号 -> 槽位
+     * @param less 行号的比较函数
+     */
+    template <typename Less>
+    void refresh(const SlotTable& slots, const std::vector<std::uint32_t>& row_slots, Less less) {
+      if (!built_) {
+        rows_.resize(row_slots.size());
+        std::iota(rows_.begin(), rows_.end(), std::uint32_t{0});
+        std::sort(rows_.begin(), rows_.end(), less);
+        store_order(row_slots);
+        built_ = true;
+        return;
+      }
+      if (pending_.empty()) {
+        if (rows_stale_) {
+          load_rows(slots);
+        }
+        return;
+      }
+
+      // 1. 去掉受影响的旧条目，其余条目的相对顺序不变
+      order_.erase(std::remove_if(order_.begin(), order_.end(),
+                                  [this](std::uint32_t slot) {
+                                    return slot < marked_.size() && marked_[slot] != 0;
+                                  }),
+                   order_.end());
+      load_rows(slots);
+
+      // 2. 受影响且仍然存在的学生单独排序
+      std::vector<std::uint32_t> fresh;
+      fresh.reserve(pending_.size());
+      for (std::uint32_t slot : pending_) {
+        marked_[slot] = 0;
+        std::uint32_t row = slots.row_of(slots.handle_of(slot));
+        if (row != SlotTable::npos) {
+          fresh.push_back(row);
+        }
+      }
+      pending_.clear();
+      std::sort(fresh.begin(), fresh.end(), less);
+
+      // 3. 归并
+      std::vector<std::uint32_t> merged(rows_.size() + fresh.size());
+      std::merge(rows_.begin(), rows_.end(), fresh.begin(), fresh.end(), merged.begin(), less);
+      rows_ = std::move(merged);
+      store_order(row_slots);
+    }
+
+    /**
+     * @brief 索引占用的字节数
+     */
+    [[nodiscard]] std::size_t memory_bytes() const noexcept {
+      return (order_.capacity() + rows_.capacity() + pending_.capacity())
+                 * sizeof(std::uint32_t)
+             + marked_.capacity();
+    }
+
+  private:
+    /// 受影响的学生不多时总是修补（人数很少时也不频繁重新排序）
+    static constexpr std::size_t kMinPending = 64;
+
+    std::vector<std::uint32_t> order_;    ///< 排好序的槽位
+    std::vector<std::uint32_t> rows_;     ///< 排好序的行号，rows_[i] 是 order_[i] 当前的行号
+    std::vector<std::uint32_t> pending_;  ///< 上次修补之后受影响的槽位
+    std::vector<std::uint8_t> marked_;    ///< 按槽位标记是否在 pending_ 中
+    bool built_ = false;
+    bool rows_stale_ = false;  ///< 有学生移动了位置，rows_ 需要从 order_ 重新换算
+
+    void store_order(const std::vector<std::uint32_t>& row_slots) {
+      order_.resize(rows_.size());
+      for (std::size_t i = 0; i < rows_.size(); ++i) {
+        order_[i] = row_slots[rows_[i]];
+      }
+      rows_stale_ = false;
+    }
+
+    void load_rows(const SlotTable& slots) {
+      rows_.resize(order_.size());
+      for (std::size_t i = 0; i < order_.size(); ++i) {
+        rows_[i] = slots.row_of_slot(order_[i]);
+      }
+      rows_stale_ = false;
+    }
+  };
+
+}  // namespace student_manager
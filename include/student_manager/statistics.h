@@ -0,0 +1,70 @@
+/**
+ * @file statistics.h
+ * @brief 成绩统计报告（平均分、方差、最高/最低分、百分位数）
+ *
+ * @details
+ * 一次遍历成绩列就得到完整的统计报告，而不是分别调用多个函数各扫描一遍。
+ *
+ * 设计说明：
+ * - 成绩按 1024 个一块处理，一块数据可以完整放进 L1 缓存
+ * - 每块先求块内平均值，再求块内离差平方和，最后用 Chan 等人的合并公式把各块合并，
+ *   这和 Welford 算法一样数值稳定，但没有逐元素的除法，便于编译器向量化
+ * - 遍历时顺便把成绩复制到临时缓冲区，百分位数用 std::nth_element（选择算法，平均 O(n)）
+ *   在缓冲区上计算，不需要完整排序
+ * - 成绩较多时各块交给线程池并行处理，再按块的顺序合并，结果与串行计算逐位一致（见 parallel.h）
+ */
+
+#pragma once
+
+#include <cstddef>  // std::size_t
+#include <cstdint>  // std::uint16_t
+
+#include "student_manager/parallel.h"
+
+namespace student_manager {
+
+  /**
+   * @brief 成绩统计报告
+   *
+   * 百分位数使用线性插值：第 p 百分位数位于排序后下标 (n - 1) * p / 100 处，
+   * 落在两个成绩之间时按距离插值（与 Excel 的 PERCENTILE.INC、NumPy 的默认算法一致）。
+   */
+  struct ScoreStatistics {
+    std::size_t count = 0;       ///< 成绩个数，为 0 时其余字段都是 0
+    double mean = 0.0;           ///< 平均分
+    double variance = 0.0;       ///< 总体方差
+    double stddev = 0.0;         ///< 总体标准差
+    double min = 0.0;            ///< 最低分
+    double max = 0.0;            ///< 最高分
+    double percentile_25 = 0.0;  ///< 第 25 百分位数（下四分位数）
+    double median = 0.0;         ///< 中位数
+    double percentile_75 = 0.0;  ///< 第 75 百分位数（上四分位数）
+    double percentile_90 = 0.0;  ///< 第 90 百分位数
+  };
+
+  /**
+   * @brief 计算一组成绩的统计报告
+   * @param scores 连续存放的成绩
+   * @param count 成绩个数
+   * @param options 并行选项，默认在成绩较多时使用全部核心
+   * @return 统计报告
+   *
+   * @note 时间复杂度平均 O(n)，额外使用 n 个 double 的临时空间；
+   *       百分位数的选择步骤仍然在调用线程中串行执行
+   */
+  [[nodiscard]] ScoreStatistics compute_score_statistics(const double* scores, std::size_t count,
+                                                         const ParallelOptions& options = {});
+
+  /**
+   * @brief 计算一组定点成绩（以 0.01 分为单位，见 fixed_score.h）的统计报告
+   * @param hundredths 连续存放的原始值，每个都不超过 FixedScore::kMaxRaw
+   * @param count 成绩个数
+   * @return 统计报告（字段的含义与 double 版本相同，单位换算回分）
+   *
+   * @note 只遍历一次数据，统计出每个值的人数（10001 个桶），其余全部在计数表上计算：
+   *       平均分由整数总和精确得到，百分位数不需要选择算法，也不需要 n 个元素的临时空间
+   */
+  [[nodiscard]] ScoreStatistics compute_fixed_score_statistics(const std::uint16_t* hundredths,
+                                                               std::size_t count);
+
+}  // namespace student_manager
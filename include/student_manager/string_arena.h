@@ -0,0 +1,67 @@
+/**
+ * @file string_arena.h
+ * @brief 字符串区 - 把长姓名和长学号紧密排列在大块内存中
+ *
+ * @details
+ * 不能直接存放在 CompactString 内部的长字符串，如果每个都单独 new 一次，
+ * 一百万个学生就是上百万次小块分配，每块还要额外付出分配器的头部和对齐开销。
+ * 字符串区按 64 KB 的大块申请内存，字符串依次紧挨着存放（不需要结尾的 '\0'），
+ * 只在整体清空时释放。
+ *
+ * 字符串区不会回收单个字符串：删除学生后留下的空洞由 StudentManager 记录，
+ * 空洞过多时整体重建一次（见 StudentManager::compact_strings）。
+ */
+
+#pragma once
+
+#include <cstddef>  // std::size_t
+#include <memory>   // std::unique_ptr
+#include <utility>  // std::move
+#include <vector>   // std::vector
+
+namespace student_manager {
+
+  /**
+   * @brief 只增不减的字符串存储区（bump allocator）
+   */
+  class StringArena {
+  public:
+    /// 每个内存块的默认大小
+    static constexpr std::size_t kBlockSize = 64 * 1024;
+
+    StringArena() = default;
+    StringArena(const StringArena&) = delete;
+    StringArena& operator=(const StringArena&) = delete;
+    StringArena(StringArena&& other) noexcept { *this = std::move(other); }
+    StringArena& operator=(StringArena&& other) noexcept;
+    ~StringArena() = default;
+
+    /**
+     * @brief 申请 size 字节的存储，在 clear() 或字符串区销毁之前一直有效
+     */
+    [[nodiscard]] char* allocate(std::size_t size);
+
+    /**
+     * @brief 已分配出去的字节数
+     */
+    [[nodiscard]] std::size_t bytes_used() const noexcept { return used_; }
+
+    /**
+     * @brief 向系统申请的总字节数
+     */
+    [[nodiscard]] std::size_t bytes_reserved() const noexcept { return reserved_; }
+
+    /**
+     * @brief 释放所有内存块，之前分配的存储全部失效
+     */
+    void clear() noexcept;
+
+  private:
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char* cursor_ = nullptr;     ///< 当前块中下一个可用字节
+    std::size_t remaining_ = 0;  ///< 当前块中剩余的字节数
+    std::size_t used_ = 0;
+    std::size_t reserved_ = 0;
+  };
+
+}  // namespace student_manager
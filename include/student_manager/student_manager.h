@@ -35,14 +35,44 @@
 
 #pragma once
 
-#include <functional>   // std::reference_wrapper
+#include <algorithm>    // std::max
+#include <array>        // std::array
+#include <cstddef>      // std::size_t, std::ptrdiff_t
+#include <cstdint>      // std::uint8_t
+#include <functional>   // std::reference_wrapper, std::cref
+#include <iterator>     // std::size, std::reverse_iterator, std::random_access_iterator_tag
+#include <limits>       // std::numeric_limits
+#include <memory>       // std::unique_ptr, std::shared_ptr
+#include <mutex>        // std::mutex
 #include <optional>     // std::optional - 可选值类型
 #include <string>       // std::string - 字符串
 #include <string_view>  // std::string_view - 字符串视图（只读）
+#include <type_traits>  // std::is_lvalue_reference_v, std::void_t
+#include <utility>      // std::move, std::declval
 #include <vector>       // std::vector - 动态数组
 
+#include "student_manager/compact_string.h"
+#include "student_manager/id_index.h"
+#include "student_manager/id_key.h"
+#include "student_manager/journal.h"
+#include "student_manager/metrics.h"
+#include "student_manager/name_index.h"
+#include "student_manager/parallel.h"
+#include "student_manager/rank_index.h"
+#include "student_manager/read_snapshot.h"
+#include "student_manager/score_aggregates.h"
+#include "student_manager/score_histogram.h"
+#include "student_manager/score_matrix.h"
+#include "student_manager/slot_table.h"
+#include "student_manager/snapshot.h"
+#include "student_manager/sorted_index.h"
+#include "student_manager/statistics.h"
+#include "student_manager/string_arena.h"
+
 namespace student_manager {
 
+  class StudentManager;
+
   /**
    * @brief 学生类
    *
@@ -54,12 +84,26 @@ namespace student_manager {
    * - getter 方法标记为 const，表示不修改对象状态
    * - getter 方法标记为 noexcept，承诺不抛出异常
    * - 返回 std::string_view 避免不必要的字符串拷贝
+   * - 姓名和学号使用 16 字节的 CompactString：不超过 15 字节时直接存放在对象内部，
+   *   更长时放在所属管理器的字符串区中，整个 Student 只占 48 字节
+   * - 存放在 StudentManager 中的学生会记住所属的管理器，修改成绩时通知管理器更新统计量
    */
   class Student {
   private:
-    std::string name_;  ///< 学生姓名（使用下划线后缀命名风格）
-    std::string id_;    ///< 学号（字符串类型，支持带前导零的学号如 "001234"）
-    double score_;      ///< 成绩（0-100分）
+    CompactString name_;               ///< 学生姓名（使用下划线后缀命名风格）
+    CompactString id_;                 ///< 学号（字符串类型，支持带前导零的学号如 "001234"）
+    double score_;                     ///< 成绩（0-100分）
+    StudentManager* owner_ = nullptr;  ///< 所属的管理器，不属于任何管理器时为空
+
+    friend class StudentManager;
+
+    /// 通过所属的管理器把自己替换为 other 的内容（定义在 StudentManager 之后）
+    void replace_in_owner(const Student& other);
+
+    /// 取出 other 的字符串：管理器中的学生的长字符串在管理器的字符串区中，只能复制
+    static CompactString take_string(const Student& other, CompactString& text) {
+      return other.owner_ != nullptr ? CompactString(text) : std::move(text);
+    }
 
   public:
     /**
@@ -70,8 +114,65 @@ namespace student_manager {
      *
      * @note 使用成员初始化列表（member initializer list）比函数体内赋值更高效
      */
-    Student(std::string name, std::string id, double score = 0.0)
-        : name_(std::move(name)), id_(std::move(id)), score_(score) {}
+    Student(std::string_view name, std::string_view id, double score = 0.0)
+        : name_(name), id_(id), score_(score) {}
+
+    /**
+     * @brief 拷贝构造函数
+     * @note 拷贝出来的学生不属于任何管理器
+     */
+    Student(const Student& other) : name_(other.name_), id_(other.id_), score_(other.score_) {}
+
+    /**
+     * @brief 移动构造函数
+     * @note 移动出来的学生不属于任何管理器
+     * @note 从管理器中的学生移动时等同于拷贝：长姓名和长学号存放在管理器的字符串区中，
+     *       不能被接管，管理器中的这条记录保持不变。此时复制长字符串需要分配内存，
+     *       内存不足会终止程序
+     */
+    Student(Student&& other) noexcept
+        : name_(take_string(other, other.name_)),
+          id_(take_string(other, other.id_)),
+          score_(other.score_) {}
+
+    /**
+     * @brief 拷贝赋值
+     * @note 不改变所属的管理器。管理器中的学生被整体替换时，由管理器同步更新学号索引、
+     *       姓名索引、排序视图和统计量，相当于原地修改这条记录
+     * @throw std::invalid_argument 管理器中的学生被赋予另一个学生已经使用的学号，此时不做任何修改
+     */
+    Student& operator=(const Student& other) {
+      if (this != &other) {
+        if (owner_ != nullptr) {
+          replace_in_owner(other);
+        } else {
+          name_ = other.name_;
+          id_ = other.id_;
+          score_ = other.score_;
+        }
+      }
+      return *this;
+    }
+
+    /**
+     * @brief 移动赋值
+     * @note 规则与拷贝赋值相同；管理器中的学生总是复制 other 的内容，
+     *       other 是管理器中的学生时也只复制，不接管它的存储
+     */
+    Student& operator=(Student&& other) {
+      if (this != &other) {
+        if (owner_ != nullptr) {
+          replace_in_owner(other);
+        } else {
+          name_ = take_string(other, other.name_);
+          id_ = take_string(other, other.id_);
+          score_ = other.score_;
+        }
+      }
+      return *this;
+    }
+
+    ~Student() = default;
 
     // ==================== Getter 方法 ====================
     // 这些方法都是 const 的，表示不会修改对象
@@ -102,8 +203,13 @@ namespace student_manager {
     /**
      * @brief 设置成绩
      * @param new_score 新成绩（调用者需确保在 0-100 范围内）
+     *
+     * @note 如果学生属于某个 StudentManager，会通知管理器同步更新统计量
+     * @note 不属于任何管理器的学生不会抛出异常；属于管理器时，更新排名索引、排序视图、
+     *       日志和只读快照需要分配内存，可能抛出 std::bad_alloc（日志的后台压缩还可能抛出
+     *       std::system_error），因此这个函数没有标记为 noexcept
      */
-    void set_score(double new_score) noexcept { score_ = new_score; }
+    void set_score(double new_score);
 
     /**
      * @brief 验证成绩是否有效
@@ -115,6 +221,170 @@ namespace student_manager {
     }
   };
 
+  /**
+   * @brief 批量添加时每一行的结果
+   */
+  enum class AddStatus : std::uint8_t {
+    added,               ///< 添加成功
+    duplicate_existing,  ///< 学号与管理器中已有的学生重复
+    duplicate_in_batch,  ///< 学号与同一批次中更早的一行重复
+  };
+
+  /**
+   * @brief 批量修改成绩时每一行的结果
+   */
+  enum class UpdateStatus : std::uint8_t {
+    updated,    ///< 修改成功
+    not_found,  ///< 学号不存在
+  };
+
+  /**
+   * @brief 内存占用报告（字节）
+   */
+  struct MemoryUsage {
+    std::size_t students = 0;        ///< 学生人数
+    std::size_t records = 0;         ///< 学生列表本身（每人 sizeof(Student) 字节，包括预留的容量）
+    std::size_t strings = 0;         ///< 放不进 Student 内部的长姓名和长学号
+    std::size_t score_column = 0;    ///< 成绩列
+    std::size_t subject_scores = 0;  ///< 多科目成绩矩阵
+    std::size_t indexes = 0;         ///< 学号索引、句柄槽位、统计量、启用的可选索引和排序视图的缓存
+
+    [[nodiscard]] std::size_t total() const noexcept {
+      return records + strings + score_column + subject_scores + indexes;
+    }
+
+    /**
+     * @brief 平均每个学生占用的字节数，没有学生时为 0
+     */
+    [[nodiscard]] double bytes_per_student() const noexcept {
+      return students == 0 ? 0.0
+                           : static_cast<double>(total()) / static_cast<double>(students);
+    }
+  };
+
+  /**
+   * @brief 按某种顺序排列的学生（只读视图）
+   *
+   * 视图只引用管理器中的学生和缓存的行排列，不复制任何学生。
+   * 添加、删除学生或修改成绩之后视图失效，需要重新调用 StudentManager::sorted_by()。
+   */
+  class SortedView {
+  public:
+    /**
+     * @brief 随机访问迭代器，解引用得到学生
+     */
+    class const_iterator {
+    public:
+      using iterator_category = std::random_access_iterator_tag;
+      using value_type = Student;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const Student*;
+      using reference = const Student&;
+
+      const_iterator() = default;
+      const_iterator(const Student* students, const std::uint32_t* row) noexcept
+          : students_(students), row_(row) {}
+
+      reference operator*() const noexcept { return students_[*row_]; }
+      pointer operator->() const noexcept { return &students_[*row_]; }
+      reference operator[](difference_type n) const noexcept { return students_[row_[n]]; }
+
+      const_iterator& operator++() noexcept {
+        ++row_;
+        return *this;
+      }
+      const_iterator operator++(int) noexcept { return const_iterator(students_, row_++); }
+      const_iterator& operator--() noexcept {
+        --row_;
+        return *this;
+      }
+      const_iterator operator--(int) noexcept { return const_iterator(students_, row_--); }
+      const_iterator& operator+=(difference_type n) noexcept {
+        row_ += n;
+        return *this;
+      }
+      const_iterator& operator-=(difference_type n) noexcept {
+        row_ -= n;
+        return *this;
+      }
+      friend const_iterator operator+(const_iterator it, difference_type n) noexcept {
+        return it += n;
+      }
+      friend const_iterator operator-(const_iterator it, difference_type n) noexcept {
+        return it -= n;
+      }
+      friend difference_type operator-(const_iterator a, const_iterator b) noexcept {
+        return a.row_ - b.row_;
+      }
+      friend bool operator==(const_iterator a, const_iterator b) noexcept {
+        return a.row_ == b.row_;
+      }
+      friend bool operator!=(const_iterator a, const_iterator b) noexcept {
+        return a.row_ != b.row_;
+      }
+      friend bool operator<(const_iterator a, const_iterator b) noexcept {
+        return a.row_ < b.row_;
+      }
+
+    private:
+      const Student* students_ = nullptr;
+      const std::uint32_t* row_ = nullptr;
+    };
+
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    SortedView(const std::vector<Student>& students,
+               const std::vector<std::uint32_t>& rows) noexcept
+        : students_(students.data()), rows_(&rows) {}
+
+    [[nodiscard]] std::size_t size() const noexcept { return rows_->size(); }
+    [[nodiscard]] bool empty() const noexcept { return rows_->empty(); }
+
+    /**
+     * @brief 排在第 i 位的学生（i 从 0 开始）
+     */
+    [[nodiscard]] const Student& operator[](std::size_t i) const noexcept {
+      return students_[(*rows_)[i]];
+    }
+
+    [[nodiscard]] const Student& front() const noexcept { return (*this)[0]; }
+    [[nodiscard]] const Student& back() const noexcept { return (*this)[size() - 1]; }
+
+    /**
+     * @brief 行排列：第 i 位的学生是 get_all_students()[rows()[i]]
+     */
+    [[nodiscard]] const std::vector<std::uint32_t>& rows() const noexcept { return *rows_; }
+
+    [[nodiscard]] const_iterator begin() const noexcept {
+      return const_iterator(students_, rows_->data());
+    }
+    [[nodiscard]] const_iterator end() const noexcept {
+      return const_iterator(students_, rows_->data() + rows_->size());
+    }
+
+    /**
+     * @brief 倒序遍历（如成绩从高到低）
+     */
+    [[nodiscard]] const_reverse_iterator rbegin() const noexcept {
+      return const_reverse_iterator(end());
+    }
+    [[nodiscard]] const_reverse_iterator rend() const noexcept {
+      return const_reverse_iterator(begin());
+    }
+
+  private:
+    const Student* students_;
+    const std::vector<std::uint32_t>* rows_;
+  };
+
+  namespace detail {
+    /// 判断一个范围是否能用 std::size 获取元素个数
+    template <typename Range, typename = void> struct has_size : std::false_type {};
+    template <typename Range>
+    struct has_size<Range, std::void_t<decltype(std::size(std::declval<Range&>()))>>
+        : std::true_type {};
+  }  // namespace detail
+
   /**
    * @brief 学生管理类
    *
@@ -124,13 +394,141 @@ namespace student_manager {
    * 设计说明：
    * - 使用 std::vector<Student> 存储数据，支持动态增减
    * - 使用 std::optional 返回查找结果，更安全地处理"未找到"情况
-   * - 内部使用 std::find_if 算法，代码更简洁
+   * - 使用学号哈希索引（IdIndex）查找学生，添加/查找/删除平均 O(1)
+   * - 纯数字学号另外压缩成 64 位键（IdKey）按列存放，查找时只做整数比较
+   * - 删除时把最后一个学生移到被删除的位置（swap-and-pop），避免整体移动元素
+   * - 通过槽位表（SlotTable）提供带代数校验的句柄，句柄不受元素移动影响
+   * - 成绩另外按列连续存放（get_scores()），与学生列表一一对应，便于向量化统计
+   * - 可以增加任意多个科目（ScoreMatrix），每个科目一列成绩，不重复保存姓名和学号
+   * - 可选的排名索引（RankIndex）支持 O(log n) 的排名查询
+   * - 可选的成绩直方图（ScoreHistogram）支持 O(log B) 的分数段统计
+   * - 可选的姓名索引（NameIndex）支持按姓名精确、前缀和包含查找
+   * - 排序视图（SortedIndex）缓存按学号、成绩、姓名排好的顺序，修改后按需增量修补
+   * - 可选的日志模式（Journal）把每次修改追加到预写日志，崩溃后从快照和日志恢复
+   * - 可选的只读快照（ReadSnapshot）让其他线程不加锁地读取某一时刻的全部数据
+   * - 编译时可以开启性能统计（MetricsRecorder），记录每个操作的调用次数和耗时分布
    */
   class StudentManager {
   private:
-    std::vector<Student> students_;  ///< 学生列表
+    std::vector<Student> students_;            ///< 学生列表
+    IdIndex id_index_;                         ///< 学号 -> students_ 下标 的哈希索引
+    std::vector<std::uint64_t> id_keys_;       ///< 学号键列：id_keys_[i] 是 students_[i] 的压缩学号
+    SlotTable slots_;                          ///< 句柄槽位 -> students_ 下标
+    std::vector<std::uint32_t> row_slots_;     ///< students_ 下标 -> 句柄槽位
+    std::vector<double> scores_;               ///< 成绩列：scores_[i] == students_[i].get_score()
+    ScoreAggregates aggregates_;               ///< 增量维护的成绩统计量
+    ScoreMatrix subject_scores_;               ///< 多科目成绩，按列存放，行与 students_ 对应
+    std::optional<RankIndex> rank_index_;      ///< 排名索引（可选），按句柄槽位记录成绩
+    std::optional<ScoreHistogram> histogram_;  ///< 成绩直方图（可选）
+    std::optional<NameIndex> name_index_;      ///< 姓名索引（可选），按句柄槽位记录姓名
+    mutable std::array<SortedIndex, kSortKeyCount> sorted_indexes_;  ///< 排序视图的缓存
+    mutable std::mutex sorted_mutex_;  ///< 保护 sorted_indexes_，使 const 调用可以同时进行；不随对象复制
+    StringArena string_arena_;                 ///< 存放长姓名和长学号的字符串区
+    std::size_t arena_garbage_ = 0;            ///< 字符串区中被删除学生留下的字节数
+    std::unique_ptr<Journal> journal_;         ///< 预写日志，只在日志模式下存在
+    std::optional<ReadSnapshotPublisher> read_publisher_;  ///< 只读快照的发布者（可选）
+#if STUDENT_MANAGER_METRICS
+    std::unique_ptr<MetricsRecorder> metrics_ = std::make_unique<MetricsRecorder>();  ///< 性能统计
+#endif
+
+    friend class Student;
+
+    /// 让 students_[from, end) 中的学生记住所属的管理器（元素被移动后需要重新设置）
+    void adopt_rows(std::size_t from) noexcept;
+
+    /// 把 students_ 的容量扩大到至少 count，搬运期间暂时解除归属，让移动构造直接接管字符串
+    void reserve_rows(std::size_t count);
+
+    /// 学号索引使用的比较回调：纯数字学号只比较键列，不读取学生数据
+    [[nodiscard]] auto row_matcher() const noexcept {
+      return [this](const IdKey& key, std::uint32_t row) {
+        return key.matches(id_keys_[row], [&] { return students_[row].get_id(); });
+      };
+    }
+
+    /// 把 students_[row] 中单独分配在堆上的长字符串搬到字符串区
+    void pack_strings(std::size_t row);
+
+    /// 字符串区中的空洞过多时，把仍在使用的字符串搬到新的字符串区中
+    void compact_strings();
+
+    /// 用当前成绩列建立一个直方图
+    [[nodiscard]] ScoreHistogram build_histogram() const;
+
+    /// 由 Student 的赋值运算符调用：把管理器中的 student 替换为 value 的姓名、学号和成绩
+    void replace_student(Student& student, const Student& value);
+
+    /// 由 Student::set_score 调用：学生的成绩已从 old_score 改为当前值
+    void on_score_changed(const Student& student, double old_score);
+
+    /// 在 students_ 中查找学号对应的下标，未找到返回 IdIndex::npos
+    [[nodiscard]] std::uint32_t find_row(std::string_view student_id) const;
+
+    /// 把学生追加到列表末尾并建立索引（调用者需保证学号不重复），返回新句柄
+    StudentHandle append_row(Student&& student);
+
+    /// 删除指定下标的学生（swap-and-pop），同步更新索引和槽位表
+    void erase_row(std::uint32_t row);
+
+    /// 日志超过压缩阈值时在后台压缩（只在日志模式下调用）
+    void maybe_compact_journal();
+
+    /// 回放时把一条日志记录应用到当前数据（此时还没有打开日志，不会再次记录）
+    void apply_journal_record(const JournalRecord& record);
+
+    /// 记录一次修改，达到发布间隔时发布新的只读快照（只在启用只读快照时调用）
+    void count_read_change();
+
+    /// 批量查找：依次查找每个学号的行号（未找到为 IdIndex::npos），提前预取后面学号的槽位和行
+    [[nodiscard]] std::vector<std::uint32_t> find_rows(const std::vector<IdKey>& keys) const;
+
+    /// 批量修改：把 scores[i] 写入 rows[i] 行，提前预取后面的行
+    std::vector<UpdateStatus> update_rows(const std::vector<std::uint32_t>& rows,
+                                          const std::vector<double>& scores);
+
+    /// 学号对应的行号和科目编号都有效时返回行号，否则返回 IdIndex::npos
+    [[nodiscard]] std::uint32_t subject_row(std::string_view student_id,
+                                            std::size_t subject) const;
+
+    /// 排序视图使用的比较函数（都是全序：学号各不相同，其余依据相同时按学号）
+    [[nodiscard]] bool id_less(std::uint32_t a, std::uint32_t b) const noexcept;
+    [[nodiscard]] bool score_less(std::uint32_t a, std::uint32_t b) const noexcept;
+    [[nodiscard]] bool name_less(std::uint32_t a, std::uint32_t b) const noexcept;
+
+    /// 在 sorted_mutex_ 保护下复制排序视图的缓存（拷贝构造时 other 可能正被其他线程读取）
+    [[nodiscard]] std::array<SortedIndex, kSortKeyCount> copy_sorted_indexes() const;
+
+    /// 学生被添加、删除时通知所有排序索引
+    void mark_sorted(std::uint32_t slot) {
+      for (SortedIndex& index : sorted_indexes_) {
+        index.mark(slot);
+      }
+    }
+
+    /// 把槽位列表换成学生引用，按行号排列
+    [[nodiscard]] std::vector<std::reference_wrapper<const Student>> rows_of_slots(
+        const std::vector<std::uint32_t>& slots) const;
+
+    /// 用已打开的快照替换当前数据，保留各个可选索引和只读快照的启用状态
+    [[nodiscard]] SnapshotStatus load_from(const SnapshotView& view);
+
+    /// 批量添加中的一行：batch_begin 是本批次第一行的下标，用于区分两种重复
+    AddStatus add_batch_row(const Student& student, std::size_t batch_begin);
+    AddStatus add_batch_row(Student&& student, std::size_t batch_begin);
 
   public:
+    // ==================== 构造与赋值 ====================
+    // 学生会记住所属管理器的地址，因此拷贝和移动管理器时需要重新设置这个地址。
+    // 日志只属于一个对象：拷贝出来的管理器没有日志；移动时日志随数据一起转移；
+    // 赋值会关闭左侧对象原有的日志（它的数据被整体替换，日志已经无法与之对应）
+
+    StudentManager() = default;
+    StudentManager(const StudentManager& other);
+    StudentManager(StudentManager&& other) noexcept;
+    StudentManager& operator=(const StudentManager& other);
+    StudentManager& operator=(StudentManager&& other) noexcept;
+    ~StudentManager() = default;
+
     // ==================== 类型别名 ====================
     using value_type = Student;
     using size_type = std::vector<Student>::size_type;
@@ -171,7 +569,7 @@ namespace student_manager {
      * @param student 要添加的学生对象
      * @return 添加成功返回 true，学号已存在返回 false
      *
-     * @note 时间复杂度: O(n)，需要检查学号是否重复
+     * @note 时间复杂度: 平均 O(1)，通过哈希索引检查学号是否重复
      */
     bool add_student(const Student& student);
 
@@ -184,15 +582,80 @@ namespace student_manager {
      */
     bool add_student(Student&& student);
 
+    /**
+     * @brief 添加学生并返回句柄
+     * @param student 要添加的学生对象
+     * @return 添加成功返回新学生的句柄，学号已存在返回 std::nullopt
+     *
+     * @note 与 add_student 相同，适合需要长期持有学生引用的场景
+     */
+    std::optional<StudentHandle> insert_student(Student student);
+
+    /**
+     * @brief 批量添加学生
+     * @param students 任意可遍历的学生范围（如 std::vector<Student>），传入右值时会移动元素
+     * @return 与输入顺序一一对应的结果，说明每一行是否被添加以及被拒绝的原因
+     *
+     * @note 能获取元素个数的范围会先调用 reserve() 一次性分配空间，避免反复扩容
+     * @note 重复检测通过学号哈希索引一次遍历完成：同时检查已有数据和本批次中更早的行，
+     *       整体时间复杂度平均 O(k)，k 为本批次的行数
+     *
+     * @example
+     * @code
+     * std::vector<Student> roster = load_roster();
+     * auto results = manager.add_students(std::move(roster));
+     * @endcode
+     */
+    template <typename Range> std::vector<AddStatus> add_students(Range&& students) {
+      STUDENT_MANAGER_TIME_OPERATION(add_students);
+      std::vector<AddStatus> results;
+      if constexpr (detail::has_size<Range>::value) {
+        auto count = static_cast<std::size_t>(std::size(students));
+        // 连续多次批量添加时按倍数扩容，避免每批都重新分配并搬动全部已有数据
+        std::size_t needed = students_.size() + count;
+        if (needed > students_.capacity()) {
+          reserve(std::max(needed, students_.capacity() * 2));
+        }
+        results.reserve(count);
+      }
+      std::size_t batch_begin = students_.size();
+      for (auto&& student : students) {
+        if constexpr (std::is_lvalue_reference_v<Range>) {
+          results.push_back(add_batch_row(static_cast<const Student&>(student), batch_begin));
+        } else {
+          results.push_back(add_batch_row(std::move(student), batch_begin));
+        }
+      }
+      return results;
+    }
+
+    /**
+     * @brief 预留能容纳 count 个学生的空间（包括学生列表和各个索引）
+     * @param count 预计的学生总数
+     *
+     * @note 已知数据规模时提前调用，可以避免添加过程中反复扩容和重建哈希表
+     */
+    void reserve(size_type count);
+
     /**
      * @brief 根据学号删除学生
      * @param student_id 要删除的学生学号
      * @return 删除成功返回 true，学号不存在返回 false
      *
-     * @note 时间复杂度: O(n)
+     * @note 时间复杂度: 平均 O(1)
+     * @note 删除后最后一个学生会被移到被删除学生的位置，因此学生列表的顺序可能改变
      */
     bool remove_student(std::string_view student_id);
 
+    /**
+     * @brief 根据句柄删除学生
+     * @param handle 学生句柄
+     * @return 删除成功返回 true，句柄无效返回 false
+     *
+     * @note 时间复杂度: O(1)
+     */
+    bool remove_student(StudentHandle handle);
+
     /**
      * @brief 根据学号查找学生
      * @param student_id 要查找的学生学号
@@ -200,6 +663,8 @@ namespace student_manager {
      *
      * @note 返回引用允许调用者修改找到的学生信息
      * @note 使用 std::optional 比 return nullptr 更清晰地表达"可能没有结果"
+     * @note 时间复杂度: 平均 O(1)
+     * @warning 添加或删除学生后，之前返回的引用可能失效；需要长期持有时请使用 get_handle()
      *
      * @example
      * @code
@@ -219,30 +684,741 @@ namespace student_manager {
     [[nodiscard]] std::optional<std::reference_wrapper<const Student>> find_student(
         std::string_view student_id) const;
 
+    /**
+     * @brief 批量查找学生
+     * @param student_ids 任意可遍历的学号范围，元素能转换为 std::string_view
+     *                    （如 std::vector<std::string>、std::vector<std::string_view>）
+     * @return 与输入顺序一一对应的结果，未找到的学号对应 std::nullopt
+     *
+     * @note 先为所有学号计算压缩键和哈希值，再在一个流水线循环中查找：查找第 i 个学号时，
+     *       已经预取了后面学号的哈希槽位和学生数据，多次随机内存访问可以重叠进行。
+     *       学号较多时吞吐量比逐个调用 find_student() 高数倍
+     * @warning 添加或删除学生后，返回的引用可能失效
+     *
+     * @example
+     * @code
+     * std::vector<std::string_view> ids = {"2023001", "2023002", "9999999"};
+     * auto found = manager.find_students(ids);  // found[2] 为 std::nullopt
+     * @endcode
+     */
+    template <typename Range>
+    [[nodiscard]] std::vector<std::optional<std::reference_wrapper<const Student>>> find_students(
+        const Range& student_ids) const {
+      STUDENT_MANAGER_TIME_OPERATION(find_students);
+      std::vector<IdKey> keys;
+      if constexpr (detail::has_size<const Range>::value) {
+        keys.reserve(static_cast<std::size_t>(std::size(student_ids)));
+      }
+      for (const auto& id : student_ids) {
+        keys.emplace_back(std::string_view(id));
+      }
+      std::vector<std::uint32_t> rows = find_rows(keys);
+      std::vector<std::optional<std::reference_wrapper<const Student>>> result;
+      result.reserve(rows.size());
+      for (std::uint32_t row : rows) {
+        if (row == IdIndex::npos) {
+          result.emplace_back(std::nullopt);
+        } else {
+          result.emplace_back(std::cref(students_[row]));
+        }
+      }
+      return result;
+    }
+
+    // ==================== 句柄访问 ====================
+
+    /**
+     * @brief 获取学号对应学生的句柄
+     * @param student_id 学号
+     * @return 找到返回句柄，未找到返回 std::nullopt
+     *
+     * @note 与 find_student 返回的引用不同，句柄在其他学生被添加或删除后仍然有效
+     *
+     * @example
+     * @code
+     * auto handle = manager.get_handle("001");
+     * manager.add_student(Student("新同学", "002", 80.0));  // 可能导致扩容
+     * if (auto student = manager.get_student(*handle)) {     // 句柄依然有效
+     *     student->get().set_score(95.0);
+     * }
+     * @endcode
+     */
+    [[nodiscard]] std::optional<StudentHandle> get_handle(std::string_view student_id) const;
+
+    /**
+     * @brief 检查句柄是否仍然有效
+     * @return 句柄指向的学生仍存在返回 true
+     */
+    [[nodiscard]] bool contains(StudentHandle handle) const noexcept {
+      return slots_.row_of(handle) != SlotTable::npos;
+    }
+
+    /**
+     * @brief 根据句柄获取学生
+     * @param handle 学生句柄
+     * @return 句柄有效返回学生引用，否则返回 std::nullopt
+     *
+     * @note 时间复杂度: O(1)，过期句柄会被安全地拒绝而不会访问到其他学生
+     */
+    [[nodiscard]] std::optional<std::reference_wrapper<Student>> get_student(
+        StudentHandle handle) noexcept;
+
+    /**
+     * @brief 根据句柄获取学生（const 版本）
+     */
+    [[nodiscard]] std::optional<std::reference_wrapper<const Student>> get_student(
+        StudentHandle handle) const noexcept;
+
+    // ==================== 修改成绩 ====================
+
+    /**
+     * @brief 修改学生成绩
+     * @param student_id 学号
+     * @param new_score 新成绩（调用者需确保在 0-100 范围内）
+     * @return 修改成功返回 true，学号不存在返回 false
+     *
+     * @note 与 find_student(...)->get().set_score(...) 效果相同，统计量会同步更新
+     */
+    bool update_score(std::string_view student_id, double new_score);
+
+    /**
+     * @brief 根据句柄修改学生成绩
+     * @return 修改成功返回 true，句柄无效返回 false
+     */
+    bool update_score(StudentHandle handle, double new_score);
+
+    /**
+     * @brief 批量修改成绩
+     * @param updates 任意可遍历的 (学号, 新成绩) 范围，
+     *                例如 std::vector<std::pair<std::string, double>>
+     * @return 与输入顺序一一对应的结果
+     *
+     * @note 按输入顺序依次修改，同一个学号出现多次时以最后一次为准。
+     *       与 find_students() 一样先批量查找再修改，修改时预取后面要修改的学生
+     *
+     * @example
+     * @code
+     * std::vector<std::pair<std::string_view, double>> grades = {{"2023001", 95.0},
+     *                                                            {"2023002", 88.5}};
+     * auto results = manager.update_scores(grades);
+     * @endcode
+     */
+    template <typename Range> std::vector<UpdateStatus> update_scores(const Range& updates) {
+      STUDENT_MANAGER_TIME_OPERATION(update_scores);
+      std::vector<IdKey> keys;
+      std::vector<double> scores;
+      if constexpr (detail::has_size<const Range>::value) {
+        keys.reserve(static_cast<std::size_t>(std::size(updates)));
+        scores.reserve(keys.capacity());
+      }
+      for (const auto& [id, score] : updates) {
+        keys.emplace_back(std::string_view(id));
+        scores.push_back(static_cast<double>(score));
+      }
+      return update_rows(find_rows(keys), scores);
+    }
+
     // ==================== 统计功能 ====================
+    // 统计量在添加、删除和修改成绩时增量更新，查询不需要遍历学生列表
 
     /**
      * @brief 计算所有学生的平均成绩
      * @return 平均成绩，如果没有学生返回 0.0
      *
-     * @note 时间复杂度: O(n)
+     * @note 时间复杂度: O(1)
      */
-    [[nodiscard]] double calculate_average_score() const noexcept;
+    [[nodiscard]] double calculate_average_score() const noexcept {
+      return aggregates_.average();
+    }
+
+    /**
+     * @brief 计算所有学生的总分
+     * @return 总分（补偿求和），如果没有学生返回 0.0
+     *
+     * @note 时间复杂度: O(1)；合并多个管理器的平均分时使用
+     */
+    [[nodiscard]] double get_total_score() const noexcept { return aggregates_.sum(); }
 
     /**
      * @brief 获取最高分
      * @return 最高分，如果没有学生返回 std::nullopt
+     *
+     * @note 时间复杂度: O(1)
      */
-    [[nodiscard]] std::optional<double> get_max_score() const noexcept;
+    [[nodiscard]] std::optional<double> get_max_score() const noexcept {
+      return aggregates_.max();
+    }
 
     /**
      * @brief 获取最低分
      * @return 最低分，如果没有学生返回 std::nullopt
+     *
+     * @note 时间复杂度: O(1)
+     */
+    [[nodiscard]] std::optional<double> get_min_score() const noexcept {
+      return aggregates_.min();
+    }
+
+    /**
+     * @brief 计算完整的成绩统计报告
+     * @return 平均分、方差、标准差、最高/最低分、四分位数和第 90 百分位数
+     *
+     * @param options 并行选项，默认在成绩较多时使用全部核心（结果与串行计算逐位一致）
+     *
+     * @note 只遍历一次成绩列；平均分和方差使用数值稳定的分块合并算法，
+     *       百分位数使用选择算法而不是完整排序，时间复杂度平均 O(n)
+     *
+     * @example
+     * @code
+     * auto stats = manager.compute_statistics();
+     * std::cout << "中位数: " << stats.median << " 标准差: " << stats.stddev << "\n";
+     * @endcode
+     */
+    [[nodiscard]] ScoreStatistics compute_statistics(const ParallelOptions& options = {}) const {
+      STUDENT_MANAGER_TIME_OPERATION(compute_statistics);
+      return compute_score_statistics(scores_.data(), scores_.size(), options);
+    }
+
+    // ==================== 条件查询 ====================
+    // 遍历全部学生；学生较多时分块并行执行（见 parallel.h），结果与串行执行相同。
+    // 条件函数可能在多个线程中同时调用，不能修改共享状态。
+
+    /**
+     * @brief 统计满足条件的学生人数
+     * @param predicate 以 const Student& 为参数、返回 bool 的函数
+     * @param options 并行选项
+     *
+     * @example
+     * @code
+     * auto failed = manager.count_students_if(
+     *     [](const Student& student) { return student.get_score() < 60.0; });
+     * @endcode
+     */
+    template <typename Predicate>
+    [[nodiscard]] size_type count_students_if(Predicate&& predicate,
+                                              const ParallelOptions& options = {}) const {
+      STUDENT_MANAGER_TIME_OPERATION(scan);
+      return parallel::count_if(students_.size(), options,
+                                [&](std::size_t row) { return predicate(students_[row]); });
+    }
+
+    /**
+     * @brief 列出满足条件的学生，顺序与 get_all_students() 相同
+     * @param predicate 以 const Student& 为参数、返回 bool 的函数
+     * @param options 并行选项
+     * @warning 添加或删除学生后，返回的引用可能失效
+     */
+    template <typename Predicate>
+    [[nodiscard]] std::vector<std::reference_wrapper<const Student>> find_students_if(
+        Predicate&& predicate, const ParallelOptions& options = {}) const {
+      STUDENT_MANAGER_TIME_OPERATION(scan);
+      auto rows = parallel::find_if(students_.size(), options,
+                                    [&](std::size_t row) { return predicate(students_[row]); });
+      std::vector<std::reference_wrapper<const Student>> result;
+      result.reserve(rows.size());
+      for (std::size_t row : rows) {
+        result.push_back(std::cref(students_[row]));
+      }
+      return result;
+    }
+
+    // ==================== 排名 ====================
+    // 启用排名索引后，以下查询都是 O(log n)（top_k/bottom_k 为 O(log n + k)）；
+    // 未启用时退化为遍历成绩列，结果相同，只是更慢。
+    // 排名采用"并列同名次"规则：两个学生同分时名次相同，下一名次顺延（1, 2, 2, 4）。
+
+    /**
+     * @brief 启用排名索引，并用当前数据建立索引
+     *
+     * @note 时间复杂度: O(n log n)；之后的添加、删除和改分都会自动更新索引
+     */
+    void enable_ranking_index();
+
+    /**
+     * @brief 停用排名索引并释放其内存
+     */
+    void disable_ranking_index() noexcept { rank_index_.reset(); }
+
+    /**
+     * @brief 排名索引是否已启用
+     */
+    [[nodiscard]] bool has_ranking_index() const noexcept { return rank_index_.has_value(); }
+
+    /**
+     * @brief 查询学生的名次
+     * @param student_id 学号
+     * @return 名次（从 1 开始，成绩最高为第 1 名），学号不存在返回 std::nullopt
      */
-    [[nodiscard]] std::optional<double> get_min_score() const noexcept;
+    [[nodiscard]] std::optional<size_type> rank_of(std::string_view student_id) const;
+
+    /**
+     * @brief 获取第 k 高的成绩
+     * @param k 名次（从 1 开始）
+     * @return 第 k 高的成绩，k 为 0 或超过学生人数时返回 std::nullopt
+     */
+    [[nodiscard]] std::optional<double> kth_score(size_type k) const;
+
+    /**
+     * @brief 获取成绩最高的 k 个学生（从高到低）
+     * @param k 人数，超过学生总数时返回全部学生
+     * @return 学生引用列表；同分学生之间的顺序不确定
+     * @warning 添加或删除学生后，返回的引用可能失效
+     */
+    [[nodiscard]] std::vector<std::reference_wrapper<const Student>> top_k(size_type k) const;
+
+    /**
+     * @brief 获取成绩最低的 k 个学生（从低到高）
+     * @param k 人数，超过学生总数时返回全部学生
+     * @return 学生引用列表；同分学生之间的顺序不确定
+     * @warning 添加或删除学生后，返回的引用可能失效
+     */
+    [[nodiscard]] std::vector<std::reference_wrapper<const Student>> bottom_k(size_type k) const;
+
+    // ==================== 分数段统计 ====================
+    // 启用成绩直方图后，以下查询都是 O(log B)（B = 10001 个 0.01 分的桶），与学生人数无关；
+    // 未启用时先遍历成绩列临时建立直方图，结果相同，只是 O(n)。
+    // 成绩按 0.01 分归入桶中，对于最多两位小数的成绩，结果是精确的。
+
+    /**
+     * @brief 启用成绩直方图，并用当前数据建立直方图
+     *
+     * @note 时间复杂度: O(n log B)；之后的添加、删除和改分都会自动更新直方图
+     */
+    void enable_score_histogram();
+
+    /**
+     * @brief 停用成绩直方图并释放其内存（约 40 KB）
+     */
+    void disable_score_histogram() noexcept { histogram_.reset(); }
+
+    /**
+     * @brief 成绩直方图是否已启用
+     */
+    [[nodiscard]] bool has_score_histogram() const noexcept { return histogram_.has_value(); }
+
+    /**
+     * @brief 统计成绩在 [low, high] 之间的人数（两端都包含）
+     *
+     * @example
+     * @code
+     * manager.enable_score_histogram();
+     * auto passed = manager.count_in_range(60.0, 100.0);
+     * @endcode
+     */
+    [[nodiscard]] size_type count_in_range(double low, double high) const;
+
+    /**
+     * @brief 按分数段统计人数
+     * @param boundaries 严格递增的分数段边界，例如 {0, 60, 70, 80, 90, 100}
+     * @return 每个分数段 [b(i), b(i+1)) 的人数，最后一段包含上边界
+     */
+    [[nodiscard]] std::vector<size_type> grade_distribution(
+        const std::vector<double>& boundaries) const;
+
+    /**
+     * @brief 近似百分位数（最近秩法，精确到 0.01 分）
+     * @param percentile 0-100 之间的百分位
+     * @return 至少有 percentile% 的学生成绩不高于该值；没有成绩时返回 std::nullopt
+     *
+     * @note 结果是某个学生的成绩所在的 0.01 分桶的下边界，与该学生的实际成绩相差不到 0.01
+     *       （例如 85.555 返回 85.55）；不像 compute_statistics() 那样在相邻成绩之间插值
+     */
+    [[nodiscard]] std::optional<double> approximate_percentile(double percentile) const;
+
+    // ==================== 按姓名查找 ====================
+    // 姓名可以重复，因此都返回学生列表。启用姓名索引后，精确和前缀查找为 O(log n + k)，
+    // 包含查找只确认含有查询串中最少见字符的候选者；未启用时退化为遍历学生列表，结果相同。
+    // 返回的引用在添加或删除学生后可能失效。
+
+    /**
+     * @brief 启用姓名索引，并用当前数据建立索引
+     *
+     * @note 时间复杂度: O(n log n)；之后的添加和删除都会自动更新索引
+     */
+    void enable_name_index();
+
+    /**
+     * @brief 停用姓名索引并释放其内存
+     */
+    void disable_name_index() noexcept { name_index_.reset(); }
+
+    /**
+     * @brief 姓名索引是否已启用
+     */
+    [[nodiscard]] bool has_name_index() const noexcept { return name_index_.has_value(); }
+
+    /**
+     * @brief 查找姓名恰好为 name 的所有学生（按在学生列表中的顺序）
+     *
+     * @example
+     * @code
+     * manager.enable_name_index();
+     * for (const Student& student : manager.find_students_by_name("张三")) {
+     *   std::cout << student.get_id() << "\n";
+     * }
+     * @endcode
+     */
+    [[nodiscard]] std::vector<std::reference_wrapper<const Student>> find_students_by_name(
+        std::string_view name) const;
+
+    /**
+     * @brief 查找姓名以 prefix 开头的学生（按姓名的 UTF-8 字节序排列）
+     * @param prefix 前缀，例如姓氏 "张"；末尾不完整的 UTF-8 字符会被忽略
+     * @param limit 最多返回的人数，适合输入时的自动补全
+     * @note 同名学生之间的顺序不确定
+     */
+    [[nodiscard]] std::vector<std::reference_wrapper<const Student>> find_students_by_name_prefix(
+        std::string_view prefix,
+        size_type limit = std::numeric_limits<size_type>::max()) const;
+
+    /**
+     * @brief 查找姓名中包含 text 的学生（按在学生列表中的顺序）
+     */
+    [[nodiscard]] std::vector<std::reference_wrapper<const Student>>
+    find_students_by_name_substring(std::string_view text) const;
+
+    // ==================== 多科目成绩 ====================
+    // 除了 get_score() 这一个成绩之外，每个学生还可以有多个科目的成绩。
+    // 科目成绩按科目分列存放（见 score_matrix.h），没有录入的成绩不参与统计。
+    // 科目的定义和成绩都只保存在内存中：快照、日志和 CSV 只包含 get_score()；
+    // 加载快照或打开日志后保留科目的定义，但所有科目成绩都被清空。
+    // 科目成绩无法在崩溃后恢复，因此日志模式下 set_subject_score() 和
+    // clear_subject_score() 直接返回 false，不会修改任何成绩。
+
+    /**
+     * @brief 增加一个科目
+     * @param name 科目名称
+     * @param credits 学分，计算 GPA 时作为权重
+     * @param storage 成绩的存放方式；ScoreStorage::hundredths 把成绩四舍五入到 0.01 分、
+     *        每个只占 2 字节，平均分和统计用整数精确计算（读写接口仍然是 double）
+     * @return 新科目的编号；名称已存在或学分不大于 0 时返回 std::nullopt
+     *
+     * @example
+     * @code
+     * auto math = *manager.add_subject("高等数学", 5.0);
+     * auto english = *manager.add_subject("大学英语", 3.0);
+     * manager.set_subject_score("2023001", math, 92.0);
+     * manager.set_subject_score("2023001", english, 78.5);
+     * std::cout << *manager.subject_average(math) << " " << *manager.student_gpa("2023001");
+     * @endcode
+     */
+    std::optional<std::size_t> add_subject(std::string_view name, double credits = 1.0,
+                                           ScoreStorage storage = ScoreStorage::binary64);
+
+    /**
+     * @brief 删除一个科目及其全部成绩，后面的科目编号依次减 1
+     * @return 科目不存在时返回 false
+     */
+    bool remove_subject(std::string_view name);
+
+    /**
+     * @brief 科目数
+     */
+    [[nodiscard]] std::size_t subject_count() const noexcept {
+      return subject_scores_.subject_count();
+    }
+
+    /**
+     * @brief 按名称查找科目编号
+     */
+    [[nodiscard]] std::optional<std::size_t> find_subject(std::string_view name) const noexcept {
+      std::size_t subject = subject_scores_.find_subject(name);
+      return subject == ScoreMatrix::npos ? std::nullopt : std::optional<std::size_t>(subject);
+    }
+
+    /**
+     * @brief 录入或修改某个学生某个科目的成绩
+     * @return 学号或科目不存在、成绩不在 0-100 之间，或处于日志模式（科目成绩不写入日志）
+     *         时返回 false
+     * @note 时间复杂度: 平均 O(1)
+     */
+    bool set_subject_score(std::string_view student_id, std::size_t subject, double score);
+
+    /**
+     * @brief 删除某个学生某个科目的成绩
+     * @return 学号或科目不存在、本来就没有成绩，或处于日志模式时返回 false
+     */
+    bool clear_subject_score(std::string_view student_id, std::size_t subject);
+
+    /**
+     * @brief 某个学生某个科目的成绩
+     * @return 学号或科目不存在、或没有成绩时返回 std::nullopt
+     */
+    [[nodiscard]] std::optional<double> get_subject_score(std::string_view student_id,
+                                                          std::size_t subject) const;
+
+    /**
+     * @brief 一个科目的平均分（只计算有成绩的学生）
+     * @return 科目不存在或没有任何成绩时返回 std::nullopt
+     * @note 时间复杂度: O(n)，整列交给向量化求和内核
+     */
+    [[nodiscard]] std::optional<double> subject_average(std::size_t subject) const noexcept;
+
+    /**
+     * @brief 一个科目的完整统计（平均分、标准差、最高/最低分、四分位数等）
+     * @note 科目不存在时返回的 count 为 0；定点科目在计数表上计算，不使用 options
+     */
+    [[nodiscard]] ScoreStatistics compute_subject_statistics(
+        std::size_t subject, const ParallelOptions& options = {}) const;
+
+    /**
+     * @brief 一个学生所有科目成绩的平均分（不加权）
+     * @return 学号不存在或没有任何科目成绩时返回 std::nullopt
+     */
+    [[nodiscard]] std::optional<double> student_average(std::string_view student_id) const;
+
+    /**
+     * @brief 一个学生的 GPA（4.0 分制，按学分加权，公式见 score_matrix.h）
+     * @return 学号不存在或没有任何科目成绩时返回 std::nullopt
+     */
+    [[nodiscard]] std::optional<double> student_gpa(std::string_view student_id) const;
+
+    /**
+     * @brief 所有学生的 GPA，第 i 个元素对应 get_all_students()[i]
+     * @note 时间复杂度: O(n × 科目数)，按列顺序累加，比逐个调用 student_gpa() 快得多
+     */
+    [[nodiscard]] std::vector<std::optional<double>> compute_gpas() const;
+
+    /**
+     * @brief 直接访问成绩矩阵（例如把某个科目的整列成绩交给自己的向量化代码）
+     */
+    [[nodiscard]] const ScoreMatrix& get_subject_scores() const noexcept {
+      return subject_scores_;
+    }
+
+    // ==================== 排序视图 ====================
+    // 按某种顺序列出学生时不需要自己复制和排序学生列表：排好的顺序缓存在管理器中，
+    // 数据没有变化时再次取得视图不做任何计算；添加、删除学生或修改成绩后，
+    // 下一次取得视图时只修补受影响的学生，O(n + k log k)。
+
+    /**
+     * @brief 按 key 排列的学生（从低到高；倒序遍历用 rbegin() / rend()）
+     *
+     * @note 时间复杂度: 第一次 O(n log n)；之后数据没有变化时 O(1)，
+     *       修改了 k 个学生后 O(n + k log k)
+     * @note 线程安全: 与其他 const 方法一样，可以和其他线程的 const 调用同时进行；
+     *       更新内部缓存时持有管理器自己的互斥锁。返回的视图在下一次修改管理器之前有效
+     *
+     * @example
+     * @code
+     * auto ranking = manager.sorted_by(SortKey::score);
+     * for (auto it = ranking.rbegin(); it != ranking.rend(); ++it) {  // 从高到低
+     *   std::cout << it->get_name() << " " << it->get_score() << "\n";
+     * }
+     * @endcode
+     */
+    [[nodiscard]] SortedView sorted_by(SortKey key) const;
+
+    /**
+     * @brief 释放排序视图的缓存（下一次取得视图时重新排序）
+     */
+    void clear_sorted_views() noexcept {
+      for (SortedIndex& index : sorted_indexes_) {
+        index.reset();
+      }
+    }
+
+    // ==================== 快照 ====================
+
+    /**
+     * @brief 把所有学生保存为二进制快照（格式见 snapshot.h）
+     * @param path 文件路径，已存在的文件会被替换
+     * @return 成功返回 SnapshotStatus::ok
+     */
+    [[nodiscard]] SnapshotStatus save_snapshot(const std::string& path) const {
+      STUDENT_MANAGER_TIME_OPERATION(save_snapshot);
+      return write_snapshot(path, students_);
+    }
+
+    /**
+     * @brief 用快照中的学生替换当前的所有学生
+     * @param path 文件路径
+     * @return 成功返回 SnapshotStatus::ok；失败时管理器保持不变
+     *
+     * @note 会检查整个文件的校验和，然后重新建立各个索引，时间复杂度 O(n)。
+     *       只需要读取数据时，使用 SnapshotView 直接映射文件更快
+     * @note 快照中没有科目成绩：科目的定义保留，所有科目成绩被清空
+     *
+     * @example
+     * @code
+     * StudentManager manager;
+     * if (manager.load_snapshot("students.snap") != SnapshotStatus::ok) {
+     *   // 文件不存在或已损坏，从空的管理器开始
+     * }
+     * @endcode
+     */
+    [[nodiscard]] SnapshotStatus load_snapshot(const std::string& path);
+
+    // ==================== 日志模式 ====================
+    // 日志模式下，添加、删除、改分（包括通过 find_student(...)->get().set_score() 修改）和清空
+    // 都会追加到预写日志，成批同步到磁盘；崩溃后再次调用 open_journal() 即可恢复。
+    // 多科目成绩不写入日志，日志模式下不能录入或删除（见"多科目成绩"）。
+    // 文件格式和压缩流程见 journal.h。
+
+    /**
+     * @brief 进入日志模式：加载快照，回放日志，之后对学生的添加、删除、改分和清空都追加到日志
+     * @param snapshot_path 快照文件；不存在时从空数据开始
+     * @param journal_path 日志文件；不存在时新建
+     * @return 成功返回 SnapshotStatus::ok；失败时管理器保持不变
+     *
+     * @note 当前数据会被快照和日志中的数据替换，科目成绩被清空（科目的定义保留）。
+     *       已经处于日志模式时，先把原来的日志（包括还没写入文件的记录）同步到磁盘，
+     *       新日志打开成功后才关闭原来的日志
+     *
+     * @example
+     * @code
+     * StudentManager manager;
+     * if (manager.open_journal("students.snap", "students.journal") != SnapshotStatus::ok) {
+     *   return 1;
+     * }
+     * manager.update_score("2023001", 95.0);  // 最多 group_commit_delay 之后落盘
+     * if (manager.sync_journal() != SnapshotStatus::ok) {
+     *   // 写入日志失败
+     * }
+     * @endcode
+     */
+    [[nodiscard]] SnapshotStatus open_journal(const std::string& snapshot_path,
+                                              const std::string& journal_path,
+                                              const JournalOptions& options = {});
+
+    /**
+     * @brief 同步剩余的记录，等待后台压缩完成，然后退出日志模式
+     * @return 同步或压缩失败时返回相应的错误，否则返回 ok
+     */
+    SnapshotStatus close_journal();
+
+    /**
+     * @brief 是否处于日志模式
+     */
+    [[nodiscard]] bool has_journal() const noexcept { return journal_ != nullptr; }
+
+    /**
+     * @brief 立即把已记录的修改同步到磁盘
+     * @return 成功（或不在日志模式）返回 ok；写入失败返回 io_error
+     */
+    [[nodiscard]] SnapshotStatus sync_journal();
+
+    /**
+     * @brief 同步压缩：把当前数据写成新快照，然后清空日志
+     * @return 不在日志模式时返回 io_error
+     * @note 时间复杂度 O(n)，期间不能修改数据；一般使用 compact_journal() 在后台压缩
+     */
+    [[nodiscard]] SnapshotStatus checkpoint();
+
+    /**
+     * @brief 后台压缩：复制当前数据，换用新的日志文件，在后台线程中写出新快照
+     * @return 成功开始压缩返回 ok；不在日志模式时返回 io_error
+     *
+     * @note 前台只需要复制学生列表，之后可以继续修改数据；
+     *       日志超过 JournalOptions::compact_threshold_bytes 时会自动调用
+     */
+    [[nodiscard]] SnapshotStatus compact_journal();
+
+    // ==================== 只读快照 ====================
+    // 启用后，每次修改只标记受影响的块，每累计 publish_every 次修改发布一个新版本
+    // （实现见 read_snapshot.h）。
+    // read_snapshot() 可以在其他线程中与添加、删除、改分和清空同时调用，不需要加锁；
+    // 其余方法（包括启用/停用、赋值、load_snapshot 和 open_journal）仍然只能由写线程调用。
+
+    /**
+     * @brief 启用只读快照，并立即发布当前数据
+     * @param publish_every 每累计多少次修改自动发布一次；
+     *                      0 表示只在调用 publish_read_snapshot() 时发布
+     *
+     * @note 发布一次的时间复杂度为 O(块数 + 被修改的块数 × 1024)。
+     *       批量导入时可以先设为 0，导入完成后手动发布一次
+     *
+     * @example
+     * @code
+     * manager.enable_read_snapshots();
+     * std::thread reporter([&manager] {
+     *   auto snapshot = manager.read_snapshot();  // 不阻塞写线程
+     *   std::cout << snapshot->calculate_average_score() << "\n";
+     * });
+     * manager.update_score("2023001", 95.0);
+     * reporter.join();
+     * @endcode
+     */
+    void enable_read_snapshots(size_type publish_every = 1);
+
+    /**
+     * @brief 停用只读快照；已经取得的快照仍然有效
+     */
+    void disable_read_snapshots() noexcept { read_publisher_.reset(); }
+
+    /**
+     * @brief 只读快照是否已启用
+     */
+    [[nodiscard]] bool has_read_snapshots() const noexcept { return read_publisher_.has_value(); }
+
+    /**
+     * @brief 取得最近一次发布的只读快照（线程安全）
+     * @return 未启用只读快照时返回空指针
+     */
+    [[nodiscard]] std::shared_ptr<const ReadSnapshot> read_snapshot() const {
+      return read_publisher_ ? read_publisher_->current() : nullptr;
+    }
+
+    /**
+     * @brief 立即发布当前数据；未启用只读快照时什么也不做
+     */
+    void publish_read_snapshot();
+
+    // ==================== 性能统计 ====================
+    // 编译时定义 STUDENT_MANAGER_METRICS=1（CMake 选项 STUDENT_MANAGER_ENABLE_METRICS）后开启，
+    // 见 metrics.h。未开启时 metrics() 返回 enabled 为 false 的空报告。
+
+    /**
+     * @brief 自创建（或上次 reset_metrics()）以来的性能统计
+     *
+     * @note 复制管理器时统计一起复制；load_snapshot() 和 open_journal() 替换数据时保留统计，
+     *       其中内部的逐条添加不计入
+     *
+     * @example
+     * @code
+     * std::cout << manager.metrics().to_text();
+     * @endcode
+     */
+    [[nodiscard]] MetricsReport metrics() const {
+#if STUDENT_MANAGER_METRICS
+      if (metrics_) {
+        return metrics_->report();
+      }
+      MetricsReport report;
+      report.enabled = true;
+      return report;
+#else
+      return MetricsReport();
+#endif
+    }
+
+    /**
+     * @brief 清空性能统计，重新开始计数
+     */
+    void reset_metrics() {
+#if STUDENT_MANAGER_METRICS
+      metrics_ = std::make_unique<MetricsRecorder>();
+#endif
+    }
 
     // ==================== 数据访问 ====================
 
+    /**
+     * @brief 统计当前占用的内存
+     *
+     * @note 各个容器按容量计算；std::multiset 的节点大小是估算值，
+     *       不包括内存分配器自身的开销
+     * @note 读取排序视图的缓存时要取得它的互斥锁，加锁失败会抛出 std::system_error，
+     *       因此不是 noexcept
+     *
+     * @example
+     * @code
+     * auto usage = manager.memory_usage();
+     * std::cout << "每个学生约 " << usage.bytes_per_student() << " 字节\n";
+     * @endcode
+     */
+    [[nodiscard]] MemoryUsage memory_usage() const;
+
     /**
      * @brief 获取所有学生列表
      * @return 学生列表的常量引用（只读）
@@ -253,10 +1429,67 @@ namespace student_manager {
       return students_;
     }
 
+    /**
+     * @brief 获取成绩列
+     * @return 所有学生的成绩，第 i 个元素就是 get_all_students()[i] 的成绩
+     *
+     * @note 成绩连续存放（每人 8 字节），遍历时不会读入姓名和学号，
+     *       适合交给 kernels::sum / kernels::min / kernels::max 等向量化函数处理
+     *
+     * @example
+     * @code
+     * const auto& scores = manager.get_scores();
+     * double total = kernels::sum(scores.data(), scores.size());
+     * @endcode
+     */
+    [[nodiscard]] const std::vector<double>& get_scores() const noexcept { return scores_; }
+
     /**
      * @brief 清空所有学生数据
+     * @note 日志模式下追加记录、启用只读快照时发布新版本都可能分配内存，因此没有标记为 noexcept
      */
-    void clear() noexcept { students_.clear(); }
+    void clear() {
+      STUDENT_MANAGER_TIME_OPERATION(clear);
+      students_.clear();
+      id_index_.clear();
+      id_keys_.clear();
+      slots_.clear();
+      row_slots_.clear();
+      scores_.clear();
+      aggregates_.clear();
+      subject_scores_.clear_rows();
+      if (rank_index_) {
+        rank_index_->clear();
+      }
+      if (histogram_) {
+        histogram_->clear();
+      }
+      if (name_index_) {
+        name_index_->clear();
+      }
+      clear_sorted_views();
+      string_arena_.clear();
+      arena_garbage_ = 0;
+      if (journal_) {
+        journal_->log_clear();
+      }
+      if (read_publisher_) {
+        read_publisher_->mark_all();
+        count_read_change();
+      }
+    }
   };
 
+  inline void Student::replace_in_owner(const Student& other) {
+    owner_->replace_student(*this, other);
+  }
+
+  inline void Student::set_score(double new_score) {
+    double old_score = score_;
+    score_ = new_score;
+    if (owner_ != nullptr) {
+      owner_->on_score_changed(*this, old_score);
+    }
+  }
+
 }  // namespace student_manager
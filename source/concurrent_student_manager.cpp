@@ -0,0 +1,158 @@
+/**
+ * @file concurrent_student_manager.cpp
+ * @brief 线程安全的学生管理类的实现
+ */
+
+#include "student_manager/concurrent_student_manager.h"
+
+#include <algorithm>  // std::max, std::min
+#include <thread>     // std::thread::hardware_concurrency
+#include <utility>    // std::move
+
+namespace student_manager {
+
+  namespace {
+
+    constexpr std::size_t kMaxShards = 1024;
+
+    std::size_t choose_shard_count(std::size_t requested) noexcept {
+      if (requested == 0) {
+        requested = std::max<std::size_t>(16, 4 * std::thread::hardware_concurrency());
+      }
+      requested = std::min(requested, kMaxShards);
+      std::size_t count = 1;
+      while (count < requested) {
+        count *= 2;
+      }
+      return count;
+    }
+
+    unsigned log2(std::size_t power_of_two) noexcept {
+      unsigned bits = 0;
+      while ((std::size_t{1} << bits) < power_of_two) {
+        ++bits;
+      }
+      return bits;
+    }
+
+  }  // namespace
+
+  ConcurrentStudentManager::ConcurrentStudentManager(std::size_t shard_count)
+      : shards_(choose_shard_count(shard_count)), shard_shift_(32 - log2(shards_.size())) {}
+
+  bool ConcurrentStudentManager::add_student(const Student& student) {
+    Shard& shard = shard_of(student.get_id());
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.students.add_student(student);
+  }
+
+  bool ConcurrentStudentManager::add_student(Student&& student) {
+    Shard& shard = shard_of(student.get_id());
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.students.add_student(std::move(student));
+  }
+
+  bool ConcurrentStudentManager::remove_student(std::string_view student_id) {
+    Shard& shard = shard_of(student_id);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.students.remove_student(student_id);
+  }
+
+  std::optional<Student> ConcurrentStudentManager::find_student(
+      std::string_view student_id) const {
+    const Shard& shard = shard_of(student_id);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    if (auto student = shard.students.find_student(student_id)) {
+      return student->get();  // 在锁内复制
+    }
+    return std::nullopt;
+  }
+
+  bool ConcurrentStudentManager::contains(std::string_view student_id) const {
+    const Shard& shard = shard_of(student_id);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.students.find_student(student_id).has_value();
+  }
+
+  bool ConcurrentStudentManager::update_score(std::string_view student_id, double new_score) {
+    Shard& shard = shard_of(student_id);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.students.update_score(student_id, new_score);
+  }
+
+  bool ConcurrentStudentManager::empty() const { return get_student_count() == 0; }
+
+  int ConcurrentStudentManager::get_student_count() const {
+    int count = 0;
+    visit_all([&](const StudentManager& students) { count += students.get_student_count(); });
+    return count;
+  }
+
+  double ConcurrentStudentManager::calculate_average_score() const {
+    double total = 0.0;
+    std::size_t count = 0;
+    visit_all([&](const StudentManager& students) {
+      total += students.get_total_score();
+      count += static_cast<std::size_t>(students.get_student_count());
+    });
+    return count == 0 ? 0.0 : total / static_cast<double>(count);
+  }
+
+  std::optional<double> ConcurrentStudentManager::get_max_score() const {
+    std::optional<double> result;
+    visit_all([&](const StudentManager& students) {
+      auto score = students.get_max_score();
+      if (score && (!result || *score > *result)) {
+        result = score;
+      }
+    });
+    return result;
+  }
+
+  std::optional<double> ConcurrentStudentManager::get_min_score() const {
+    std::optional<double> result;
+    visit_all([&](const StudentManager& students) {
+      auto score = students.get_min_score();
+      if (score && (!result || *score < *result)) {
+        result = score;
+      }
+    });
+    return result;
+  }
+
+  std::vector<Student> ConcurrentStudentManager::get_all_students() const {
+    std::vector<Student> result;
+    visit_all([&](const StudentManager& students) {
+      const auto& rows = students.get_all_students();
+      result.insert(result.end(), rows.begin(), rows.end());
+    });
+    return result;
+  }
+
+  MetricsReport ConcurrentStudentManager::metrics() const {
+    MetricsReport report;
+    visit_all([&](const StudentManager& students) { report.merge(students.metrics()); });
+    return report;
+  }
+
+  void ConcurrentStudentManager::reserve(size_type count) {
+    // 哈希分布不会完全均匀，多留一些余量
+    size_type per_shard = count / shards_.size() + count / shards_.size() / 8 + 1;
+    for (Shard& shard : shards_) {
+      std::unique_lock<std::shared_mutex> lock(shard.mutex);
+      shard.students.reserve(per_shard);
+    }
+  }
+
+  void ConcurrentStudentManager::clear() {
+    std::vector<std::unique_lock<std::shared_mutex>> locks;
+    locks.reserve(shards_.size());
+    for (Shard& shard : shards_) {
+      locks.emplace_back(shard.mutex);
+    }
+    for (Shard& shard : shards_) {
+      shard.students.clear();
+    }
+  }
+
+}  // namespace student_manager
@@ -0,0 +1,465 @@
+/**
+ * @file csv.cpp
+ * @brief CSV 导入导出的实现
+ */
+
+#include "student_manager/csv.h"
+
+#include <algorithm>    // std::count, std::min, std::max
+#include <charconv>     // std::from_chars, std::to_chars
+#include <cstdio>       // std::snprintf
+#include <cstdlib>      // std::strtod
+#include <cstring>      // std::memcpy
+#include <fstream>      // std::ifstream, std::ofstream
+#include <string_view>  // std::string_view
+#include <thread>       // std::thread
+#include <utility>      // std::move
+
+#include "student_manager/student_manager.h"
+
+namespace student_manager {
+
+  namespace {
+
+    /// 一个块的解析结果，行号都是块内的相对行号（从 0 开始）
+    struct ParsedChunk {
+      std::vector<Student> students;
+      std::vector<std::size_t> student_lines;  ///< students[i] 所在的行
+      std::vector<CsvError> errors;
+      std::size_t line_count = 0;
+      std::size_t rows = 0;  ///< 非空行数
+    };
+
+    std::string_view trim(std::string_view text) noexcept {
+      while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+        text.remove_prefix(1);
+      }
+      while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) {
+        text.remove_suffix(1);
+      }
+      return text;
+    }
+
+    /**
+     * @brief 解析成绩
+     * @note 支持浮点数 std::from_chars 的标准库直接在原始字符上解析；
+     *       其余平台复制到栈上的小缓冲区后用 std::strtod
+     */
+    bool parse_score(std::string_view text, double& score) noexcept {
+      if (text.empty()) {
+        return false;
+      }
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+      auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), score);
+      return error == std::errc() && end == text.data() + text.size();
+#else
+      char buffer[64];
+      if (text.size() >= sizeof(buffer)) {
+        return false;
+      }
+      std::memcpy(buffer, text.data(), text.size());
+      buffer[text.size()] = '\0';
+      char* end = nullptr;
+      score = std::strtod(buffer, &end);
+      return end == buffer + text.size();
+#endif
+    }
+
+    /**
+     * @brief 把一行切成字段
+     * @param scratch 去掉引号转义时使用的缓冲区（按线程复用，只有带 "" 的字段才会用到）
+     * @return 字段个数；出错时返回 0 并设置 error
+     */
+    std::size_t split_fields(std::string_view line, char delimiter, std::string_view* fields,
+                             std::size_t max_fields, std::string* scratch, const char*& error) {
+      std::size_t count = 0;
+      std::size_t pos = 0;
+      for (;;) {
+        if (count == max_fields) {
+          error = "字段数量应为 3";
+          return 0;
+        }
+        // 跳过字段前的空格，判断是否为带引号的字段
+        std::size_t start = pos;
+        while (start < line.size() && (line[start] == ' ' || line[start] == '\t')) {
+          ++start;
+        }
+        if (start < line.size() && line[start] == '"') {
+          std::size_t content = start + 1;
+          bool escaped = false;
+          std::size_t close = content;
+          for (;; ++close) {
+            if (close >= line.size()) {
+              error = "引号没有闭合";
+              return 0;
+            }
+            if (line[close] == '"') {
+              if (close + 1 < line.size() && line[close + 1] == '"') {
+                escaped = true;
+                ++close;
+                continue;
+              }
+              break;
+            }
+          }
+          std::string_view value = line.substr(content, close - content);
+          if (escaped) {
+            std::string& buffer = scratch[count];
+            buffer.clear();
+            for (std::size_t i = 0; i < value.size(); ++i) {
+              buffer.push_back(value[i]);
+              if (value[i] == '"') {
+                ++i;  // 跳过转义用的第二个引号
+              }
+            }
+            value = buffer;
+          }
+          fields[count++] = value;
+          pos = close + 1;
+          while (pos < line.size() && (line[pos] == ' ' || line[pos] == '\t')) {
+            ++pos;
+          }
+          if (pos == line.size()) {
+            return count;
+          }
+          if (line[pos] != delimiter) {
+            error = "引号后面应为分隔符";
+            return 0;
+          }
+          ++pos;
+          continue;
+        }
+        std::size_t end = line.find(delimiter, pos);
+        if (end == std::string_view::npos) {
+          fields[count++] = trim(line.substr(pos));
+          return count;
+        }
+        fields[count++] = trim(line.substr(pos, end - pos));
+        pos = end + 1;
+      }
+    }
+
+    /**
+     * @brief 按引号规则寻找记录的结尾：带引号的字段中的换行不结束记录
+     *
+     * 扫描到文本末尾仍未找到时保留状态，文本变长后可以从停下的位置继续扫描。
+     */
+    struct RecordScanner {
+      std::size_t pos = 0;      ///< 下一个要检查的字符
+      bool quoted = false;      ///< 是否在带引号的字段中
+      bool field_start = true;  ///< 是否在字段开头（之前只有空格）
+
+      /// 返回下一个结束记录的换行符的位置，没有时返回 npos
+      std::size_t next(std::string_view text, char delimiter) noexcept {
+        while (pos < text.size()) {
+          if (quoted) {
+            std::size_t close = text.find('"', pos);
+            if (close == std::string_view::npos) {
+              pos = text.size();
+              return std::string_view::npos;
+            }
+            if (close + 1 == text.size()) {
+              pos = close;  // 还不知道是不是转义的 ""，等更多文本
+              return std::string_view::npos;
+            }
+            if (text[close + 1] == '"') {
+              pos = close + 2;
+              continue;
+            }
+            quoted = false;
+            field_start = false;
+            pos = close + 1;
+            continue;
+          }
+          char c = text[pos++];
+          if (c == '\n') {
+            field_start = true;
+            return pos - 1;
+          }
+          if (c == '"' && field_start) {
+            quoted = true;
+          } else if (c == delimiter) {
+            field_start = true;
+          } else if (c != ' ' && c != '\t') {
+            field_start = false;
+          }
+        }
+        return std::string_view::npos;
+      }
+    };
+
+    /**
+     * @brief 从 pos 开始的记录的结尾（换行符的位置或 text.size()）
+     * @note 引号直到文本末尾都没有闭合时，只把这一行当作记录，让它单独报告"引号没有闭合"
+     */
+    std::size_t record_end(std::string_view text, std::size_t pos, char delimiter) noexcept {
+      std::size_t line_end = text.find('\n', pos);
+      if (line_end == std::string_view::npos) {
+        line_end = text.size();
+      }
+      // 大多数行没有引号，直接在换行处结束
+      if (text.substr(pos, line_end - pos).find('"') == std::string_view::npos) {
+        return line_end;
+      }
+      RecordScanner scanner;
+      scanner.pos = pos;
+      std::size_t end = scanner.next(text, delimiter);
+      if (end != std::string_view::npos) {
+        return end;
+      }
+      // 最后一个字符恰好是闭合的引号时，记录在文本末尾正常结束
+      bool closed = !scanner.quoted || scanner.pos + 1 == text.size();
+      return closed ? text.size() : line_end;
+    }
+
+    void parse_chunk(std::string_view text, char delimiter, ParsedChunk& out) {
+      constexpr std::size_t kFields = 3;
+      std::string_view fields[kFields];
+      std::string scratch[kFields];
+      std::size_t line_index = 0;
+      std::size_t pos = 0;
+      while (pos < text.size()) {
+        std::size_t end = record_end(text, pos, delimiter);
+        std::string_view line = text.substr(pos, end - pos);
+        pos = end + 1;
+        std::size_t current = line_index;
+        // 引号中的换行也算行号，错误总是报告在记录开始的那一行
+        line_index += 1 + static_cast<std::size_t>(std::count(line.begin(), line.end(), '\n'));
+
+        if (!line.empty() && line.back() == '\r') {
+          line.remove_suffix(1);
+        }
+        if (trim(line).empty()) {
+          continue;
+        }
+        ++out.rows;
+
+        const char* error = nullptr;
+        std::size_t count = split_fields(line, delimiter, fields, kFields, scratch, error);
+        double score = 0.0;
+        if (count != 0 && count != kFields) {
+          error = "字段数量应为 3";
+        } else if (count == kFields && fields[1].empty()) {
+          error = "学号为空";
+        } else if (count == kFields && !parse_score(fields[2], score)) {
+          error = "成绩不是有效的数字";
+        } else if (count == kFields && !Student::is_valid_score(score)) {
+          error = "成绩必须在 0-100 之间";
+        }
+        if (error != nullptr) {
+          out.errors.push_back(CsvError{current, error});
+          continue;
+        }
+        out.students.emplace_back(fields[0], fields[1], score);
+        out.student_lines.push_back(current);
+      }
+      // 块总是在换行处切开，最后一个换行之后没有内容时不算一行
+      out.line_count = line_index;
+    }
+
+    /// 从流中读出下一块：在最后一个结束记录的换行处切开，剩余部分留给下一块
+    bool read_chunk(std::istream& in, std::size_t chunk_size, char delimiter,
+                    std::string& carry, std::string& chunk) {
+      chunk = std::move(carry);
+      carry.clear();
+      RecordScanner scanner;  // 每一块都从一条记录的开头开始
+      for (;;) {
+        std::size_t old_size = chunk.size();
+        chunk.resize(old_size + chunk_size);
+        in.read(&chunk[old_size], static_cast<std::streamsize>(chunk_size));
+        chunk.resize(old_size + static_cast<std::size_t>(in.gcount()));
+        if (!in) {
+          return !chunk.empty();  // 文件结束：剩下的全部属于这一块
+        }
+        std::size_t cut = std::string::npos;
+        if (chunk.find('"') == std::string::npos) {
+          cut = chunk.rfind('\n');  // 没有引号时每个换行都结束一条记录
+        } else {
+          for (std::size_t end; (end = scanner.next(chunk, delimiter)) != std::string::npos;) {
+            cut = end;
+          }
+        }
+        if (cut != std::string::npos) {
+          carry.assign(chunk, cut + 1, std::string::npos);
+          chunk.resize(cut + 1);
+          return true;
+        }
+        // 这一块里还没有完整的一条记录（超长行，或引号中的内容很长），继续读
+      }
+    }
+
+    void record_error(CsvImportResult& result, const CsvOptions& options, std::size_t line,
+                      std::string message) {
+      ++result.error_count;
+      if (result.errors.size() < options.max_errors) {
+        result.errors.push_back(CsvError{line, std::move(message)});
+      }
+    }
+
+    /// 把分隔符、引号、换行需要转义的字段加上引号写出
+    void append_field(std::string& buffer, std::string_view field, char delimiter) {
+      bool needs_quotes = field.find_first_of("\"\r\n") != std::string_view::npos
+                          || field.find(delimiter) != std::string_view::npos
+                          || (!field.empty() && (field.front() == ' ' || field.back() == ' '));
+      if (!needs_quotes) {
+        buffer.append(field);
+        return;
+      }
+      buffer.push_back('"');
+      for (char c : field) {
+        if (c == '"') {
+          buffer.push_back('"');
+        }
+        buffer.push_back(c);
+      }
+      buffer.push_back('"');
+    }
+
+    void append_score(std::string& buffer, double score) {
+      char text[32];
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+      auto result = std::to_chars(text, text + sizeof(text), score);
+      buffer.append(text, result.ptr);
+#else
+      int length = std::snprintf(text, sizeof(text), "%.17g", score);
+      buffer.append(text, static_cast<std::size_t>(length));
+#endif
+    }
+
+  }  // namespace
+
+  CsvImportResult import_csv(StudentManager& manager, const std::string& path,
+                             const CsvOptions& options) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+      CsvImportResult result;
+      result.opened = false;
+      return result;
+    }
+    return import_csv(manager, in, options);
+  }
+
+  CsvImportResult import_csv(StudentManager& manager, std::istream& in,
+                             const CsvOptions& options) {
+    CsvImportResult result;
+    unsigned threads = options.threads != 0 ? options.threads : std::thread::hardware_concurrency();
+    threads = std::max(threads, 1u);
+    const std::size_t chunk_size = std::max<std::size_t>(options.chunk_size, 1);
+
+    std::string carry;
+    std::vector<std::string> chunks(threads);
+    std::vector<ParsedChunk> parsed(threads);
+    std::size_t line_base = 1;  // 当前块第一行的行号
+    bool first_chunk = true;
+
+    for (;;) {
+      // ---- 读取：最多一次读出 threads 个块 ----
+      std::size_t count = 0;
+      while (count < threads
+             && read_chunk(in, chunk_size, options.delimiter, carry, chunks[count])) {
+        ++count;
+      }
+      if (count == 0) {
+        break;
+      }
+
+      // 第一块：去掉 UTF-8 BOM 和表头
+      std::string_view first(chunks[0]);
+      if (first_chunk) {
+        first_chunk = false;
+        if (first.substr(0, 3) == "\xEF\xBB\xBF") {
+          first.remove_prefix(3);
+        }
+        if (options.has_header) {
+          std::string_view header = first.substr(0, record_end(first, 0, options.delimiter));
+          first.remove_prefix(std::min(header.size() + 1, first.size()));
+          line_base += 1 + static_cast<std::size_t>(std::count(header.begin(), header.end(), '\n'));
+        }
+      }
+
+      // ---- 解析：每个块一个线程 ----
+      for (std::size_t i = 0; i < count; ++i) {
+        parsed[i] = ParsedChunk{};
+      }
+      std::vector<std::thread> workers;
+      for (std::size_t i = 1; i < count; ++i) {
+        workers.emplace_back(
+            [&, i] { parse_chunk(chunks[i], options.delimiter, parsed[i]); });
+      }
+      parse_chunk(first, options.delimiter, parsed[0]);
+      for (auto& worker : workers) {
+        worker.join();
+      }
+
+      // ---- 按文件顺序加入管理器，重复学号保留先出现的一行 ----
+      for (std::size_t i = 0; i < count; ++i) {
+        ParsedChunk& chunk = parsed[i];
+        result.rows += chunk.rows;
+        std::vector<AddStatus> statuses = manager.add_students(std::move(chunk.students));
+
+        // 解析错误和重复学号都按行号顺序记录
+        std::size_t next_error = 0;
+        for (std::size_t row = 0; row < statuses.size(); ++row) {
+          std::size_t line = chunk.student_lines[row];
+          for (; next_error < chunk.errors.size() && chunk.errors[next_error].line < line;
+               ++next_error) {
+            record_error(result, options, line_base + chunk.errors[next_error].line,
+                         std::move(chunk.errors[next_error].message));
+          }
+          if (statuses[row] == AddStatus::added) {
+            ++result.added;
+          } else {
+            record_error(result, options, line_base + line, "学号重复");
+          }
+        }
+        for (; next_error < chunk.errors.size(); ++next_error) {
+          record_error(result, options, line_base + chunk.errors[next_error].line,
+                       std::move(chunk.errors[next_error].message));
+        }
+        line_base += chunk.line_count;
+      }
+    }
+    return result;
+  }
+
+  bool export_csv(const StudentManager& manager, const std::string& path,
+                  const CsvOptions& options) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      return false;
+    }
+    if (!export_csv(manager, out, options)) {
+      return false;
+    }
+    out.close();
+    return static_cast<bool>(out);
+  }
+
+  bool export_csv(const StudentManager& manager, std::ostream& out, const CsvOptions& options) {
+    constexpr std::size_t kFlushSize = 1 << 20;
+    std::string buffer;
+    buffer.reserve(kFlushSize + 256);
+    const char delimiter = options.delimiter;
+
+    if (options.has_header) {
+      buffer.append("姓名").push_back(delimiter);
+      buffer.append("学号").push_back(delimiter);
+      buffer.append("成绩\n");
+    }
+    for (const Student& student : manager) {
+      append_field(buffer, student.get_name(), delimiter);
+      buffer.push_back(delimiter);
+      append_field(buffer, student.get_id(), delimiter);
+      buffer.push_back(delimiter);
+      append_score(buffer, student.get_score());
+      buffer.push_back('\n');
+      if (buffer.size() >= kFlushSize) {
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+      }
+    }
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    return static_cast<bool>(out);
+  }
+
+}  // namespace student_manager
@@ -0,0 +1,478 @@
+/**
+ * @file journal.cpp
+ * @brief 预写日志的实现
+ */
+
+#include "student_manager/journal.h"
+
+#include <cstdio>    // std::remove, std::rename
+#include <cstring>   // std::memcmp, std::memcpy
+#include <fstream>   // std::ifstream
+#include <iterator>  // std::istreambuf_iterator
+#include <utility>   // std::move
+
+#include "student_manager/checksum.h"
+#include "student_manager/student_manager.h"
+
+#if defined(_WIN32)
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  include <windows.h>
+#else
+#  include <cerrno>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+namespace student_manager {
+
+  namespace {
+
+    constexpr char kMagic[8] = {'S', 'S', 'M', 'J', 'R', 'N', 'L', '\x1A'};
+    constexpr std::uint32_t kVersion = 1;
+    constexpr std::uint32_t kEndianTag = 0x01020304u;
+    constexpr std::size_t kFileHeaderSize = 16;
+
+    /// 记录中字符串之前的定长部分
+    constexpr std::size_t kRecordHeaderSize = 32;
+    /// 最短的记录：定长部分 + 校验和
+    constexpr std::size_t kMinRecordSize = kRecordHeaderSize + 8;
+
+    constexpr std::uint64_t align8(std::uint64_t size) noexcept { return (size + 7) & ~7ull; }
+
+    template <typename T> T load(const char* data) noexcept {
+      T value;
+      std::memcpy(&value, data, sizeof(value));
+      return value;
+    }
+
+    template <typename T> void store(char* data, T value) noexcept {
+      std::memcpy(data, &value, sizeof(value));
+    }
+
+    bool file_exists(const std::string& path) { return std::ifstream(path).good(); }
+
+    /// 文件改名（目标文件不存在）；Windows 上直接写透，不需要再刷目录
+    bool rename_file(const std::string& from, const std::string& to) {
+#if defined(_WIN32)
+      return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_WRITE_THROUGH) != 0;
+#else
+      return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+    }
+
+  }  // namespace
+
+  // ==================== 回放 ====================
+
+  JournalReplay replay_journal(const std::string& path, std::uint64_t after_sequence,
+                               const std::function<void(const JournalRecord&)>& apply) {
+    JournalReplay result;
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+      result.status = SnapshotStatus::open_failed;
+      return result;
+    }
+    const std::string data{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    if (data.size() < kFileHeaderSize) {
+      return result;  // 创建文件时断电，文件头都没写完，当作空日志
+    }
+    if (std::memcmp(data.data(), kMagic, sizeof(kMagic)) != 0) {
+      result.status = SnapshotStatus::not_a_snapshot;
+      return result;
+    }
+    if (load<std::uint32_t>(data.data() + 8) != kVersion
+        || load<std::uint32_t>(data.data() + 12) != kEndianTag) {
+      result.status = SnapshotStatus::unsupported_format;
+      return result;
+    }
+
+    std::size_t pos = kFileHeaderSize;
+    result.valid_bytes = pos;
+    // 任何一项检查失败都说明从这里开始是写了一半的记录，停止回放
+    while (data.size() - pos >= kMinRecordSize) {
+      const char* record = data.data() + pos;
+      auto size = static_cast<std::size_t>(load<std::uint32_t>(record));
+      if (size < kMinRecordSize || size % 8 != 0 || size > data.size() - pos) {
+        break;
+      }
+      Checksum checksum;
+      checksum.update(record, size - 8);
+      if (checksum.finish() != load<std::uint64_t>(record + size - 8)) {
+        break;
+      }
+
+      JournalRecord entry;
+      auto type = static_cast<std::uint8_t>(record[4]);
+      entry.sequence = load<std::uint64_t>(record + 8);
+      entry.score = load<double>(record + 16);
+      std::uint64_t name_size = load<std::uint32_t>(record + 24);
+      std::uint64_t id_size = load<std::uint32_t>(record + 28);
+      if (type < static_cast<std::uint8_t>(JournalRecordType::add)
+          || type > static_cast<std::uint8_t>(JournalRecordType::clear)
+          || entry.sequence <= result.last_sequence
+          || kMinRecordSize + align8(name_size + id_size) != size) {
+        break;
+      }
+      entry.type = static_cast<JournalRecordType>(type);
+      entry.name = std::string_view(record + kRecordHeaderSize, name_size);
+      entry.id = std::string_view(record + kRecordHeaderSize + name_size, id_size);
+
+      result.last_sequence = entry.sequence;
+      pos += size;
+      result.valid_bytes = pos;
+      if (entry.sequence > after_sequence) {
+        apply(entry);
+        ++result.applied;
+      }
+    }
+    return result;
+  }
+
+  // ==================== 追加与成批同步 ====================
+
+  Journal::Journal(std::string snapshot_path, std::string journal_path,
+                   const JournalOptions& options)
+      : snapshot_path_(std::move(snapshot_path)),
+        journal_path_(std::move(journal_path)),
+        options_(options) {}
+
+  Journal::~Journal() {
+    (void)wait_for_compaction();
+    stop_flusher();
+    close_file();
+  }
+
+  SnapshotStatus Journal::open(std::uint64_t last_sequence, std::uint64_t valid_bytes) {
+    last_sequence_ = last_sequence;
+    durable_sequence_ = last_sequence;
+    if (valid_bytes < kFileHeaderSize) {
+      // 新建的日志文件要刷一次目录，之后的记录才算真正落盘
+      if (!open_file(true) || !write_file_header() || !sync_file()
+          || !sync_parent_directory(journal_path_)) {
+        close_file();
+        return SnapshotStatus::open_failed;
+      }
+    } else {
+      // 截掉断电时写了一半的记录，新记录接在最后一条完整记录之后
+      if (!open_file(false) || !truncate_file(valid_bytes)) {
+        close_file();
+        return SnapshotStatus::open_failed;
+      }
+      file_bytes_ = valid_bytes;
+    }
+    flusher_ = std::thread([this] { flusher_loop(); });
+    return SnapshotStatus::ok;
+  }
+
+  void Journal::log_add(std::string_view name, std::string_view id, double score) {
+    append(JournalRecordType::add, name, id, score);
+  }
+
+  void Journal::log_remove(std::string_view id) {
+    append(JournalRecordType::remove, {}, id, 0.0);
+  }
+
+  void Journal::log_score(std::string_view id, double score) {
+    append(JournalRecordType::score, {}, id, score);
+  }
+
+  void Journal::log_clear() { append(JournalRecordType::clear, {}, {}, 0.0); }
+
+  void Journal::append(JournalRecordType type, std::string_view name, std::string_view id,
+                       double score) {
+    const std::size_t size = kMinRecordSize + align8(name.size() + id.size());
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t begin = buffer_.size();
+    buffer_.resize(begin + size, '\0');
+    char* record = &buffer_[begin];
+    store(record, static_cast<std::uint32_t>(size));
+    record[4] = static_cast<char>(type);
+    store(record + 8, ++last_sequence_);
+    store(record + 16, score);
+    store(record + 24, static_cast<std::uint32_t>(name.size()));
+    store(record + 28, static_cast<std::uint32_t>(id.size()));
+    if (!name.empty()) {
+      std::memcpy(record + kRecordHeaderSize, name.data(), name.size());
+    }
+    if (!id.empty()) {
+      std::memcpy(record + kRecordHeaderSize + name.size(), id.data(), id.size());
+    }
+    Checksum checksum;
+    checksum.update(record, size - 8);
+    store(record + size - 8, checksum.finish());
+    file_bytes_ += size;
+
+    // 只在第一条记录（开始计时）和攒满一批时唤醒后台线程
+    if (++pending_records_ == 1) {
+      first_pending_ = std::chrono::steady_clock::now();
+      wake_flusher_.notify_one();
+    } else if (pending_records_ == options_.group_commit_records) {
+      wake_flusher_.notify_one();
+    }
+  }
+
+  void Journal::flusher_loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+      wake_flusher_.wait(lock, [this] { return stopping_ || !buffer_.empty(); });
+      if (buffer_.empty()) {
+        return;  // 要关闭，并且没有剩余的记录
+      }
+      // 等到攒够一批、超过延迟预算、有人要求同步，或者要关闭
+      wake_flusher_.wait_until(lock, first_pending_ + options_.group_commit_delay, [this] {
+        return stopping_ || sync_requested_ || pending_records_ >= options_.group_commit_records;
+      });
+
+      std::string batch;
+      batch.swap(spare_buffer_);
+      batch.swap(buffer_);  // buffer_ 换成上一次用过的空缓冲区，容量得以复用
+      std::uint64_t sequence = last_sequence_;
+      pending_records_ = 0;
+      sync_requested_ = false;
+
+      // 写文件和 fsync 期间不持有锁，前台可以继续追加记录
+      bool failed = failed_;
+      lock.unlock();
+      bool ok = !failed && write_file(batch.data(), batch.size()) && sync_file();
+      lock.lock();
+
+      if (ok) {
+        durable_sequence_ = sequence;
+      } else {
+        failed_ = true;  // 之后的记录已经无法保证连续，不再写入
+      }
+      batch.clear();
+      spare_buffer_.swap(batch);
+      synced_.notify_all();
+    }
+  }
+
+  SnapshotStatus Journal::sync() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!flusher_.joinable()) {
+      return SnapshotStatus::io_error;
+    }
+    const std::uint64_t target = last_sequence_;
+    if (durable_sequence_ < target && !failed_) {
+      sync_requested_ = true;
+      wake_flusher_.notify_one();
+      synced_.wait(lock, [&] { return durable_sequence_ >= target || failed_; });
+    }
+    return failed_ ? SnapshotStatus::io_error : SnapshotStatus::ok;
+  }
+
+  std::uint64_t Journal::last_sequence() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_sequence_;
+  }
+
+  std::uint64_t Journal::durable_sequence() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return durable_sequence_;
+  }
+
+  void Journal::stop_flusher() {
+    if (!flusher_.joinable()) {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    wake_flusher_.notify_one();
+    flusher_.join();
+  }
+
+  // ==================== 压缩 ====================
+
+  bool Journal::wants_compaction() const {
+    if (options_.compact_threshold_bytes == 0) {
+      return false;
+    }
+    if (compaction_.valid()
+        && compaction_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+      return false;  // 上一次压缩还在进行
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    return file_bytes_ >= options_.compact_threshold_bytes;
+  }
+
+  SnapshotStatus Journal::checkpoint(const std::vector<Student>& students) {
+    (void)wait_for_compaction();
+    SnapshotStatus status = sync();
+    if (status != SnapshotStatus::ok) {
+      return status;
+    }
+    status = write_snapshot(snapshot_path_, students, last_sequence());
+    if (status != SnapshotStatus::ok) {
+      return status;
+    }
+    // 快照已经落盘，其中包含了两份日志中的所有记录
+    std::remove(old_journal_path().c_str());
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!truncate_file(kFileHeaderSize)) {
+      return SnapshotStatus::io_error;
+    }
+    file_bytes_ = kFileHeaderSize;
+    return SnapshotStatus::ok;
+  }
+
+  SnapshotStatus Journal::start_compaction(std::vector<Student> students) {
+    (void)wait_for_compaction();
+    if (file_exists(old_journal_path())) {
+      // 上一次压缩失败，旧日志还在：不能覆盖它，改为同步压缩
+      return checkpoint(students);
+    }
+    SnapshotStatus status = sync();
+    if (status != SnapshotStatus::ok) {
+      return status;
+    }
+
+    const std::uint64_t sequence = last_sequence();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      close_file();
+      if (!rename_file(journal_path_, old_journal_path())) {
+        failed_ = !open_file(false);
+        return SnapshotStatus::io_error;
+      }
+      // 改名和新日志的目录项都落盘之后，新快照才能让后台线程删除旧日志
+      if (!open_file(true) || !write_file_header() || !sync_file()
+          || !sync_parent_directory(journal_path_)) {
+        failed_ = true;
+        return SnapshotStatus::io_error;
+      }
+    }
+
+    compaction_ = std::async(std::launch::async, [snapshot_path = snapshot_path_,
+                                                  old_path = old_journal_path(),
+                                                  students = std::move(students), sequence] {
+      SnapshotStatus result = write_snapshot(snapshot_path, students, sequence);
+      if (result == SnapshotStatus::ok) {
+        std::remove(old_path.c_str());
+      }
+      return result;
+    });
+    return SnapshotStatus::ok;
+  }
+
+  SnapshotStatus Journal::wait_for_compaction() {
+    if (compaction_.valid()) {
+      last_compaction_ = compaction_.get();
+    }
+    return last_compaction_;
+  }
+
+  // ==================== 文件操作 ====================
+
+  bool Journal::write_file_header() {
+    char header[kFileHeaderSize];
+    std::memcpy(header, kMagic, sizeof(kMagic));
+    store(header + 8, kVersion);
+    store(header + 12, kEndianTag);
+    file_bytes_ = kFileHeaderSize;
+    return write_file(header, sizeof(header));
+  }
+
+#if defined(_WIN32)
+
+  namespace {
+    HANDLE to_handle(std::intptr_t file) noexcept { return reinterpret_cast<HANDLE>(file); }
+  }  // namespace
+
+  bool Journal::open_file(bool truncate) {
+    // 允许共享写入：重新打开同一个日志时，新的日志在旧的日志关闭之前就要打开这个文件
+    HANDLE file = CreateFileA(journal_path_.c_str(), GENERIC_WRITE,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                              truncate ? CREATE_ALWAYS : OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+      return false;
+    }
+    file_ = reinterpret_cast<std::intptr_t>(file);
+    return true;
+  }
+
+  void Journal::close_file() noexcept {
+    if (file_ != -1) {
+      CloseHandle(to_handle(file_));
+      file_ = -1;
+    }
+  }
+
+  bool Journal::write_file(const char* data, std::size_t size) {
+    LARGE_INTEGER zero{};
+    if (!SetFilePointerEx(to_handle(file_), zero, nullptr, FILE_END)) {
+      return false;
+    }
+    while (size > 0) {
+      DWORD chunk = size > (1u << 30) ? (1u << 30) : static_cast<DWORD>(size);
+      DWORD written = 0;
+      if (!WriteFile(to_handle(file_), data, chunk, &written, nullptr)) {
+        return false;
+      }
+      data += written;
+      size -= written;
+    }
+    return true;
+  }
+
+  bool Journal::sync_file() { return FlushFileBuffers(to_handle(file_)) != 0; }
+
+  bool Journal::truncate_file(std::uint64_t size) {
+    LARGE_INTEGER position;
+    position.QuadPart = static_cast<LONGLONG>(size);
+    return SetFilePointerEx(to_handle(file_), position, nullptr, FILE_BEGIN)
+           && SetEndOfFile(to_handle(file_));
+  }
+
+#else
+
+  bool Journal::open_file(bool truncate) {
+    int flags = O_WRONLY | O_CREAT | O_APPEND | (truncate ? O_TRUNC : 0);
+    file_ = ::open(journal_path_.c_str(), flags, 0644);
+    return file_ >= 0;
+  }
+
+  void Journal::close_file() noexcept {
+    if (file_ >= 0) {
+      ::close(static_cast<int>(file_));
+      file_ = -1;
+    }
+  }
+
+  bool Journal::write_file(const char* data, std::size_t size) {
+    while (size > 0) {
+      ssize_t written = ::write(static_cast<int>(file_), data, size);
+      if (written < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return false;
+      }
+      data += written;
+      size -= static_cast<std::size_t>(written);
+    }
+    return true;
+  }
+
+  bool Journal::sync_file() {
+#  if defined(__linux__)
+    return ::fdatasync(static_cast<int>(file_)) == 0;  // 不必等待修改时间等元数据落盘
+#  else
+    return ::fsync(static_cast<int>(file_)) == 0;
+#  endif
+  }
+
+  bool Journal::truncate_file(std::uint64_t size) {
+    return ::ftruncate(static_cast<int>(file_), static_cast<off_t>(size)) == 0;
+  }
+
+#endif
+
+}  // namespace student_manager
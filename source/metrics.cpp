@@ -0,0 +1,252 @@
+/**
+ * @file metrics.cpp
+ * @brief 性能统计的实现
+ */
+
+#include "student_manager/metrics.h"
+
+#include <algorithm>  // std::max, std::min
+#include <cmath>      // std::ceil
+#include <iomanip>    // std::setw, std::setprecision
+#include <sstream>    // std::ostringstream
+
+namespace student_manager {
+
+  namespace {
+
+    /// 最高的非零位的位置（value > 0）
+    unsigned highest_bit(std::uint64_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+      return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#else
+      unsigned bit = 0;
+      while (value >>= 1) {
+        ++bit;
+      }
+      return bit;
+#endif
+    }
+
+    /// 纳秒转换为微秒
+    double microseconds(double nanoseconds) noexcept { return nanoseconds / 1000.0; }
+
+  }  // namespace
+
+  std::string_view to_string(Operation operation) noexcept {
+    switch (operation) {
+      case Operation::add_student:
+        return "add_student";
+      case Operation::add_students:
+        return "add_students";
+      case Operation::insert_student:
+        return "insert_student";
+      case Operation::remove_student:
+        return "remove_student";
+      case Operation::find_student:
+        return "find_student";
+      case Operation::find_students:
+        return "find_students";
+      case Operation::update_score:
+        return "update_score";
+      case Operation::update_scores:
+        return "update_scores";
+      case Operation::rank_of:
+        return "rank_of";
+      case Operation::kth_score:
+        return "kth_score";
+      case Operation::top_k:
+        return "top_k";
+      case Operation::bottom_k:
+        return "bottom_k";
+      case Operation::count_in_range:
+        return "count_in_range";
+      case Operation::grade_distribution:
+        return "grade_distribution";
+      case Operation::approximate_percentile:
+        return "approximate_percentile";
+      case Operation::find_by_name:
+        return "find_by_name";
+      case Operation::scan:
+        return "scan";
+      case Operation::sorted_by:
+        return "sorted_by";
+      case Operation::compute_statistics:
+        return "compute_statistics";
+      case Operation::subject_average:
+        return "subject_average";
+      case Operation::subject_statistics:
+        return "subject_statistics";
+      case Operation::compute_gpas:
+        return "compute_gpas";
+      case Operation::memory_usage:
+        return "memory_usage";
+      case Operation::clear:
+        return "clear";
+      case Operation::save_snapshot:
+        return "save_snapshot";
+      case Operation::load_snapshot:
+        return "load_snapshot";
+      case Operation::open_journal:
+        return "open_journal";
+    }
+    return "unknown";
+  }
+
+  // ==================== LatencyHistogram ====================
+
+  std::size_t LatencyHistogram::bucket_of(std::uint64_t nanoseconds) noexcept {
+    if (nanoseconds < kSubBuckets) {
+      return static_cast<std::size_t>(nanoseconds);
+    }
+    unsigned exponent = highest_bit(nanoseconds);
+    if (exponent >= kMaxExponent) {
+      return kBuckets - 1;
+    }
+    // 最高位是 2^exponent，接下来的 4 位决定在这个区间中的哪个桶
+    auto sub = static_cast<std::size_t>((nanoseconds >> (exponent - 4)) & (kSubBuckets - 1));
+    return kSubBuckets + (exponent - 4) * kSubBuckets + sub;
+  }
+
+  std::uint64_t LatencyHistogram::bucket_upper(std::size_t bucket) noexcept {
+    if (bucket < kSubBuckets) {
+      return bucket;
+    }
+    std::size_t exponent = 4 + (bucket - kSubBuckets) / kSubBuckets;
+    std::uint64_t sub = (bucket - kSubBuckets) % kSubBuckets;
+    std::uint64_t width = std::uint64_t{1} << (exponent - 4);
+    return ((kSubBuckets + sub) << (exponent - 4)) + width - 1;
+  }
+
+  void LatencyHistogram::record(std::uint64_t nanoseconds) noexcept {
+    ++buckets_[bucket_of(nanoseconds)];
+    ++count_;
+    total_ += nanoseconds;
+    max_ = std::max(max_, nanoseconds);
+  }
+
+  void LatencyHistogram::merge(const LatencyHistogram& other) noexcept {
+    for (std::size_t i = 0; i < kBuckets; ++i) {
+      buckets_[i] += other.buckets_[i];
+    }
+    count_ += other.count_;
+    total_ += other.total_;
+    max_ = std::max(max_, other.max_);
+  }
+
+  std::uint64_t LatencyHistogram::percentile(double percentile) const noexcept {
+    if (count_ == 0) {
+      return 0;
+    }
+    // 排在第 rank 位（从 1 开始）的记录
+    double wanted = std::ceil(static_cast<double>(count_) * std::clamp(percentile, 0.0, 100.0)
+                              / 100.0);
+    auto rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(wanted));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < kBuckets; ++i) {
+      seen += buckets_[i];
+      if (seen >= rank) {
+        return std::min(bucket_upper(i), max_);
+      }
+    }
+    return max_;
+  }
+
+  // ==================== MetricsReport ====================
+
+  void MetricsReport::merge(const MetricsReport& other) {
+    enabled = enabled || other.enabled;
+    for (std::size_t i = 0; i < kOperationCount; ++i) {
+      latency[i].merge(other.latency[i]);
+    }
+    find_hits += other.find_hits;
+    find_misses += other.find_misses;
+    duplicates_rejected += other.duplicates_rejected;
+  }
+
+  std::string MetricsReport::to_text() const {
+    std::ostringstream out;
+    if (!enabled) {
+      out << "性能统计未开启（编译时定义 STUDENT_MANAGER_METRICS=1，"
+             "或使用 CMake 选项 -DSTUDENT_MANAGER_ENABLE_METRICS=ON）\n";
+      return out.str();
+    }
+    out << std::left << std::setw(24) << "operation" << std::right << std::setw(12) << "calls"
+        << std::setw(12) << "mean(us)" << std::setw(12) << "p50(us)" << std::setw(12) << "p90(us)"
+        << std::setw(12) << "p99(us)" << std::setw(12) << "max(us)" << "\n";
+    out << std::fixed << std::setprecision(3);
+    for (std::size_t i = 0; i < kOperationCount; ++i) {
+      const LatencyHistogram& histogram = latency[i];
+      if (histogram.count() == 0) {
+        continue;
+      }
+      auto percentile = [&](double p) {
+        return microseconds(static_cast<double>(histogram.percentile(p)));
+      };
+      out << std::left << std::setw(24) << to_string(static_cast<Operation>(i)) << std::right
+          << std::setw(12) << histogram.count() << std::setw(12) << microseconds(histogram.mean())
+          << std::setw(12) << percentile(50) << std::setw(12) << percentile(90) << std::setw(12)
+          << percentile(99) << std::setw(12)
+          << microseconds(static_cast<double>(histogram.max())) << "\n";
+    }
+    out << std::setprecision(1);
+    out << "find_student 命中率: " << find_hit_ratio() * 100.0 << "% (命中 " << find_hits
+        << "，未命中 " << find_misses << ")\n";
+    out << "因学号重复被拒绝: " << duplicates_rejected << "\n";
+    return out.str();
+  }
+
+  // ==================== MetricsRecorder ====================
+
+  MetricsRecorder::MetricsRecorder(const MetricsRecorder& other) noexcept {
+    for (std::size_t op = 0; op < kOperationCount; ++op) {
+      const Counters& from = other.operations_[op];
+      Counters& to = operations_[op];
+      for (std::size_t i = 0; i < LatencyHistogram::kBuckets; ++i) {
+        to.buckets[i].store(from.buckets[i].load(std::memory_order_relaxed),
+                            std::memory_order_relaxed);
+      }
+      to.count.store(from.count.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      to.total.store(from.total.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      to.max.store(from.max.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    for (std::size_t i = 0; i < events_.size(); ++i) {
+      events_[i].store(other.events_[i].load(std::memory_order_relaxed),
+                       std::memory_order_relaxed);
+    }
+  }
+
+  void MetricsRecorder::record(Operation operation, std::uint64_t nanoseconds) noexcept {
+    Counters& counters = operations_[static_cast<std::size_t>(operation)];
+    counters.buckets[LatencyHistogram::bucket_of(nanoseconds)].fetch_add(
+        1, std::memory_order_relaxed);
+    counters.count.fetch_add(1, std::memory_order_relaxed);
+    counters.total.fetch_add(nanoseconds, std::memory_order_relaxed);
+    std::uint64_t max = counters.max.load(std::memory_order_relaxed);
+    while (nanoseconds > max
+           && !counters.max.compare_exchange_weak(max, nanoseconds, std::memory_order_relaxed)) {
+    }
+  }
+
+  MetricsReport MetricsRecorder::report() const {
+    MetricsReport report;
+    report.enabled = true;
+    for (std::size_t op = 0; op < kOperationCount; ++op) {
+      const Counters& from = operations_[op];
+      LatencyHistogram& to = report.latency[op];
+      for (std::size_t i = 0; i < LatencyHistogram::kBuckets; ++i) {
+        to.buckets_[i] = from.buckets[i].load(std::memory_order_relaxed);
+      }
+      to.count_ = from.count.load(std::memory_order_relaxed);
+      to.total_ = from.total.load(std::memory_order_relaxed);
+      to.max_ = from.max.load(std::memory_order_relaxed);
+    }
+    auto event = [&](Event which) {
+      return events_[static_cast<std::size_t>(which)].load(std::memory_order_relaxed);
+    };
+    report.find_hits = event(Event::find_hit);
+    report.find_misses = event(Event::find_miss);
+    report.duplicates_rejected = event(Event::duplicate_rejected);
+    return report;
+  }
+
+}  // namespace student_manager
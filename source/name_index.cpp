@@ -0,0 +1,238 @@
+/**
+ * @file name_index.cpp
+ * @brief 姓名索引的实现
+ */
+
+#include "student_manager/name_index.h"
+
+#include <algorithm>  // std::sort, std::unique
+
+namespace student_manager {
+
+  namespace {
+
+    /// 失效条目少于这个数时不重建倒排表
+    constexpr std::size_t kMinStaleForRebuild = 4096;
+
+    /// 2-gram 的标记位，与 1-gram 区分
+    constexpr std::uint64_t kBigramFlag = std::uint64_t{1} << 63;
+
+    /// 以 lead 开头的 UTF-8 字符应有的字节数（不合法的首字节按 1 字节计）
+    std::size_t expected_length(unsigned char lead) noexcept {
+      if (lead >= 0xF0) {
+        return 4;
+      }
+      if (lead >= 0xE0) {
+        return 3;
+      }
+      return lead >= 0xC0 ? 2 : 1;
+    }
+
+    /// 从 text[pos] 开始的 UTF-8 字符的字节数（不合法的字节按 1 字节计）
+    std::size_t utf8_length(std::string_view text, std::size_t pos) noexcept {
+      std::size_t length = expected_length(static_cast<unsigned char>(text[pos]));
+      if (pos + length > text.size()) {
+        return 1;
+      }
+      for (std::size_t i = 1; i < length; ++i) {
+        if ((static_cast<unsigned char>(text[pos + i]) & 0xC0) != 0x80) {
+          return 1;
+        }
+      }
+      return length;
+    }
+
+    /// 把姓名拆成字符，每个字符用它的 UTF-8 字节编码成一个整数（最多 4 字节，不会冲突）
+    std::vector<std::uint32_t> split_characters(std::string_view text) {
+      std::vector<std::uint32_t> characters;
+      characters.reserve(text.size());
+      for (std::size_t pos = 0; pos < text.size();) {
+        std::size_t length = utf8_length(text, pos);
+        std::uint32_t code = 0;
+        for (std::size_t i = 0; i < length; ++i) {
+          code = (code << 8) | static_cast<unsigned char>(text[pos + i]);
+        }
+        characters.push_back(code);
+        pos += length;
+      }
+      return characters;
+    }
+
+    /// 姓名中所有不同的 1-gram 和 2-gram
+    std::vector<std::uint64_t> grams_of(std::string_view name) {
+      std::vector<std::uint32_t> characters = split_characters(name);
+      std::vector<std::uint64_t> grams;
+      grams.reserve(characters.size() * 2);
+      for (std::size_t i = 0; i < characters.size(); ++i) {
+        grams.push_back(characters[i]);
+        if (i + 1 < characters.size()) {
+          grams.push_back(kBigramFlag | (std::uint64_t{characters[i]} << 32) | characters[i + 1]);
+        }
+      }
+      std::sort(grams.begin(), grams.end());
+      grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+      return grams;
+    }
+
+  }  // namespace
+
+  std::string_view NameIndex::complete_prefix(std::string_view text) noexcept {
+    std::size_t start = text.size();
+    for (std::size_t back = 1; back <= 4 && back <= text.size(); ++back) {
+      auto byte = static_cast<unsigned char>(text[text.size() - back]);
+      if ((byte & 0xC0) != 0x80) {
+        start = text.size() - back;
+        break;
+      }
+    }
+    if (start == text.size()) {
+      return text;
+    }
+    std::size_t expected = expected_length(static_cast<unsigned char>(text[start]));
+    return start + expected > text.size() ? text.substr(0, start) : text;
+  }
+
+  NameIndex::NameIndex(const NameIndex& other) {
+    // by_slot_ 指向 by_name_ 的节点，不能直接复制，按槽位重新插入
+    by_slot_.reserve(other.by_slot_.size());
+    for (const Entry& entry : other.by_name_) {
+      auto it = by_name_.insert(by_name_.end(), entry);
+      if (entry.second >= by_slot_.size()) {
+        by_slot_.resize(entry.second + 1, nullptr);
+      }
+      by_slot_[entry.second] = &*it;
+    }
+    grams_ = other.grams_;
+    gram_entries_ = other.gram_entries_;
+    stale_grams_ = other.stale_grams_;
+  }
+
+  NameIndex& NameIndex::operator=(const NameIndex& other) {
+    if (this != &other) {
+      NameIndex copy(other);
+      *this = std::move(copy);
+    }
+    return *this;
+  }
+
+  void NameIndex::insert(std::uint32_t slot, std::string_view name) {
+    if (slot >= by_slot_.size()) {
+      by_slot_.resize(slot + 1, nullptr);
+    }
+    auto it = by_name_.emplace(std::string(name), slot).first;
+    by_slot_[slot] = &*it;
+    add_grams(slot, name);
+  }
+
+  void NameIndex::erase(std::uint32_t slot) {
+    const Entry* entry = by_slot_[slot];
+    stale_grams_ += grams_of(entry->first).size();
+    by_name_.erase(*entry);
+    by_slot_[slot] = nullptr;
+    if (stale_grams_ > kMinStaleForRebuild && stale_grams_ * 2 > gram_entries_) {
+      rebuild_grams();
+    }
+  }
+
+  void NameIndex::clear() noexcept {
+    by_name_.clear();
+    by_slot_.clear();
+    grams_.clear();
+    gram_entries_ = 0;
+    stale_grams_ = 0;
+  }
+
+  void NameIndex::add_grams(std::uint32_t slot, std::string_view name) {
+    for (std::uint64_t gram : grams_of(name)) {
+      grams_[gram].push_back(slot);
+      ++gram_entries_;
+    }
+  }
+
+  void NameIndex::rebuild_grams() {
+    grams_.clear();
+    gram_entries_ = 0;
+    stale_grams_ = 0;
+    for (const Entry& entry : by_name_) {
+      add_grams(entry.second, entry.first);
+    }
+  }
+
+  std::vector<std::uint32_t> NameIndex::find_exact(std::string_view name) const {
+    std::vector<std::uint32_t> slots;
+    auto [first, last] = by_name_.equal_range(name);
+    for (auto it = first; it != last; ++it) {
+      slots.push_back(it->second);
+    }
+    return slots;
+  }
+
+  std::vector<std::uint32_t> NameIndex::find_prefix(std::string_view prefix,
+                                                    std::size_t limit) const {
+    prefix = complete_prefix(prefix);
+    std::vector<std::uint32_t> slots;
+    for (auto it = by_name_.lower_bound(prefix);
+         it != by_name_.end() && slots.size() < limit
+         && std::string_view(it->first).substr(0, prefix.size()) == prefix;
+         ++it) {
+      slots.push_back(it->second);
+    }
+    return slots;
+  }
+
+  std::vector<std::uint32_t> NameIndex::find_substring(std::string_view text) const {
+    std::vector<std::uint32_t> slots;
+    if (text.empty()) {
+      for (const Entry& entry : by_name_) {
+        slots.push_back(entry.second);
+      }
+      std::sort(slots.begin(), slots.end());
+      return slots;
+    }
+
+    // 选出倒排表最短的 gram：只有一个字符时用 1-gram，否则用相邻两个字符的 2-gram
+    std::vector<std::uint64_t> grams = grams_of(text);
+    const std::vector<std::uint32_t>* candidates = nullptr;
+    bool single_character = split_characters(text).size() == 1;
+    for (std::uint64_t gram : grams) {
+      if (!single_character && (gram & kBigramFlag) == 0) {
+        continue;
+      }
+      auto it = grams_.find(gram);
+      if (it == grams_.end()) {
+        return slots;  // 没有姓名含有这个 gram
+      }
+      if (candidates == nullptr || it->second.size() < candidates->size()) {
+        candidates = &it->second;
+      }
+    }
+
+    // 确认候选者：跳过已删除的槽位，以及槽位被重新使用后姓名已经不再包含 text 的条目
+    for (std::uint32_t slot : *candidates) {
+      const Entry* entry = by_slot_[slot];
+      if (entry != nullptr && entry->first.find(text) != std::string::npos) {
+        slots.push_back(slot);
+      }
+    }
+    std::sort(slots.begin(), slots.end());
+    slots.erase(std::unique(slots.begin(), slots.end()), slots.end());
+    return slots;
+  }
+
+  std::size_t NameIndex::memory_bytes() const noexcept {
+    // std::set 节点：三个指针 + 颜色，再加上条目本身
+    std::size_t bytes = by_name_.size() * (4 * sizeof(void*) + sizeof(Entry))
+                        + by_slot_.capacity() * sizeof(const Entry*);
+    for (const Entry& entry : by_name_) {
+      bytes += entry.first.capacity() > 15 ? entry.first.capacity() + 1 : 0;
+    }
+    // std::unordered_map 节点：next 指针 + 键 + 值，以及桶数组
+    bytes += grams_.bucket_count() * sizeof(void*);
+    for (const auto& [gram, slots] : grams_) {
+      bytes += sizeof(void*) + sizeof(gram) + sizeof(slots)
+               + slots.capacity() * sizeof(std::uint32_t);
+    }
+    return bytes;
+  }
+
+}  // namespace student_manager
@@ -0,0 +1,134 @@
+/**
+ * @file parallel.cpp
+ * @brief 线程池和并行扫描的实现
+ */
+
+#include "student_manager/parallel.h"
+
+#include "student_manager/score_kernels.h"
+
+namespace student_manager {
+
+  namespace {
+
+    /// 当前线程是否正在执行线程池中的任务（任务内部再次调用 run() 时串行执行）
+    thread_local bool inside_pool_task = false;
+
+  }  // namespace
+
+  ThreadPool::ThreadPool(std::size_t threads) {
+    for (std::size_t i = 1; i < threads; ++i) {
+      workers_.emplace_back([this] { worker_loop(); });
+    }
+  }
+
+  ThreadPool::~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()));
+    return pool;
+  }
+
+  void ThreadPool::run(std::size_t count, std::size_t max_threads,
+                       const std::function<void(std::size_t)>& task) {
+    std::unique_lock<std::mutex> busy(run_mutex_, std::defer_lock);
+    if (count <= 1 || max_threads == 1 || workers_.empty() || inside_pool_task
+        || !busy.try_lock()) {
+      for (std::size_t i = 0; i < count; ++i) {
+        task(i);
+      }
+      return;
+    }
+
+    std::size_t helpers = max_threads == 0 ? workers_.size() : max_threads - 1;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      task_ = &task;
+      task_count_ = count;
+      next_task_.store(0, std::memory_order_relaxed);
+      helpers_wanted_ = std::min({helpers, workers_.size(), count - 1});
+      helpers_joined_ = 0;
+      error_ = nullptr;
+      ++generation_;
+    }
+    wake_.notify_all();
+    drain();
+
+    std::exception_ptr error;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      finished_.wait(lock, [this] { return helpers_busy_ == 0; });
+      helpers_wanted_ = 0;  // 醒得晚的工作线程不再加入这一批
+      task_ = nullptr;
+      error = error_;
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  void ThreadPool::worker_loop() {
+    std::uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+      wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+      if (stopping_) {
+        return;
+      }
+      seen = generation_;
+      if (helpers_joined_ >= helpers_wanted_) {
+        continue;
+      }
+      ++helpers_joined_;
+      ++helpers_busy_;
+      lock.unlock();
+      drain();
+      lock.lock();
+      if (--helpers_busy_ == 0) {
+        finished_.notify_all();
+      }
+    }
+  }
+
+  void ThreadPool::drain() {
+    bool was_inside = inside_pool_task;
+    inside_pool_task = true;
+    for (;;) {
+      std::size_t index = next_task_.fetch_add(1, std::memory_order_relaxed);
+      if (index >= task_count_) {
+        break;
+      }
+      try {
+        (*task_)(index);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!error_) {
+          error_ = std::current_exception();
+        }
+      }
+    }
+    inside_pool_task = was_inside;
+  }
+
+  double parallel::sum(const double* data, std::size_t count, const ParallelOptions& options) {
+    auto partials = map_chunks<double>(count, kChunkSize, options,
+                                       [data](std::size_t begin, std::size_t end) {
+                                         return kernels::sum(data + begin, end - begin);
+                                       });
+    double total = 0.0;
+    for (double partial : partials) {
+      total += partial;
+    }
+    return total;
+  }
+
+}  // namespace student_manager
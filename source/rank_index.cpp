@@ -0,0 +1,156 @@
+/**
+ * @file rank_index.cpp
+ * @brief 成绩排名索引（树堆）的实现
+ */
+
+#include "student_manager/rank_index.h"
+
+namespace student_manager {
+
+  void RankIndex::pull(std::uint32_t node) noexcept {
+    Node& n = nodes_[node];
+    n.size = 1 + subtree_size(n.left) + subtree_size(n.right);
+  }
+
+  std::uint32_t RankIndex::next_priority() noexcept {
+    // splitmix64：简单、快速，分布足够均匀
+    std::uint64_t z = (random_state_ += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return static_cast<std::uint32_t>(z ^ (z >> 31));
+  }
+
+  void RankIndex::split(std::uint32_t tree, double score, std::uint32_t slot, std::uint32_t& less,
+                        std::uint32_t& rest) noexcept {
+    if (tree == kNil) {
+      less = kNil;
+      rest = kNil;
+      return;
+    }
+    if (key_less(tree, score, slot)) {
+      split(nodes_[tree].right, score, slot, nodes_[tree].right, rest);
+      less = tree;
+    } else {
+      split(nodes_[tree].left, score, slot, less, nodes_[tree].left);
+      rest = tree;
+    }
+    pull(tree);
+  }
+
+  std::uint32_t RankIndex::merge(std::uint32_t left, std::uint32_t right) noexcept {
+    if (left == kNil) {
+      return right;
+    }
+    if (right == kNil) {
+      return left;
+    }
+    if (nodes_[left].priority >= nodes_[right].priority) {
+      nodes_[left].right = merge(nodes_[left].right, right);
+      pull(left);
+      return left;
+    }
+    nodes_[right].left = merge(left, nodes_[right].left);
+    pull(right);
+    return right;
+  }
+
+  void RankIndex::insert(std::uint32_t slot, double score) {
+    if (slot >= nodes_.size()) {
+      nodes_.resize(static_cast<std::size_t>(slot) + 1);
+    }
+    Node& node = nodes_[slot];
+    node.score = score;
+    node.priority = next_priority();
+    node.left = kNil;
+    node.right = kNil;
+    node.size = 1;
+
+    std::uint32_t less;
+    std::uint32_t rest;
+    split(root_, score, slot, less, rest);
+    root_ = merge(merge(less, slot), rest);
+    ++size_;
+  }
+
+  void RankIndex::erase(std::uint32_t slot) {
+    double score = nodes_[slot].score;
+    std::uint32_t less;
+    std::uint32_t rest;
+    split(root_, score, slot, less, rest);
+    // rest 中最小的键就是要删除的节点：再按"下一个槽位"拆一次把它单独分出来
+    std::uint32_t target;
+    std::uint32_t greater;
+    split(rest, score, slot + 1, target, greater);
+    root_ = merge(less, greater);
+    --size_;
+  }
+
+  std::size_t RankIndex::count_greater(double score) const noexcept {
+    std::size_t count = 0;
+    std::uint32_t node = root_;
+    while (node != kNil) {
+      const Node& n = nodes_[node];
+      if (n.score > score) {
+        count += 1 + subtree_size(n.right);
+        node = n.left;
+      } else {
+        node = n.right;
+      }
+    }
+    return count;
+  }
+
+  std::uint32_t RankIndex::kth_largest(std::size_t k) const noexcept {
+    std::uint32_t node = root_;
+    while (node != kNil) {
+      const Node& n = nodes_[node];
+      std::size_t right_size = subtree_size(n.right);
+      if (k < right_size) {
+        node = n.right;
+      } else if (k == right_size) {
+        return node;
+      } else {
+        k -= right_size + 1;
+        node = n.left;
+      }
+    }
+    return kNil;
+  }
+
+  std::vector<std::uint32_t> RankIndex::top(std::size_t k) const {
+    std::vector<std::uint32_t> result;
+    std::vector<std::uint32_t> stack;
+    std::uint32_t node = root_;
+    // 反向中序遍历（右 -> 根 -> 左），遍历到 k 个节点就停止
+    while (result.size() < k && (node != kNil || !stack.empty())) {
+      while (node != kNil) {
+        stack.push_back(node);
+        node = nodes_[node].right;
+      }
+      node = stack.back();
+      stack.pop_back();
+      result.push_back(node);
+      node = nodes_[node].left;
+    }
+    return result;
+  }
+
+  std::vector<std::uint32_t> RankIndex::bottom(std::size_t k) const {
+    std::vector<std::uint32_t> result;
+    std::vector<std::uint32_t> stack;
+    std::uint32_t node = root_;
+    // 中序遍历（左 -> 根 -> 右），遍历到 k 个节点就停止
+    while (result.size() < k && (node != kNil || !stack.empty())) {
+      while (node != kNil) {
+        stack.push_back(node);
+        node = nodes_[node].left;
+      }
+      node = stack.back();
+      stack.pop_back();
+      result.push_back(node);
+      node = nodes_[node].right;
+    }
+    return result;
+  }
+
+}  // namespace student_manager
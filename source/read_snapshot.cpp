@@ -0,0 +1,207 @@
+/**
+ * @file read_snapshot.cpp
+ * @brief 只读快照的实现
+ */
+
+#include "student_manager/read_snapshot.h"
+
+#include <algorithm>  // std::min
+#include <atomic>     // std::atomic_load, std::atomic_store
+#include <utility>    // std::move
+
+#include "student_manager/score_kernels.h"
+#include "student_manager/student_manager.h"
+
+namespace student_manager {
+
+  namespace {
+
+    std::shared_ptr<const ReadSnapshot::RowBlock> build_rows(const std::vector<Student>& students,
+                                                             std::size_t begin, std::size_t end) {
+      auto rows = std::make_shared<ReadSnapshot::RowBlock>();
+      rows->names.reserve(end - begin);
+      rows->ids.reserve(end - begin);
+      for (std::size_t row = begin; row < end; ++row) {
+        // 拷贝出的字符串独立于管理器的字符串区，管理器整理或销毁字符串区都不影响快照
+        rows->names.emplace_back(students[row].get_name());
+        rows->ids.emplace_back(students[row].get_id());
+      }
+      return rows;
+    }
+
+    std::shared_ptr<const ReadSnapshot::Chunk> build_chunk(
+        std::shared_ptr<const ReadSnapshot::RowBlock> rows, const std::vector<double>& scores,
+        std::size_t begin, std::size_t end) {
+      auto chunk = std::make_shared<ReadSnapshot::Chunk>();
+      chunk->rows = std::move(rows);
+      chunk->scores.assign(scores.begin() + static_cast<std::ptrdiff_t>(begin),
+                           scores.begin() + static_cast<std::ptrdiff_t>(end));
+      if (!chunk->scores.empty()) {
+        chunk->sum = kernels::sum(chunk->scores.data(), chunk->scores.size());
+        chunk->min = kernels::min(chunk->scores.data(), chunk->scores.size());
+        chunk->max = kernels::max(chunk->scores.data(), chunk->scores.size());
+      }
+      return chunk;
+    }
+
+  }  // namespace
+
+  // ==================== ReadSnapshot ====================
+
+  ReadSnapshot::ReadSnapshot(ChunkTable chunks, std::size_t rows, std::uint64_t version)
+      : chunks_(std::move(chunks)), rows_(rows), version_(version) {}
+
+  double ReadSnapshot::calculate_average_score() const noexcept {
+    if (rows_ == 0) {
+      return 0.0;
+    }
+    double total = 0.0;
+    for (const auto& chunk : chunks_) {
+      total += chunk->sum;
+    }
+    return total / static_cast<double>(rows_);
+  }
+
+  std::optional<double> ReadSnapshot::get_max_score() const noexcept {
+    if (rows_ == 0) {
+      return std::nullopt;
+    }
+    double result = chunks_.front()->max;
+    for (const auto& chunk : chunks_) {
+      result = chunk->max > result ? chunk->max : result;
+    }
+    return result;
+  }
+
+  std::optional<double> ReadSnapshot::get_min_score() const noexcept {
+    if (rows_ == 0) {
+      return std::nullopt;
+    }
+    double result = chunks_.front()->min;
+    for (const auto& chunk : chunks_) {
+      result = chunk->min < result ? chunk->min : result;
+    }
+    return result;
+  }
+
+  ScoreStatistics ReadSnapshot::compute_statistics() const {
+    std::vector<double> scores;
+    scores.reserve(rows_);
+    for (const auto& chunk : chunks_) {
+      scores.insert(scores.end(), chunk->scores.begin(), chunk->scores.end());
+    }
+    return compute_score_statistics(scores.data(), scores.size());
+  }
+
+  std::vector<Student> ReadSnapshot::get_all_students() const {
+    std::vector<Student> students;
+    students.reserve(rows_);
+    for_each([&](std::string_view name, std::string_view id, double score) {
+      students.emplace_back(name, id, score);
+    });
+    return students;
+  }
+
+  // ==================== ReadSnapshotPublisher ====================
+
+  ReadSnapshotPublisher::ReadSnapshotPublisher(const ReadSnapshotPublisher& other)
+      : publish_every_(other.publish_every_),
+        pending_changes_(other.pending_changes_),
+        version_(other.version_),
+        chunks_(other.chunks_),
+        dirty_(other.dirty_),
+        all_dirty_(other.all_dirty_),
+        published_(other.current()) {}
+
+  ReadSnapshotPublisher::ReadSnapshotPublisher(ReadSnapshotPublisher&& other) noexcept
+      : publish_every_(other.publish_every_),
+        pending_changes_(other.pending_changes_),
+        version_(other.version_),
+        chunks_(std::move(other.chunks_)),
+        dirty_(std::move(other.dirty_)),
+        all_dirty_(other.all_dirty_),
+        published_(std::atomic_exchange(&other.published_, {})) {
+    other.all_dirty_ = true;
+  }
+
+  ReadSnapshotPublisher& ReadSnapshotPublisher::operator=(const ReadSnapshotPublisher& other) {
+    if (this != &other) {
+      publish_every_ = other.publish_every_;
+      pending_changes_ = other.pending_changes_;
+      version_ = other.version_;
+      chunks_ = other.chunks_;
+      dirty_ = other.dirty_;
+      all_dirty_ = other.all_dirty_;
+      std::atomic_store(&published_, other.current());
+    }
+    return *this;
+  }
+
+  ReadSnapshotPublisher& ReadSnapshotPublisher::operator=(ReadSnapshotPublisher&& other) noexcept {
+    if (this != &other) {
+      publish_every_ = other.publish_every_;
+      pending_changes_ = other.pending_changes_;
+      version_ = other.version_;
+      chunks_ = std::move(other.chunks_);
+      dirty_ = std::move(other.dirty_);
+      all_dirty_ = other.all_dirty_;
+      other.all_dirty_ = true;
+      std::atomic_store(&published_, std::atomic_exchange(&other.published_, {}));
+    }
+    return *this;
+  }
+
+  void ReadSnapshotPublisher::mark(std::size_t row, std::uint8_t state) {
+    std::size_t chunk = row / ReadSnapshot::kChunkRows;
+    if (chunk >= dirty_.size()) {
+      dirty_.resize(chunk + 1, kClean);
+    }
+    dirty_[chunk] = std::max(dirty_[chunk], state);
+  }
+
+  void ReadSnapshotPublisher::mark_row(std::size_t row) { mark(row, kRowsDirty); }
+
+  void ReadSnapshotPublisher::mark_score(std::size_t row) { mark(row, kScoresDirty); }
+
+  void ReadSnapshotPublisher::mark_all() noexcept { all_dirty_ = true; }
+
+  void ReadSnapshotPublisher::publish(const std::vector<Student>& students,
+                                      const std::vector<double>& scores) {
+    constexpr std::size_t kRows = ReadSnapshot::kChunkRows;
+    const std::size_t rows = students.size();
+    const std::size_t chunk_count = (rows + kRows - 1) / kRows;
+    if (all_dirty_) {
+      chunks_.clear();
+    }
+    dirty_.resize(std::max(dirty_.size(), chunk_count), kClean);
+
+    ReadSnapshot::ChunkTable table;
+    table.reserve(chunk_count);
+    for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+      std::size_t begin = chunk * kRows;
+      std::size_t end = std::min(begin + kRows, rows);
+      bool existing = chunk < chunks_.size();
+      if (existing && dirty_[chunk] == kClean && chunks_[chunk]->scores.size() == end - begin) {
+        table.push_back(chunks_[chunk]);  // 与上一个版本共享
+      } else if (existing && dirty_[chunk] == kScoresDirty
+                 && chunks_[chunk]->scores.size() == end - begin) {
+        table.push_back(build_chunk(chunks_[chunk]->rows, scores, begin, end));
+      } else {
+        table.push_back(build_chunk(build_rows(students, begin, end), scores, begin, end));
+      }
+    }
+
+    chunks_ = table;
+    dirty_.assign(chunk_count, kClean);
+    all_dirty_ = false;
+    pending_changes_ = 0;
+    std::shared_ptr<const ReadSnapshot> snapshot
+        = std::make_shared<ReadSnapshot>(std::move(table), rows, ++version_);
+    std::atomic_store(&published_, std::move(snapshot));
+  }
+
+  std::shared_ptr<const ReadSnapshot> ReadSnapshotPublisher::current() const {
+    return std::atomic_load(&published_);
+  }
+
+}  // namespace student_manager
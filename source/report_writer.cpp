@@ -0,0 +1,240 @@
+/**
+ * @file report_writer.cpp
+ * @brief 学生列表报表的实现
+ */
+
+#include "student_manager/report_writer.h"
+
+#include <algorithm>     // std::reverse, std::max, std::min, std::clamp
+#include <charconv>      // std::to_chars
+#include <cstdio>        // std::snprintf
+#include <numeric>       // std::iota
+#include <ostream>       // std::ostream
+#include <system_error>  // std::errc
+
+#include "student_manager/student_manager.h"
+
+namespace student_manager {
+
+  namespace {
+
+    /// 列与列之间的空格数
+    constexpr std::size_t kColumnGap = 2;
+
+    /// 成绩最多保留的小数位数
+    constexpr int kMaxPrecision = 6;
+
+    constexpr std::string_view kNameLabel = "姓名";
+    constexpr std::string_view kIdLabel = "学号";
+    constexpr std::string_view kScoreLabel = "成绩";
+
+    /// 码点在终端中占的列数（Unicode East Asian Width 为 W/F 的常用区间算 2 列）
+    std::size_t code_point_width(char32_t c) noexcept {
+      if ((c >= 0x0300 && c <= 0x036F) || (c >= 0x200B && c <= 0x200F)) {
+        return 0;  // 组合附加符号、零宽字符
+      }
+      bool wide = (c >= 0x1100 && c <= 0x115F)                     // 谚文字母
+                  || (c >= 0x2E80 && c <= 0xA4CF && c != 0x303F)  // 中日韩部首、标点、汉字、彝文
+                  || (c >= 0xAC00 && c <= 0xD7A3)                 // 谚文音节
+                  || (c >= 0xF900 && c <= 0xFAFF)                 // 中日韩兼容汉字
+                  || (c >= 0xFE30 && c <= 0xFE4F)                 // 中日韩兼容形式
+                  || (c >= 0xFF00 && c <= 0xFF60)                 // 全角 ASCII
+                  || (c >= 0xFFE0 && c <= 0xFFE6)                 // 全角符号
+                  || (c >= 0x1F300 && c <= 0x1F64F)               // 表情符号
+                  || (c >= 0x1F900 && c <= 0x1F9FF)               // 补充表情符号
+                  || (c >= 0x20000 && c <= 0x3FFFD);              // 扩展汉字
+      return wide ? 2 : 1;
+    }
+
+    std::uint16_t clamp_width(std::size_t width) noexcept {
+      return static_cast<std::uint16_t>(std::min<std::size_t>(width, 0xFFFF));
+    }
+
+  }  // namespace
+
+  std::size_t ReportWriter::display_width(std::string_view text) noexcept {
+    std::size_t width = 0;
+    std::size_t i = 0;
+    while (i < text.size()) {
+      auto lead = static_cast<unsigned char>(text[i]);
+      if (lead < 0x80) {
+        ++width;
+        ++i;
+        continue;
+      }
+      std::size_t length = lead >= 0xF8   ? 0
+                           : lead >= 0xF0 ? 4
+                           : lead >= 0xE0 ? 3
+                           : lead >= 0xC0 ? 2
+                                          : 0;
+      if (length == 0 || i + length > text.size()) {
+        ++width;  // 不合法的字节
+        ++i;
+        continue;
+      }
+      char32_t c = lead & (0x7F >> length);
+      bool valid = true;
+      for (std::size_t k = 1; k < length; ++k) {
+        auto next = static_cast<unsigned char>(text[i + k]);
+        valid = valid && (next & 0xC0) == 0x80;
+        c = (c << 6) | (next & 0x3F);
+      }
+      if (!valid) {
+        ++width;
+        ++i;
+        continue;
+      }
+      width += code_point_width(c);
+      i += length;
+    }
+    return width;
+  }
+
+  ReportWriter::ReportWriter(const StudentManager& manager, const ReportOptions& options)
+      : manager_(manager), options_(options) {
+    options_.score_precision = std::clamp(options_.score_precision, 0, kMaxPrecision);
+
+    const auto& students = manager_.get_all_students();
+    order_.resize(students.size());
+    sort_rows();
+
+    name_column_ = display_width(kNameLabel);
+    id_column_ = display_width(kIdLabel);
+    name_widths_.reserve(students.size());
+    id_widths_.reserve(students.size());
+    for (const Student& student : students) {
+      name_widths_.push_back(clamp_width(display_width(student.get_name())));
+      id_widths_.push_back(clamp_width(display_width(student.get_id())));
+      name_column_ = std::max<std::size_t>(name_column_, name_widths_.back());
+      id_column_ = std::max<std::size_t>(id_column_, id_widths_.back());
+    }
+    // 成绩在 0-100 之间，最宽是 "100.00" 这样的形式
+    std::size_t score_width
+        = 3 + (options_.score_precision > 0 ? 1 + options_.score_precision : 0);
+    score_column_ = std::max(score_width, display_width(kScoreLabel));
+
+    buffer_.reserve(kFlushSize + 4096);
+  }
+
+  void ReportWriter::sort_rows() {
+    switch (options_.order) {
+      case ReportOrder::insertion:
+        std::iota(order_.begin(), order_.end(), std::uint32_t{0});
+        break;
+      case ReportOrder::by_id:
+        order_ = manager_.sorted_by(SortKey::id).rows();
+        break;
+      case ReportOrder::by_name:
+        order_ = manager_.sorted_by(SortKey::name).rows();
+        break;
+      case ReportOrder::by_score:
+        order_ = manager_.sorted_by(SortKey::score).rows();
+        break;
+    }
+    if (options_.descending) {
+      std::reverse(order_.begin(), order_.end());
+    }
+  }
+
+  std::size_t ReportWriter::page_count() const noexcept {
+    if (options_.page_size == 0 || order_.empty()) {
+      return 1;
+    }
+    return (order_.size() + options_.page_size - 1) / options_.page_size;
+  }
+
+  void ReportWriter::write_page(std::size_t page, std::ostream& out) {
+    append_page(page, out);
+    flush(out);
+  }
+
+  void ReportWriter::write_all(std::ostream& out) {
+    std::size_t pages = page_count();
+    for (std::size_t page = 0; page < pages; ++page) {
+      if (page > 0) {
+        buffer_.push_back('\n');
+      }
+      append_page(page, out);
+    }
+    flush(out);
+  }
+
+  void ReportWriter::append_page(std::size_t page, std::ostream& out) {
+    append_header();
+    std::size_t first = 0;
+    std::size_t last = order_.size();
+    if (options_.page_size != 0) {
+      first = std::min(page * options_.page_size, order_.size());
+      last = std::min(first + options_.page_size, order_.size());
+    }
+    for (std::size_t row = first; row < last; ++row) {
+      append_row(order_[row]);
+      flush_if_full(out);
+    }
+    if (options_.page_size != 0 && page < page_count()) {
+      char text[64];
+      int length = std::snprintf(text, sizeof(text), "第 %zu/%zu 页\n", page + 1, page_count());
+      buffer_.append(text, static_cast<std::size_t>(length));
+    }
+  }
+
+  void ReportWriter::append_header() {
+    append_padded(kNameLabel, display_width(kNameLabel), name_column_ + kColumnGap);
+    append_padded(kIdLabel, display_width(kIdLabel), id_column_ + kColumnGap);
+    buffer_.append(score_column_ - display_width(kScoreLabel), ' ');
+    buffer_.append(kScoreLabel);
+    buffer_.push_back('\n');
+    buffer_.append(name_column_ + id_column_ + score_column_ + 2 * kColumnGap, '-');
+    buffer_.push_back('\n');
+  }
+
+  void ReportWriter::append_row(std::uint32_t index) {
+    const Student& student = manager_.get_all_students()[index];
+    append_padded(student.get_name(), name_widths_[index], name_column_ + kColumnGap);
+    append_padded(student.get_id(), id_widths_[index], id_column_ + kColumnGap);
+    append_score(manager_.get_scores()[index]);
+    buffer_.push_back('\n');
+  }
+
+  void ReportWriter::append_padded(std::string_view text, std::size_t width, std::size_t column) {
+    buffer_.append(text);
+    if (width < column) {
+      buffer_.append(column - width, ' ');
+    }
+  }
+
+  void ReportWriter::append_score(double score) {
+    char text[32];
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    auto result = std::to_chars(text, text + sizeof(text), score, std::chars_format::fixed,
+                                options_.score_precision);
+    if (result.ec != std::errc()) {
+      // 绝对值很大的成绩写成定点数放不下，改用最短的科学计数法
+      result = std::to_chars(text, text + sizeof(text), score, std::chars_format::general);
+    }
+    auto length = static_cast<std::size_t>(result.ptr - text);
+#else
+    int written = std::snprintf(text, sizeof(text), "%.*f", options_.score_precision, score);
+    if (written < 0 || static_cast<std::size_t>(written) >= sizeof(text)) {
+      written = std::snprintf(text, sizeof(text), "%g", score);
+    }
+    auto length = static_cast<std::size_t>(written);
+#endif
+    if (length < score_column_) {
+      buffer_.append(score_column_ - length, ' ');  // 成绩右对齐
+    }
+    buffer_.append(text, length);
+  }
+
+  void ReportWriter::flush_if_full(std::ostream& out) {
+    if (buffer_.size() >= kFlushSize) {
+      flush(out);
+    }
+  }
+
+  void ReportWriter::flush(std::ostream& out) {
+    out.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    buffer_.clear();
+  }
+
+}  // namespace student_manager
@@ -0,0 +1,125 @@
+/**
+ * @file score_histogram.cpp
+ * @brief 成绩直方图（树状数组）的实现
+ */
+
+#include "student_manager/score_histogram.h"
+
+#include <algorithm>  // std::fill
+#include <cmath>      // std::floor, std::ceil
+
+namespace student_manager {
+
+  namespace {
+    /// 把分数换算为桶编号时允许的误差，例如 69.99 * 100 = 6998.999999999999
+    constexpr double kEpsilon = 1e-6;
+
+    /// 不超过 n 的最大 2 的幂
+    std::size_t highest_power_of_two(std::size_t n) noexcept {
+      std::size_t power = 1;
+      while (power * 2 <= n) {
+        power *= 2;
+      }
+      return power;
+    }
+  }  // namespace
+
+  std::size_t ScoreHistogram::bucket_of(double score) noexcept {
+    if (!(score >= 0.0 && score <= 100.0)) {  // 同时排除 NaN
+      return kBucketCount;
+    }
+    auto bucket = static_cast<std::size_t>(std::floor(score * 100.0 + kEpsilon));
+    return bucket < kBucketCount ? bucket : kBucketCount - 1;
+  }
+
+  void ScoreHistogram::clear() noexcept {
+    std::fill(tree_.begin(), tree_.end(), 0u);
+    total_ = 0;
+    out_of_range_ = 0;
+  }
+
+  void ScoreHistogram::change(double score, int delta) noexcept {
+    total_ += static_cast<std::size_t>(static_cast<std::ptrdiff_t>(delta));
+    std::size_t bucket = bucket_of(score);
+    if (bucket == kBucketCount) {
+      out_of_range_ += static_cast<std::size_t>(static_cast<std::ptrdiff_t>(delta));
+      return;
+    }
+    for (std::size_t i = bucket + 1; i <= kBucketCount; i += i & (~i + 1)) {
+      tree_[i] += static_cast<std::uint32_t>(delta);
+    }
+  }
+
+  std::size_t ScoreHistogram::prefix(std::size_t bucket) const noexcept {
+    std::size_t sum = 0;
+    for (std::size_t i = bucket + 1; i > 0; i -= i & (~i + 1)) {
+      sum += tree_[i];
+    }
+    return sum;
+  }
+
+  std::size_t ScoreHistogram::count_in_range(double low, double high) const noexcept {
+    if (!(low <= high) || high < 0.0 || low > 100.0) {
+      return 0;
+    }
+    double first = low <= 0.0 ? 0.0 : std::ceil(low * 100.0 - kEpsilon);
+    double last = high >= 100.0 ? 100.0 * 100.0 : std::floor(high * 100.0 + kEpsilon);
+    if (first > last) {
+      return 0;
+    }
+    auto first_bucket = static_cast<std::size_t>(first);
+    auto last_bucket = static_cast<std::size_t>(last);
+    std::size_t below = first_bucket == 0 ? 0 : prefix(first_bucket - 1);
+    return prefix(last_bucket) - below;
+  }
+
+  std::size_t ScoreHistogram::count_below(double score) const noexcept {
+    if (!(score > 0.0)) {
+      return 0;
+    }
+    if (score > 100.0) {
+      return total_ - out_of_range_;
+    }
+    auto first = static_cast<std::size_t>(std::ceil(score * 100.0 - kEpsilon));
+    return first == 0 ? 0 : prefix(first - 1);
+  }
+
+  std::vector<std::size_t> ScoreHistogram::distribution(
+      const std::vector<double>& boundaries) const {
+    std::vector<std::size_t> counts;
+    if (boundaries.size() < 2) {
+      return counts;
+    }
+    counts.reserve(boundaries.size() - 1);
+    for (std::size_t i = 0; i + 2 < boundaries.size(); ++i) {
+      counts.push_back(count_below(boundaries[i + 1]) - count_below(boundaries[i]));
+    }
+    counts.push_back(count_in_range(boundaries[boundaries.size() - 2], boundaries.back()));
+    return counts;
+  }
+
+  double ScoreHistogram::percentile(double percentile) const noexcept {
+    std::size_t bucketed = total_ - out_of_range_;
+    if (bucketed == 0) {
+      return -1.0;
+    }
+    // 最近秩法：目标是第 ceil(p / 100 * n) 个成绩（至少为第 1 个）
+    double p = percentile < 0.0 ? 0.0 : (percentile > 100.0 ? 100.0 : percentile);
+    auto rank = static_cast<std::size_t>(std::ceil(p / 100.0 * static_cast<double>(bucketed)));
+    rank = rank == 0 ? 1 : rank;
+
+    // 在树状数组上二分下降：找到前缀和小于 rank 的最长前缀
+    std::size_t position = 0;
+    std::size_t remaining = rank;
+    for (std::size_t step = highest_power_of_two(kBucketCount); step > 0; step /= 2) {
+      std::size_t next = position + step;
+      if (next <= kBucketCount && tree_[next] < remaining) {
+        position = next;
+        remaining -= tree_[next];
+      }
+    }
+    // position 是前缀和小于 rank 的桶数，下一个桶（编号 position）就是答案
+    return static_cast<double>(position) / 100.0;
+  }
+
+}  // namespace student_manager
@@ -0,0 +1,471 @@
+/**
+ * @file score_kernels.cpp
+ * @brief 成绩列统计内核的实现与运行时指令集分派
+ */
+
+#include "student_manager/score_kernels.h"
+
+#include <algorithm>  // std::min, std::fill
+#include <vector>     // std::vector
+
+#if defined(__x86_64__) || defined(_M_X64)
+#  define STUDENT_MANAGER_X86_64 1
+#  include <immintrin.h>
+#  if defined(_MSC_VER) && !defined(__clang__)
+#    include <intrin.h>
+#  endif
+#endif
+
+// GCC/Clang 需要用 target 属性单独为函数开启 AVX2；MSVC 允许在任意函数中使用这些指令
+#if defined(STUDENT_MANAGER_X86_64) && (defined(__GNUC__) || defined(__clang__))
+#  define STUDENT_MANAGER_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#  define STUDENT_MANAGER_TARGET_AVX2
+#endif
+
+namespace student_manager::kernels {
+
+  namespace {
+
+    // ==================== 标量实现 ====================
+    // 8 路交错累加：lanes[j] 累加下标 i + j 的元素，最后按固定顺序合并。
+    // 向量实现的寄存器布局与此完全对应，保证三种实现的加法顺序一致。
+
+    double sum_scalar(const double* data, std::size_t count) noexcept {
+      double lanes[8] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+      std::size_t i = 0;
+      for (; i + 8 <= count; i += 8) {
+        for (std::size_t j = 0; j < 8; ++j) {
+          lanes[j] += data[i + j];
+        }
+      }
+      double v0 = lanes[0] + lanes[4];
+      double v1 = lanes[1] + lanes[5];
+      double v2 = lanes[2] + lanes[6];
+      double v3 = lanes[3] + lanes[7];
+      double total = (v0 + v2) + (v1 + v3);
+      for (; i < count; ++i) {
+        total += data[i];
+      }
+      return total;
+    }
+
+    double min_scalar(const double* data, std::size_t count) noexcept {
+      double result = data[0];
+      for (std::size_t i = 1; i < count; ++i) {
+        result = data[i] < result ? data[i] : result;
+      }
+      return result;
+    }
+
+    double max_scalar(const double* data, std::size_t count) noexcept {
+      double result = data[0];
+      for (std::size_t i = 1; i < count; ++i) {
+        result = data[i] > result ? data[i] : result;
+      }
+      return result;
+    }
+
+    // 定点成绩：整数加法满足结合律，各实现不需要保持相同的加法顺序
+
+    std::uint64_t sum_scalar(const std::uint16_t* data, std::size_t count) noexcept {
+      std::uint64_t total = 0;
+      for (std::size_t i = 0; i < count; ++i) {
+        total += data[i];
+      }
+      return total;
+    }
+
+    std::uint16_t min_scalar(const std::uint16_t* data, std::size_t count) noexcept {
+      std::uint16_t result = data[0];
+      for (std::size_t i = 1; i < count; ++i) {
+        result = data[i] < result ? data[i] : result;
+      }
+      return result;
+    }
+
+    std::uint16_t max_scalar(const std::uint16_t* data, std::size_t count) noexcept {
+      std::uint16_t result = data[0];
+      for (std::size_t i = 1; i < count; ++i) {
+        result = data[i] > result ? data[i] : result;
+      }
+      return result;
+    }
+
+#if defined(STUDENT_MANAGER_X86_64)
+
+    // 16 位成绩零扩展为 32 位后累加：每个 32 位累加器每轮只加一个不超过 65535 的值，
+    // 累加 65536 轮也不会溢出，之后再合并到 64 位的总和
+    constexpr std::size_t kWideningRounds = 65536;
+
+    /// 两个值中较大（Max）或较小的一个
+    template <bool Max> constexpr std::uint16_t pick(std::uint16_t a, std::uint16_t b) noexcept {
+      return Max ? (a > b ? a : b) : (a < b ? a : b);
+    }
+
+    // ==================== SSE2 实现 ====================
+    // 4 个寄存器 × 2 个 double：a0 = (l0, l1), a1 = (l2, l3), a2 = (l4, l5), a3 = (l6, l7)
+
+    double sum_sse2(const double* data, std::size_t count) noexcept {
+      __m128d a0 = _mm_setzero_pd();
+      __m128d a1 = _mm_setzero_pd();
+      __m128d a2 = _mm_setzero_pd();
+      __m128d a3 = _mm_setzero_pd();
+      std::size_t i = 0;
+      for (; i + 8 <= count; i += 8) {
+        a0 = _mm_add_pd(a0, _mm_loadu_pd(data + i));
+        a1 = _mm_add_pd(a1, _mm_loadu_pd(data + i + 2));
+        a2 = _mm_add_pd(a2, _mm_loadu_pd(data + i + 4));
+        a3 = _mm_add_pd(a3, _mm_loadu_pd(data + i + 6));
+      }
+      __m128d low = _mm_add_pd(a0, a2);   // (v0, v1)
+      __m128d high = _mm_add_pd(a1, a3);  // (v2, v3)
+      __m128d pair = _mm_add_pd(low, high);
+      double total = _mm_cvtsd_f64(pair) + _mm_cvtsd_f64(_mm_unpackhi_pd(pair, pair));
+      for (; i < count; ++i) {
+        total += data[i];
+      }
+      return total;
+    }
+
+    double min_sse2(const double* data, std::size_t count) noexcept {
+      __m128d a0 = _mm_set1_pd(data[0]);
+      __m128d a1 = a0;
+      std::size_t i = 0;
+      for (; i + 4 <= count; i += 4) {
+        a0 = _mm_min_pd(a0, _mm_loadu_pd(data + i));
+        a1 = _mm_min_pd(a1, _mm_loadu_pd(data + i + 2));
+      }
+      __m128d m = _mm_min_pd(a0, a1);
+      m = _mm_min_sd(m, _mm_unpackhi_pd(m, m));
+      double result = _mm_cvtsd_f64(m);
+      for (; i < count; ++i) {
+        result = data[i] < result ? data[i] : result;
+      }
+      return result;
+    }
+
+    double max_sse2(const double* data, std::size_t count) noexcept {
+      __m128d a0 = _mm_set1_pd(data[0]);
+      __m128d a1 = a0;
+      std::size_t i = 0;
+      for (; i + 4 <= count; i += 4) {
+        a0 = _mm_max_pd(a0, _mm_loadu_pd(data + i));
+        a1 = _mm_max_pd(a1, _mm_loadu_pd(data + i + 2));
+      }
+      __m128d m = _mm_max_pd(a0, a1);
+      m = _mm_max_sd(m, _mm_unpackhi_pd(m, m));
+      double result = _mm_cvtsd_f64(m);
+      for (; i < count; ++i) {
+        result = data[i] > result ? data[i] : result;
+      }
+      return result;
+    }
+
+    std::uint64_t sum_sse2(const std::uint16_t* data, std::size_t count) noexcept {
+      const __m128i zero = _mm_setzero_si128();
+      __m128i total = zero;  // 2 个 64 位累加器
+      std::size_t i = 0;
+      while (i + 8 <= count) {
+        std::size_t end = std::min(count, i + 8 * kWideningRounds);
+        __m128i low = zero;
+        __m128i high = zero;
+        for (; i + 8 <= end; i += 8) {
+          __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+          low = _mm_add_epi32(low, _mm_unpacklo_epi16(v, zero));
+          high = _mm_add_epi32(high, _mm_unpackhi_epi16(v, zero));
+        }
+        total = _mm_add_epi64(total, _mm_unpacklo_epi32(low, zero));
+        total = _mm_add_epi64(total, _mm_unpackhi_epi32(low, zero));
+        total = _mm_add_epi64(total, _mm_unpacklo_epi32(high, zero));
+        total = _mm_add_epi64(total, _mm_unpackhi_epi32(high, zero));
+      }
+      alignas(16) std::uint64_t lanes[2];
+      _mm_store_si128(reinterpret_cast<__m128i*>(lanes), total);
+      return lanes[0] + lanes[1] + sum_scalar(data + i, count - i);
+    }
+
+    // SSE2 只有有符号的 16 位比较：先翻转最高位，把无符号数映射为保持大小顺序的有符号数
+    template <bool Max>
+    std::uint16_t extreme_sse2(const std::uint16_t* data, std::size_t count) noexcept {
+      const __m128i flip = _mm_set1_epi16(static_cast<short>(0x8000));
+      __m128i best = _mm_xor_si128(_mm_set1_epi16(static_cast<short>(data[0])), flip);
+      std::size_t i = 0;
+      for (; i + 8 <= count; i += 8) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        v = _mm_xor_si128(v, flip);
+        best = Max ? _mm_max_epi16(best, v) : _mm_min_epi16(best, v);
+      }
+      alignas(16) std::uint16_t lanes[8];
+      _mm_store_si128(reinterpret_cast<__m128i*>(lanes), _mm_xor_si128(best, flip));
+      std::uint16_t result = lanes[0];
+      for (std::uint16_t lane : lanes) {
+        result = pick<Max>(result, lane);
+      }
+      for (; i < count; ++i) {
+        result = pick<Max>(result, data[i]);
+      }
+      return result;
+    }
+
+    // ==================== AVX2 实现 ====================
+    // 2 个寄存器 × 4 个 double：a0 = (l0, l1, l2, l3), a1 = (l4, l5, l6, l7)
+
+    STUDENT_MANAGER_TARGET_AVX2 double sum_avx2(const double* data, std::size_t count) noexcept {
+      __m256d a0 = _mm256_setzero_pd();
+      __m256d a1 = _mm256_setzero_pd();
+      std::size_t i = 0;
+      for (; i + 8 <= count; i += 8) {
+        a0 = _mm256_add_pd(a0, _mm256_loadu_pd(data + i));
+        a1 = _mm256_add_pd(a1, _mm256_loadu_pd(data + i + 4));
+      }
+      __m256d v = _mm256_add_pd(a0, a1);  // (v0, v1, v2, v3)
+      __m128d pair = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+      double total = _mm_cvtsd_f64(pair) + _mm_cvtsd_f64(_mm_unpackhi_pd(pair, pair));
+      for (; i < count; ++i) {
+        total += data[i];
+      }
+      return total;
+    }
+
+    STUDENT_MANAGER_TARGET_AVX2 double min_avx2(const double* data, std::size_t count) noexcept {
+      __m256d a0 = _mm256_set1_pd(data[0]);
+      __m256d a1 = a0;
+      std::size_t i = 0;
+      for (; i + 8 <= count; i += 8) {
+        a0 = _mm256_min_pd(a0, _mm256_loadu_pd(data + i));
+        a1 = _mm256_min_pd(a1, _mm256_loadu_pd(data + i + 4));
+      }
+      __m256d v = _mm256_min_pd(a0, a1);
+      __m128d m = _mm_min_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+      m = _mm_min_sd(m, _mm_unpackhi_pd(m, m));
+      double result = _mm_cvtsd_f64(m);
+      for (; i < count; ++i) {
+        result = data[i] < result ? data[i] : result;
+      }
+      return result;
+    }
+
+    STUDENT_MANAGER_TARGET_AVX2 double max_avx2(const double* data, std::size_t count) noexcept {
+      __m256d a0 = _mm256_set1_pd(data[0]);
+      __m256d a1 = a0;
+      std::size_t i = 0;
+      for (; i + 8 <= count; i += 8) {
+        a0 = _mm256_max_pd(a0, _mm256_loadu_pd(data + i));
+        a1 = _mm256_max_pd(a1, _mm256_loadu_pd(data + i + 4));
+      }
+      __m256d v = _mm256_max_pd(a0, a1);
+      __m128d m = _mm_max_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+      m = _mm_max_sd(m, _mm_unpackhi_pd(m, m));
+      double result = _mm_cvtsd_f64(m);
+      for (; i < count; ++i) {
+        result = data[i] > result ? data[i] : result;
+      }
+      return result;
+    }
+
+    STUDENT_MANAGER_TARGET_AVX2 std::uint64_t sum_avx2(const std::uint16_t* data,
+                                                       std::size_t count) noexcept {
+      const __m256i zero = _mm256_setzero_si256();
+      __m256i total = zero;  // 4 个 64 位累加器
+      std::size_t i = 0;
+      while (i + 16 <= count) {
+        std::size_t end = std::min(count, i + 16 * kWideningRounds);
+        __m256i low = zero;
+        __m256i high = zero;
+        for (; i + 16 <= end; i += 16) {
+          __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+          low = _mm256_add_epi32(low, _mm256_unpacklo_epi16(v, zero));
+          high = _mm256_add_epi32(high, _mm256_unpackhi_epi16(v, zero));
+        }
+        total = _mm256_add_epi64(total, _mm256_unpacklo_epi32(low, zero));
+        total = _mm256_add_epi64(total, _mm256_unpackhi_epi32(low, zero));
+        total = _mm256_add_epi64(total, _mm256_unpacklo_epi32(high, zero));
+        total = _mm256_add_epi64(total, _mm256_unpackhi_epi32(high, zero));
+      }
+      alignas(32) std::uint64_t lanes[4];
+      _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), total);
+      return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sum_scalar(data + i, count - i);
+    }
+
+    template <bool Max> STUDENT_MANAGER_TARGET_AVX2 std::uint16_t extreme_avx2(
+        const std::uint16_t* data, std::size_t count) noexcept {
+      __m256i best = _mm256_set1_epi16(static_cast<short>(data[0]));
+      std::size_t i = 0;
+      for (; i + 16 <= count; i += 16) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        best = Max ? _mm256_max_epu16(best, v) : _mm256_min_epu16(best, v);
+      }
+      alignas(32) std::uint16_t lanes[16];
+      _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), best);
+      std::uint16_t result = lanes[0];
+      for (std::uint16_t lane : lanes) {
+        result = pick<Max>(result, lane);
+      }
+      for (; i < count; ++i) {
+        result = pick<Max>(result, data[i]);
+      }
+      return result;
+    }
+
+    bool cpu_has_avx2() noexcept {
+#  if defined(_MSC_VER) && !defined(__clang__)
+      int info[4];
+      __cpuid(info, 0);
+      if (info[0] < 7) {
+        return false;
+      }
+      __cpuid(info, 1);
+      bool os_saves_ymm = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0
+                          && (_xgetbv(0) & 0x6) == 0x6;
+      __cpuidex(info, 7, 0);
+      return os_saves_ymm && (info[1] & (1 << 5)) != 0;
+#  else
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx2") != 0;
+#  endif
+    }
+
+#endif  // STUDENT_MANAGER_X86_64
+
+    /// 把请求的级别限制在 CPU 支持的范围内
+    SimdLevel clamp(SimdLevel requested) noexcept {
+      SimdLevel supported = detect_simd_level();
+      return static_cast<int>(requested) > static_cast<int>(supported) ? supported : requested;
+    }
+
+  }  // namespace
+
+  SimdLevel detect_simd_level() noexcept {
+#if defined(STUDENT_MANAGER_X86_64)
+    static const SimdLevel level = cpu_has_avx2() ? SimdLevel::avx2 : SimdLevel::sse2;
+    return level;
+#else
+    return SimdLevel::scalar;
+#endif
+  }
+
+  const char* to_string(SimdLevel level) noexcept {
+    switch (level) {
+      case SimdLevel::avx2:
+        return "avx2";
+      case SimdLevel::sse2:
+        return "sse2";
+      default:
+        return "scalar";
+    }
+  }
+
+  double sum(const double* data, std::size_t count, SimdLevel level) noexcept {
+    switch (clamp(level)) {
+#if defined(STUDENT_MANAGER_X86_64)
+      case SimdLevel::avx2:
+        return sum_avx2(data, count);
+      case SimdLevel::sse2:
+        return sum_sse2(data, count);
+#endif
+      default:
+        return sum_scalar(data, count);
+    }
+  }
+
+  double min(const double* data, std::size_t count, SimdLevel level) noexcept {
+    switch (clamp(level)) {
+#if defined(STUDENT_MANAGER_X86_64)
+      case SimdLevel::avx2:
+        return min_avx2(data, count);
+      case SimdLevel::sse2:
+        return min_sse2(data, count);
+#endif
+      default:
+        return min_scalar(data, count);
+    }
+  }
+
+  double max(const double* data, std::size_t count, SimdLevel level) noexcept {
+    switch (clamp(level)) {
+#if defined(STUDENT_MANAGER_X86_64)
+      case SimdLevel::avx2:
+        return max_avx2(data, count);
+      case SimdLevel::sse2:
+        return max_sse2(data, count);
+#endif
+      default:
+        return max_scalar(data, count);
+    }
+  }
+
+  std::uint64_t sum_fixed(const std::uint16_t* data, std::size_t count, SimdLevel level) noexcept {
+    switch (clamp(level)) {
+#if defined(STUDENT_MANAGER_X86_64)
+      case SimdLevel::avx2:
+        return sum_avx2(data, count);
+      case SimdLevel::sse2:
+        return sum_sse2(data, count);
+#endif
+      default:
+        return sum_scalar(data, count);
+    }
+  }
+
+  std::uint16_t min_fixed(const std::uint16_t* data, std::size_t count, SimdLevel level) noexcept {
+    switch (clamp(level)) {
+#if defined(STUDENT_MANAGER_X86_64)
+      case SimdLevel::avx2:
+        return extreme_avx2<false>(data, count);
+      case SimdLevel::sse2:
+        return extreme_sse2<false>(data, count);
+#endif
+      default:
+        return min_scalar(data, count);
+    }
+  }
+
+  std::uint16_t max_fixed(const std::uint16_t* data, std::size_t count, SimdLevel level) noexcept {
+    switch (clamp(level)) {
+#if defined(STUDENT_MANAGER_X86_64)
+      case SimdLevel::avx2:
+        return extreme_avx2<true>(data, count);
+      case SimdLevel::sse2:
+        return extreme_sse2<true>(data, count);
+#endif
+      default:
+        return max_scalar(data, count);
+    }
+  }
+
+  void histogram(const std::uint16_t* data, std::size_t count, std::uint64_t* counts,
+                 std::size_t bucket_count) {
+    // 4 张 32 位计数表，第 i 个元素计入第 i % 4 张；每段不超过 2^32 - 1 个元素，计数不会溢出
+    constexpr std::size_t kSegment = 0xFFFFFFFFU;
+    std::vector<std::uint32_t> tables(4 * bucket_count);
+    std::uint32_t* t0 = tables.data();
+    std::uint32_t* t1 = t0 + bucket_count;
+    std::uint32_t* t2 = t1 + bucket_count;
+    std::uint32_t* t3 = t2 + bucket_count;
+    auto count_one = [bucket_count](std::uint32_t* table, std::uint16_t value) {
+      if (value < bucket_count) {
+        ++table[value];
+      }
+    };
+
+    std::size_t i = 0;
+    while (i < count) {
+      std::size_t end = count - i > kSegment ? i + kSegment : count;
+      for (; i + 4 <= end; i += 4) {
+        count_one(t0, data[i]);
+        count_one(t1, data[i + 1]);
+        count_one(t2, data[i + 2]);
+        count_one(t3, data[i + 3]);
+      }
+      for (; i < end; ++i) {
+        count_one(t0, data[i]);
+      }
+      for (std::size_t b = 0; b < bucket_count; ++b) {
+        counts[b] += std::uint64_t{t0[b]} + t1[b] + t2[b] + t3[b];
+      }
+      std::fill(tables.begin(), tables.end(), 0U);
+    }
+  }
+
+}  // namespace student_manager::kernels
@@ -0,0 +1,257 @@
+/**
+ * @file score_matrix.cpp
+ * @brief 多科目成绩矩阵的实现
+ */
+
+#include "student_manager/score_matrix.h"
+
+#include <cstddef>  // std::ptrdiff_t
+#include <utility>  // std::move
+
+#include "student_manager/score_kernels.h"
+
+namespace student_manager {
+
+  namespace {
+
+    constexpr std::size_t kWordBits = 64;
+
+    constexpr std::size_t words_for(std::size_t rows) noexcept {
+      return (rows + kWordBits - 1) / kWordBits;
+    }
+
+  }  // namespace
+
+  std::size_t ScoreMatrix::add_subject(std::string_view name, double credits,
+                                       ScoreStorage storage) {
+    Column column;
+    column.name = std::string(name);
+    column.credits = credits;
+    column.storage = storage;
+    if (storage == ScoreStorage::hundredths) {
+      column.fixed.assign(rows_, 0);
+    } else {
+      column.values.assign(rows_, 0.0);
+    }
+    column.valid.assign(words_for(rows_), 0);
+    columns_.push_back(std::move(column));
+    return columns_.size() - 1;
+  }
+
+  void ScoreMatrix::remove_subject(std::size_t subject) {
+    columns_.erase(columns_.begin() + static_cast<std::ptrdiff_t>(subject));
+  }
+
+  std::size_t ScoreMatrix::find_subject(std::string_view name) const noexcept {
+    // 科目通常只有几十个，顺序查找即可
+    for (std::size_t subject = 0; subject < columns_.size(); ++subject) {
+      if (columns_[subject].name == name) {
+        return subject;
+      }
+    }
+    return npos;
+  }
+
+  void ScoreMatrix::copy_subjects_from(const ScoreMatrix& other) {
+    for (const Column& column : other.columns_) {
+      add_subject(column.name, column.credits, column.storage);
+    }
+  }
+
+  void ScoreMatrix::push_row() {
+    for (Column& column : columns_) {
+      if (column.storage == ScoreStorage::hundredths) {
+        column.fixed.push_back(0);
+      } else {
+        column.values.push_back(0.0);
+      }
+      if (rows_ % kWordBits == 0) {
+        column.valid.push_back(0);
+      }
+    }
+    ++rows_;
+  }
+
+  void ScoreMatrix::swap_remove(std::size_t row) noexcept {
+    std::size_t last = rows_ - 1;
+    for (std::size_t subject = 0; subject < columns_.size(); ++subject) {
+      if (has(subject, row)) {
+        unset(subject, row);
+      }
+      if (row != last && has(subject, last)) {
+        set(subject, row, get(subject, last));
+        unset(subject, last);
+      }
+      Column& column = columns_[subject];
+      if (column.storage == ScoreStorage::hundredths) {
+        column.fixed.pop_back();
+      } else {
+        column.values.pop_back();
+      }
+      if (last % kWordBits == 0) {
+        column.valid.pop_back();
+      }
+    }
+    --rows_;
+  }
+
+  void ScoreMatrix::clear_rows() noexcept {
+    for (Column& column : columns_) {
+      column.values.clear();
+      column.fixed.clear();
+      column.valid.clear();
+      column.count = 0;
+    }
+    rows_ = 0;
+  }
+
+  void ScoreMatrix::reserve(std::size_t rows) {
+    for (Column& column : columns_) {
+      if (column.storage == ScoreStorage::hundredths) {
+        column.fixed.reserve(rows);
+      } else {
+        column.values.reserve(rows);
+      }
+      column.valid.reserve(words_for(rows));
+    }
+  }
+
+  void ScoreMatrix::set(std::size_t subject, std::size_t row, double score) noexcept {
+    Column& column = columns_[subject];
+    std::uint64_t bit = std::uint64_t{1} << (row % kWordBits);
+    if ((column.valid[row / kWordBits] & bit) == 0) {
+      column.valid[row / kWordBits] |= bit;
+      ++column.count;
+    }
+    if (column.storage == ScoreStorage::hundredths) {
+      column.fixed[row] = FixedScore::from_double(score).value_or(FixedScore()).raw();
+    } else {
+      column.values[row] = score;
+    }
+  }
+
+  void ScoreMatrix::unset(std::size_t subject, std::size_t row) noexcept {
+    Column& column = columns_[subject];
+    std::uint64_t bit = std::uint64_t{1} << (row % kWordBits);
+    if ((column.valid[row / kWordBits] & bit) != 0) {
+      column.valid[row / kWordBits] &= ~bit;
+      --column.count;
+    }
+    // 保持"没有成绩的位置为 0"，求和时不需要判断
+    if (column.storage == ScoreStorage::hundredths) {
+      column.fixed[row] = 0;
+    } else {
+      column.values[row] = 0.0;
+    }
+  }
+
+  double ScoreMatrix::sum(std::size_t subject) const noexcept {
+    const Column& column = columns_[subject];
+    if (column.storage == ScoreStorage::hundredths) {
+      return static_cast<double>(kernels::sum_fixed(column.fixed.data(), column.fixed.size()))
+             / FixedScore::kScale;
+    }
+    return kernels::sum(column.values.data(), column.values.size());
+  }
+
+  double ScoreMatrix::average(std::size_t subject) const noexcept {
+    const Column& column = columns_[subject];
+    if (column.count == 0) {
+      return -1.0;
+    }
+    if (column.storage == ScoreStorage::hundredths) {
+      std::uint64_t total = kernels::sum_fixed(column.fixed.data(), column.fixed.size());
+      return static_cast<double>(total)
+             / (static_cast<double>(column.count) * FixedScore::kScale);
+    }
+    return sum(subject) / static_cast<double>(column.count);
+  }
+
+  std::vector<double> ScoreMatrix::valid_scores(std::size_t subject) const {
+    std::vector<double> scores;
+    scores.reserve(columns_[subject].count);
+    for (std::size_t row = 0; row < rows_; ++row) {
+      if (has(subject, row)) {
+        scores.push_back(get(subject, row));
+      }
+    }
+    return scores;
+  }
+
+  std::vector<std::uint16_t> ScoreMatrix::valid_hundredths(std::size_t subject) const {
+    const Column& column = columns_[subject];
+    std::vector<std::uint16_t> scores;
+    scores.reserve(column.count);
+    for (std::size_t row = 0; row < column.fixed.size(); ++row) {
+      if (has(subject, row)) {
+        scores.push_back(column.fixed[row]);
+      }
+    }
+    return scores;
+  }
+
+  double ScoreMatrix::row_average(std::size_t row) const noexcept {
+    double total = 0.0;
+    std::size_t graded = 0;
+    for (std::size_t subject = 0; subject < columns_.size(); ++subject) {
+      if (has(subject, row)) {
+        total += get(subject, row);
+        ++graded;
+      }
+    }
+    return graded == 0 ? -1.0 : total / static_cast<double>(graded);
+  }
+
+  double ScoreMatrix::row_gpa(std::size_t row) const noexcept {
+    double points = 0.0;
+    double credits = 0.0;
+    for (std::size_t subject = 0; subject < columns_.size(); ++subject) {
+      if (has(subject, row)) {
+        points += columns_[subject].credits * grade_point(get(subject, row));
+        credits += columns_[subject].credits;
+      }
+    }
+    return credits == 0.0 ? -1.0 : points / credits;
+  }
+
+  std::vector<double> ScoreMatrix::gpas() const {
+    std::vector<double> points(rows_, 0.0);
+    std::vector<double> credits(rows_, 0.0);
+    // 按列累加：每列只顺序读一遍。没有成绩的位置是 0 分、绩点也是 0，
+    // 因此绩点不需要判断有效位；学分乘以有效位后累加。循环中没有分支，编译器可以向量化
+    for (const Column& column : columns_) {
+      const std::uint64_t* valid = column.valid.data();
+      const double weight = column.credits;
+      for (std::size_t row = 0; row < rows_; ++row) {
+        double present = static_cast<double>(valid[row / kWordBits] >> (row % kWordBits) & 1U);
+        credits[row] += weight * present;
+      }
+      if (column.storage == ScoreStorage::hundredths) {
+        const std::uint16_t* fixed = column.fixed.data();
+        for (std::size_t row = 0; row < rows_; ++row) {
+          points[row] += weight * grade_point(static_cast<double>(fixed[row]) / FixedScore::kScale);
+        }
+      } else {
+        const double* values = column.values.data();
+        for (std::size_t row = 0; row < rows_; ++row) {
+          points[row] += weight * grade_point(values[row]);
+        }
+      }
+    }
+    for (std::size_t row = 0; row < rows_; ++row) {
+      points[row] = credits[row] == 0.0 ? -1.0 : points[row] / credits[row];
+    }
+    return points;
+  }
+
+  std::size_t ScoreMatrix::memory_bytes() const noexcept {
+    std::size_t bytes = columns_.capacity() * sizeof(Column);
+    for (const Column& column : columns_) {
+      bytes += column.name.capacity() + column.values.capacity() * sizeof(double)
+               + column.fixed.capacity() * sizeof(std::uint16_t)
+               + column.valid.capacity() * sizeof(std::uint64_t);
+    }
+    return bytes;
+  }
+
+}  // namespace student_manager
@@ -0,0 +1,470 @@
+/**
+ * @file snapshot.cpp
+ * @brief 二进制快照的读写实现
+ */
+
+#include "student_manager/snapshot.h"
+
+#include <cstddef>  // offsetof
+#include <cstdio>   // std::remove, std::rename
+#include <cstring>  // std::memcmp, std::memcpy, std::memset
+#include <fstream>  // std::ofstream
+
+#include "student_manager/checksum.h"
+#include "student_manager/id_key.h"
+#include "student_manager/student_manager.h"
+
+#if defined(_WIN32)
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace student_manager {
+
+  namespace {
+
+    constexpr char kMagic[8] = {'S', 'S', 'M', 'S', 'N', 'A', 'P', '\x1A'};
+    constexpr std::uint32_t kVersion = 1;
+    constexpr std::uint32_t kEndianTag = 0x01020304u;
+
+    /// 文件头，所有字段都是定长整数，按本机字节序存放
+    struct Header {
+      char magic[8];
+      std::uint32_t version;
+      std::uint32_t endian_tag;
+      std::uint64_t rows;
+      std::uint64_t scores_offset;
+      std::uint64_t id_keys_offset;
+      std::uint64_t string_table_offset;
+      std::uint64_t strings_offset;
+      std::uint64_t strings_size;
+      std::uint64_t file_size;
+      std::uint64_t payload_checksum;  ///< [sizeof(Header), file_size) 的校验和
+      std::uint64_t journal_sequence;  ///< 快照已包含的最后一条日志记录的序号（没有日志时为 0）
+      std::uint64_t header_checksum;   ///< 本字段之前所有字节的校验和
+    };
+    static_assert(sizeof(Header) == 96, "快照文件头必须是 96 字节");
+
+    constexpr std::uint64_t align8(std::uint64_t size) noexcept { return (size + 7) & ~7ull; }
+
+    std::uint64_t header_checksum(const Header& header) noexcept {
+      Checksum checksum;
+      checksum.update(&header, offsetof(Header, header_checksum));
+      return checksum.finish();
+    }
+
+    /// 带缓冲地写出 8 字节对齐的数据块，同时累计校验和
+    class ColumnWriter {
+    public:
+      explicit ColumnWriter(std::ofstream& out) : out_(out) { buffer_.reserve(kBufferWords); }
+
+      void put(std::uint64_t word) {
+        buffer_.push_back(word);
+        if (buffer_.size() == kBufferWords) {
+          write_buffer();
+        }
+      }
+
+      void put(double value) {
+        std::uint64_t word;
+        std::memcpy(&word, &value, sizeof(word));
+        put(word);
+      }
+
+      /// 写出任意长度的字节，不足 8 字节的尾部暂存起来与后续字节拼接
+      void put_bytes(std::string_view bytes) {
+        for (char c : bytes) {
+          pending_[pending_size_++] = c;
+          if (pending_size_ == 8) {
+            put_pending();
+          }
+        }
+      }
+
+      /// 把暂存的尾部补零写出，并把缓冲区写入文件
+      void flush() {
+        if (pending_size_ != 0) {
+          put_pending();
+        }
+        write_buffer();
+      }
+
+      [[nodiscard]] std::uint64_t checksum() const noexcept { return checksum_.finish(); }
+
+    private:
+      void put_pending() {
+        std::uint64_t word;
+        std::memcpy(&word, pending_, sizeof(word));
+        std::memset(pending_, 0, sizeof(pending_));
+        pending_size_ = 0;
+        put(word);
+      }
+
+      void write_buffer() {
+        std::size_t bytes = buffer_.size() * sizeof(std::uint64_t);
+        checksum_.update(buffer_.data(), bytes);
+        out_.write(reinterpret_cast<const char*>(buffer_.data()),
+                   static_cast<std::streamsize>(bytes));
+        buffer_.clear();
+      }
+
+      static constexpr std::size_t kBufferWords = 8192;
+
+      std::ofstream& out_;
+      std::vector<std::uint64_t> buffer_;
+      char pending_[8] = {};  ///< 还没凑满 8 字节的字符
+      std::size_t pending_size_ = 0;
+      Checksum checksum_;
+    };
+
+    /// 把文件内容刷到磁盘，替换目标文件之前调用，保证断电后不会出现半个快照
+    bool sync_file(const std::string& path) {
+#if defined(_WIN32)
+      HANDLE file = CreateFileA(path.c_str(), GENERIC_WRITE, 0, nullptr, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL, nullptr);
+      if (file == INVALID_HANDLE_VALUE) {
+        return false;
+      }
+      bool ok = FlushFileBuffers(file) != 0;
+      CloseHandle(file);
+      return ok;
+#else
+      int fd = ::open(path.c_str(), O_RDONLY);
+      if (fd < 0) {
+        return false;
+      }
+      bool ok = ::fsync(fd) == 0;
+      ::close(fd);
+      return ok;
+#endif
+    }
+
+    /// 用临时文件替换目标文件
+    bool replace_file(const std::string& from, const std::string& to) {
+#if defined(_WIN32)
+      return MoveFileExA(from.c_str(), to.c_str(),
+                         MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)
+             != 0;
+#else
+      return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+    }
+
+  }  // namespace
+
+  const char* to_string(SnapshotStatus status) noexcept {
+    switch (status) {
+      case SnapshotStatus::ok:
+        return "成功";
+      case SnapshotStatus::open_failed:
+        return "无法打开文件";
+      case SnapshotStatus::io_error:
+        return "读写文件失败";
+      case SnapshotStatus::not_a_snapshot:
+        return "不是快照文件";
+      case SnapshotStatus::unsupported_format:
+        return "不支持的快照版本";
+      case SnapshotStatus::corrupted:
+        return "快照文件已损坏";
+    }
+    return "未知错误";
+  }
+
+  bool sync_parent_directory(const std::string& path) {
+#if defined(_WIN32)
+    (void)path;
+    return true;
+#else
+    std::string::size_type slash = path.find_last_of('/');
+    std::string directory
+        = slash == std::string::npos ? "." : path.substr(0, slash == 0 ? 1 : slash);
+    int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0) {
+      return false;
+    }
+    bool ok = ::fsync(fd) == 0;
+    ::close(fd);
+    return ok;
+#endif
+  }
+
+  // ==================== 写入 ====================
+
+  SnapshotStatus write_snapshot(const std::string& path, const std::vector<Student>& students,
+                                std::uint64_t journal_sequence) {
+    const std::uint64_t rows = students.size();
+    std::uint64_t strings_size = 0;
+    for (const Student& student : students) {
+      strings_size += student.get_name().size() + student.get_id().size();
+    }
+
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.endian_tag = kEndianTag;
+    header.rows = rows;
+    header.scores_offset = sizeof(Header);
+    header.id_keys_offset = header.scores_offset + rows * sizeof(double);
+    header.string_table_offset = header.id_keys_offset + rows * sizeof(std::uint64_t);
+    header.strings_offset = header.string_table_offset + (2 * rows + 1) * sizeof(std::uint64_t);
+    header.strings_size = strings_size;
+    header.file_size = header.strings_offset + align8(strings_size);
+    header.journal_sequence = journal_sequence;
+
+    const std::string temp_path = path + ".tmp";
+    std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      return SnapshotStatus::open_failed;
+    }
+
+    // 先占住文件头的位置，数据写完、校验和算出来之后再回填
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    ColumnWriter writer(out);
+    for (const Student& student : students) {
+      writer.put(student.get_score());
+    }
+    for (const Student& student : students) {
+      writer.put(IdKey::pack(student.get_id()));
+    }
+    std::uint64_t offset = 0;
+    writer.put(offset);
+    for (const Student& student : students) {
+      offset += student.get_name().size();
+      writer.put(offset);
+      offset += student.get_id().size();
+      writer.put(offset);
+    }
+    for (const Student& student : students) {
+      writer.put_bytes(student.get_name());
+      writer.put_bytes(student.get_id());
+    }
+    writer.flush();
+
+    header.payload_checksum = writer.checksum();
+    header.header_checksum = header_checksum(header);
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.close();
+
+    if (!out || !sync_file(temp_path) || !replace_file(temp_path, path)) {
+      std::remove(temp_path.c_str());
+      return SnapshotStatus::io_error;
+    }
+    // 改名落盘之后调用者才能删除旧日志
+    if (!sync_parent_directory(path)) {
+      return SnapshotStatus::io_error;
+    }
+    return SnapshotStatus::ok;
+  }
+
+  // ==================== 内存映射读取 ====================
+
+  SnapshotView& SnapshotView::operator=(SnapshotView&& other) noexcept {
+    if (this != &other) {
+      close();
+      data_ = other.data_;
+      file_size_ = other.file_size_;
+      file_handle_ = other.file_handle_;
+      mapping_handle_ = other.mapping_handle_;
+      rows_ = other.rows_;
+      scores_ = other.scores_;
+      id_keys_ = other.id_keys_;
+      string_offsets_ = other.string_offsets_;
+      strings_ = other.strings_;
+      journal_sequence_ = other.journal_sequence_;
+      index_ = std::move(other.index_);
+      // 映射的所有权已经转移，只重置对方的状态，不解除映射
+      other.data_ = nullptr;
+      other.file_handle_ = nullptr;
+      other.mapping_handle_ = nullptr;
+      other.close();
+    }
+    return *this;
+  }
+
+  SnapshotStatus SnapshotView::open(const std::string& path) {
+    close();
+    SnapshotStatus status = map(path);
+    if (status == SnapshotStatus::ok) {
+      status = check_header();
+    }
+    if (status != SnapshotStatus::ok) {
+      close();
+    }
+    return status;
+  }
+
+  SnapshotStatus SnapshotView::map(const std::string& path) {
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+      return SnapshotStatus::open_failed;
+    }
+    file_handle_ = file;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+      return SnapshotStatus::io_error;
+    }
+    file_size_ = static_cast<std::size_t>(size.QuadPart);
+    if (file_size_ < sizeof(Header)) {
+      return SnapshotStatus::not_a_snapshot;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+      return SnapshotStatus::io_error;
+    }
+    mapping_handle_ = mapping;
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr) {
+      return SnapshotStatus::io_error;
+    }
+    data_ = static_cast<const std::uint8_t*>(data);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return SnapshotStatus::open_failed;
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0) {
+      ::close(fd);
+      return SnapshotStatus::io_error;
+    }
+    file_size_ = static_cast<std::size_t>(info.st_size);
+    if (file_size_ < sizeof(Header)) {
+      ::close(fd);
+      return SnapshotStatus::not_a_snapshot;
+    }
+    void* data = ::mmap(nullptr, file_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // 映射建立后不再需要文件描述符
+    if (data == MAP_FAILED) {
+      return SnapshotStatus::io_error;
+    }
+    data_ = static_cast<const std::uint8_t*>(data);
+#endif
+    return SnapshotStatus::ok;
+  }
+
+  void SnapshotView::close() noexcept {
+#if defined(_WIN32)
+    if (data_ != nullptr) {
+      UnmapViewOfFile(data_);
+    }
+    if (mapping_handle_ != nullptr) {
+      CloseHandle(mapping_handle_);
+    }
+    if (file_handle_ != nullptr) {
+      CloseHandle(file_handle_);
+    }
+#else
+    if (data_ != nullptr) {
+      ::munmap(const_cast<std::uint8_t*>(data_), file_size_);
+    }
+#endif
+    data_ = nullptr;
+    file_size_ = 0;
+    file_handle_ = nullptr;
+    mapping_handle_ = nullptr;
+    rows_ = 0;
+    scores_ = nullptr;
+    id_keys_ = nullptr;
+    string_offsets_ = nullptr;
+    strings_ = nullptr;
+    journal_sequence_ = 0;
+    index_.reset();
+  }
+
+  SnapshotStatus SnapshotView::check_header() noexcept {
+    Header header;
+    std::memcpy(&header, data_, sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+      return SnapshotStatus::not_a_snapshot;
+    }
+    if (header.version != kVersion || header.endian_tag != kEndianTag) {
+      return SnapshotStatus::unsupported_format;
+    }
+    if (header.header_checksum != header_checksum(header) || header.file_size != file_size_) {
+      return SnapshotStatus::corrupted;
+    }
+
+    // 各区段必须首尾相接、按 8 字节对齐，并且不超出文件（先限制行数，避免乘法溢出）
+    const std::uint64_t rows = header.rows;
+    if (rows > file_size_ / 32 || rows >= IdIndex::npos
+        || header.scores_offset != sizeof(Header)
+        || header.id_keys_offset != header.scores_offset + rows * sizeof(double)
+        || header.string_table_offset != header.id_keys_offset + rows * sizeof(std::uint64_t)
+        || header.strings_offset
+               != header.string_table_offset + (2 * rows + 1) * sizeof(std::uint64_t)
+        || header.strings_size > file_size_
+        || header.strings_offset + align8(header.strings_size) != file_size_) {
+      return SnapshotStatus::corrupted;
+    }
+
+    rows_ = static_cast<std::size_t>(rows);
+    scores_ = reinterpret_cast<const double*>(data_ + header.scores_offset);
+    id_keys_ = reinterpret_cast<const std::uint64_t*>(data_ + header.id_keys_offset);
+    string_offsets_ = reinterpret_cast<const std::uint64_t*>(data_ + header.string_table_offset);
+    strings_ = reinterpret_cast<const char*>(data_ + header.strings_offset);
+    journal_sequence_ = header.journal_sequence;
+    return SnapshotStatus::ok;
+  }
+
+  SnapshotStatus SnapshotView::verify() const noexcept {
+    if (!is_open()) {
+      return SnapshotStatus::io_error;
+    }
+    Header header;
+    std::memcpy(&header, data_, sizeof(header));
+    Checksum checksum;
+    checksum.update(data_ + sizeof(Header), file_size_ - sizeof(Header));
+    if (checksum.finish() != header.payload_checksum) {
+      return SnapshotStatus::corrupted;
+    }
+
+    // 校验和正确时这些检查不会失败，但可以挡住手工构造的文件
+    if (string_offsets_[0] != 0 || string_offsets_[2 * rows_] != header.strings_size) {
+      return SnapshotStatus::corrupted;
+    }
+    for (std::size_t i = 0; i < 2 * rows_; ++i) {
+      if (string_offsets_[i] > string_offsets_[i + 1]) {
+        return SnapshotStatus::corrupted;
+      }
+    }
+    for (std::size_t row = 0; row < rows_; ++row) {
+      if (id_keys_[row] != IdKey::pack(id(row))) {
+        return SnapshotStatus::corrupted;
+      }
+    }
+    return SnapshotStatus::ok;
+  }
+
+  std::optional<std::size_t> SnapshotView::find(std::string_view id) const {
+    auto matches = [this](const IdKey& key, std::uint32_t row) {
+      return key.matches(id_keys_[row], [&] { return this->id(row); });
+    };
+    if (!index_) {
+      IdIndex index;
+      index.reserve(rows_);
+      for (std::size_t row = 0; row < rows_; ++row) {
+        index.insert(IdKey(this->id(row)), static_cast<std::uint32_t>(row));
+      }
+      index_ = std::move(index);
+    }
+    std::uint32_t row = index_->find(IdKey(id), matches);
+    if (row == IdIndex::npos) {
+      return std::nullopt;
+    }
+    return row;
+  }
+
+}  // namespace student_manager
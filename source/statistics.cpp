@@ -0,0 +1,189 @@
+/**
+ * @file statistics.cpp
+ * @brief 成绩统计报告的实现
+ */
+
+#include "student_manager/statistics.h"
+
+#include <algorithm>  // std::nth_element, std::min_element, std::min
+#include <cmath>      // std::sqrt
+#include <cstddef>    // std::ptrdiff_t
+#include <cstdint>    // std::uint16_t, std::uint64_t
+#include <vector>     // std::vector
+
+#include "student_manager/fixed_score.h"
+#include "student_manager/score_kernels.h"
+
+namespace student_manager {
+
+  namespace {
+
+    constexpr std::size_t kBlockSize = 1024;
+
+    /// 一块成绩的部分统计量
+    struct BlockSummary {
+      std::size_t size = 0;
+      double mean = 0.0;
+      double m2 = 0.0;
+      double lowest = 0.0;
+      double highest = 0.0;
+    };
+
+    /**
+     * @brief 在部分有序的缓冲区上求线性插值的百分位数
+     *
+     * 调用时要求 [0, from) 中的元素都不大于 [from, n) 中的元素（前一次选择留下的划分），
+     * 这样多个百分位数从小到大依次计算时，每次只需要在剩下的部分中选择。
+     */
+    double select_percentile(std::vector<double>& buffer, std::size_t from, double percentile) {
+      std::size_t n = buffer.size();
+      double position = static_cast<double>(n - 1) * percentile / 100.0;
+      auto lower = static_cast<std::size_t>(position);
+      double fraction = position - static_cast<double>(lower);
+
+      auto first = buffer.begin() + static_cast<std::ptrdiff_t>(from);
+      auto nth = buffer.begin() + static_cast<std::ptrdiff_t>(lower);
+      std::nth_element(first, nth, buffer.end());
+      double value = *nth;
+      if (fraction > 0.0 && lower + 1 < n) {
+        // nth_element 之后，比 nth 大的元素都在右侧，右侧的最小值就是下一个元素
+        double next = *std::min_element(nth + 1, buffer.end());
+        value += (next - value) * fraction;
+      }
+      return value;
+    }
+
+  }  // namespace
+
+  ScoreStatistics compute_score_statistics(const double* scores, std::size_t count,
+                                           const ParallelOptions& options) {
+    ScoreStatistics stats;
+    if (count == 0) {
+      return stats;
+    }
+
+    std::vector<double> buffer(count);
+
+    // ---- 单次遍历：分块求平均值、离差平方和、最高/最低分，同时复制到缓冲区 ----
+    // 各块互不依赖，可以并行计算；合并则总是在这里按块的顺序进行，结果与线程数无关
+    auto blocks = parallel::map_chunks<BlockSummary>(
+        count, kBlockSize, options, [&](std::size_t begin, std::size_t end) {
+          BlockSummary block;
+          const double* data = scores + begin;
+          block.size = end - begin;
+          block.mean = kernels::sum(data, block.size) / static_cast<double>(block.size);
+          block.lowest = data[0];
+          block.highest = data[0];
+          for (std::size_t i = 0; i < block.size; ++i) {
+            double x = data[i];
+            double d = x - block.mean;
+            block.m2 += d * d;
+            block.lowest = x < block.lowest ? x : block.lowest;
+            block.highest = x > block.highest ? x : block.highest;
+            buffer[begin + i] = x;
+          }
+          return block;
+        });
+
+    double mean = 0.0;
+    double m2 = 0.0;  // 离差平方和
+    double lowest = scores[0];
+    double highest = scores[0];
+    std::size_t seen = 0;
+    for (const BlockSummary& block : blocks) {
+      // Chan 合并公式：把当前块的统计量并入之前所有块
+      std::size_t total = seen + block.size;
+      double delta = block.mean - mean;
+      mean += delta * static_cast<double>(block.size) / static_cast<double>(total);
+      m2 += block.m2
+            + delta * delta * static_cast<double>(seen) * static_cast<double>(block.size)
+                  / static_cast<double>(total);
+      lowest = block.lowest < lowest ? block.lowest : lowest;
+      highest = block.highest > highest ? block.highest : highest;
+      seen = total;
+    }
+
+    stats.count = count;
+    stats.mean = mean;
+    stats.variance = m2 / static_cast<double>(count);
+    stats.stddev = std::sqrt(stats.variance);
+    stats.min = lowest;
+    stats.max = highest;
+
+    // ---- 百分位数：从小到大依次选择，每次只在上一次划分的右侧继续 ----
+    auto lower_index = [count](double percentile) {
+      return static_cast<std::size_t>(static_cast<double>(count - 1) * percentile / 100.0);
+    };
+    stats.percentile_25 = select_percentile(buffer, 0, 25.0);
+    stats.median = select_percentile(buffer, lower_index(25.0), 50.0);
+    stats.percentile_75 = select_percentile(buffer, lower_index(50.0), 75.0);
+    stats.percentile_90 = select_percentile(buffer, lower_index(75.0), 90.0);
+    return stats;
+  }
+
+  ScoreStatistics compute_fixed_score_statistics(const std::uint16_t* hundredths,
+                                                 std::size_t count) {
+    ScoreStatistics stats;
+    if (count == 0) {
+      return stats;
+    }
+
+    constexpr std::size_t kBuckets = std::size_t{FixedScore::kMaxRaw} + 1;
+    std::vector<std::uint64_t> counts(kBuckets, 0);
+    kernels::histogram(hundredths, count, counts.data(), kBuckets);
+
+    std::uint64_t total = 0;
+    std::size_t lowest = kBuckets;
+    std::size_t highest = 0;
+    for (std::size_t value = 0; value < kBuckets; ++value) {
+      if (counts[value] != 0) {
+        total += counts[value] * value;
+        lowest = value < lowest ? value : lowest;
+        highest = value;
+      }
+    }
+    // 离差平方和在计数表上计算，每个不同的成绩只算一次
+    double raw_mean = static_cast<double>(total) / static_cast<double>(count);
+    double m2 = 0.0;
+    for (std::size_t value = lowest; value <= highest; ++value) {
+      double d = static_cast<double>(value) - raw_mean;
+      m2 += static_cast<double>(counts[value]) * d * d;
+    }
+
+    constexpr double kScale = FixedScore::kScale;
+    stats.count = count;
+    // 总和是精确的整数，平均分只在这一次除法中舍入
+    stats.mean = static_cast<double>(total) / (static_cast<double>(count) * kScale);
+    stats.variance = m2 / static_cast<double>(count) / (kScale * kScale);
+    stats.stddev = std::sqrt(stats.variance);
+    stats.min = static_cast<double>(lowest) / kScale;
+    stats.max = static_cast<double>(highest) / kScale;
+
+    // ---- 百分位数：在计数表上找排序后第 k 个成绩，插值方式与 double 版本相同 ----
+    auto value_at = [&counts](std::uint64_t rank) {
+      std::uint64_t seen = 0;
+      std::size_t value = 0;
+      while (seen + counts[value] <= rank) {
+        seen += counts[value];
+        ++value;
+      }
+      return static_cast<double>(value) / kScale;
+    };
+    auto percentile = [&](double p) {
+      double position = static_cast<double>(count - 1) * p / 100.0;
+      auto lower = static_cast<std::size_t>(position);
+      double fraction = position - static_cast<double>(lower);
+      double value = value_at(lower);
+      if (fraction > 0.0 && lower + 1 < count) {
+        value += (value_at(lower + 1) - value) * fraction;
+      }
+      return value;
+    };
+    stats.percentile_25 = percentile(25.0);
+    stats.median = percentile(50.0);
+    stats.percentile_75 = percentile(75.0);
+    stats.percentile_90 = percentile(90.0);
+    return stats;
+  }
+
+}  // namespace student_manager
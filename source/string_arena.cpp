@@ -0,0 +1,51 @@
+/**
+ * @file string_arena.cpp
+ * @brief 字符串区的实现
+ */
+
+#include "student_manager/string_arena.h"
+
+namespace student_manager {
+
+  StringArena& StringArena::operator=(StringArena&& other) noexcept {
+    if (this != &other) {
+      blocks_ = std::move(other.blocks_);
+      cursor_ = other.cursor_;
+      remaining_ = other.remaining_;
+      used_ = other.used_;
+      reserved_ = other.reserved_;
+      other.clear();
+    }
+    return *this;
+  }
+
+  char* StringArena::allocate(std::size_t size) {
+    if (size > remaining_) {
+      // 较大的字符串单独占一块，不浪费当前块的剩余空间
+      if (size > kBlockSize / 4) {
+        blocks_.push_back(std::unique_ptr<char[]>(new char[size]));
+        reserved_ += size;
+        used_ += size;
+        return blocks_.back().get();
+      }
+      blocks_.push_back(std::unique_ptr<char[]>(new char[kBlockSize]));
+      reserved_ += kBlockSize;
+      cursor_ = blocks_.back().get();
+      remaining_ = kBlockSize;
+    }
+    char* result = cursor_;
+    cursor_ += size;
+    remaining_ -= size;
+    used_ += size;
+    return result;
+  }
+
+  void StringArena::clear() noexcept {
+    blocks_.clear();
+    cursor_ = nullptr;
+    remaining_ = 0;
+    used_ = 0;
+    reserved_ = 0;
+  }
+
+}  // namespace student_manager
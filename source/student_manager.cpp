@@ -5,88 +5,1119 @@
 
 #include "student_manager/student_manager.h"
 
-#include <algorithm>  // std::find_if, std::max_element, std::min_element
-#include <numeric>    // std::accumulate
+#include <algorithm>   // std::max, std::partial_sort, std::nth_element, std::sort, std::stable_sort
+#include <functional>  // std::greater
+#include <mutex>       // std::lock_guard
+#include <numeric>     // std::iota
+#include <stdexcept>   // std::invalid_argument
+#include <string>      // std::string
+#include <utility>     // std::move
 
 namespace student_manager {
 
   // ==================== StudentManager 类实现 ====================
   // 注意：Student 类的方法已在头文件中内联实现
 
+  StudentManager::StudentManager(const StudentManager& other)
+      : students_(other.students_),
+        id_index_(other.id_index_),
+        id_keys_(other.id_keys_),
+        slots_(other.slots_),
+        row_slots_(other.row_slots_),
+        scores_(other.scores_),
+        aggregates_(other.aggregates_),
+        subject_scores_(other.subject_scores_),
+        rank_index_(other.rank_index_),
+        histogram_(other.histogram_),
+        name_index_(other.name_index_),
+        sorted_indexes_(other.copy_sorted_indexes()),
+        read_publisher_(other.read_publisher_)
+#if STUDENT_MANAGER_METRICS
+        ,  // 性能统计随对象复制和移动
+        metrics_(other.metrics_ ? std::make_unique<MetricsRecorder>(*other.metrics_)
+                                : std::make_unique<MetricsRecorder>())
+#endif
+  {
+    adopt_rows(0);
+    // 拷贝出来的长字符串各自分配在堆上，统一搬到自己的字符串区
+    for (std::size_t row = 0; row < students_.size(); ++row) {
+      pack_strings(row);
+    }
+  }
+
+  StudentManager::StudentManager(StudentManager&& other) noexcept
+      : students_(std::move(other.students_)),
+        id_index_(std::move(other.id_index_)),
+        id_keys_(std::move(other.id_keys_)),
+        slots_(std::move(other.slots_)),
+        row_slots_(std::move(other.row_slots_)),
+        scores_(std::move(other.scores_)),
+        aggregates_(std::move(other.aggregates_)),
+        subject_scores_(std::move(other.subject_scores_)),
+        rank_index_(std::move(other.rank_index_)),
+        histogram_(std::move(other.histogram_)),
+        name_index_(std::move(other.name_index_)),
+        sorted_indexes_(std::move(other.sorted_indexes_)),
+        string_arena_(std::move(other.string_arena_)),
+        arena_garbage_(other.arena_garbage_),
+        journal_(std::move(other.journal_)),
+        read_publisher_(std::move(other.read_publisher_))
+#if STUDENT_MANAGER_METRICS
+        ,
+        metrics_(std::move(other.metrics_))
+#endif
+  {
+    adopt_rows(0);
+    // 让被移动的对象回到一致的空状态；它已经没有日志和只读快照，清空时不会分配内存
+    other.read_publisher_.reset();
+    other.clear();
+  }
+
+  StudentManager& StudentManager::operator=(const StudentManager& other) {
+    if (this != &other) {
+      StudentManager copy(other);
+      *this = std::move(copy);
+    }
+    return *this;
+  }
+
+  StudentManager& StudentManager::operator=(StudentManager&& other) noexcept {
+    if (this != &other) {
+      // 整体移动 vector 只交换缓冲区，不会对单个学生调用赋值，因此不会触发成绩通知
+      students_ = std::move(other.students_);
+      id_index_ = std::move(other.id_index_);
+      id_keys_ = std::move(other.id_keys_);
+      slots_ = std::move(other.slots_);
+      row_slots_ = std::move(other.row_slots_);
+      scores_ = std::move(other.scores_);
+      aggregates_ = std::move(other.aggregates_);
+      subject_scores_ = std::move(other.subject_scores_);
+      rank_index_ = std::move(other.rank_index_);
+      histogram_ = std::move(other.histogram_);
+      name_index_ = std::move(other.name_index_);
+      sorted_indexes_ = std::move(other.sorted_indexes_);
+      string_arena_ = std::move(other.string_arena_);
+      arena_garbage_ = other.arena_garbage_;
+      journal_ = std::move(other.journal_);
+      read_publisher_ = std::move(other.read_publisher_);
+#if STUDENT_MANAGER_METRICS
+      metrics_ = std::move(other.metrics_);
+#endif
+      adopt_rows(0);
+      other.read_publisher_.reset();
+      other.clear();
+    }
+    return *this;
+  }
+
+  void StudentManager::adopt_rows(std::size_t from) noexcept {
+    for (std::size_t row = from; row < students_.size(); ++row) {
+      students_[row].owner_ = this;
+    }
+  }
+
+  void StudentManager::reserve_rows(std::size_t count) {
+    if (count <= students_.capacity()) {
+      return;
+    }
+    for (Student& student : students_) {
+      student.owner_ = nullptr;
+    }
+    try {
+      students_.reserve(count);
+    } catch (...) {
+      adopt_rows(0);
+      throw;
+    }
+    adopt_rows(0);
+  }
+
+  void StudentManager::pack_strings(std::size_t row) {
+    for (CompactString* text : {&students_[row].name_, &students_[row].id_}) {
+      if (text->on_heap()) {
+        text->move_to_arena(string_arena_.allocate(text->size()));
+      }
+    }
+  }
+
+  void StudentManager::compact_strings() {
+    StringArena fresh;
+    for (Student& student : students_) {
+      for (CompactString* text : {&student.name_, &student.id_}) {
+        if (text->in_arena()) {
+          text->move_to_arena(fresh.allocate(text->size()));
+        }
+      }
+    }
+    string_arena_ = std::move(fresh);
+    arena_garbage_ = 0;
+  }
+
+  void StudentManager::on_score_changed(const Student& student, double old_score) {
+    auto row = static_cast<std::size_t>(&student - students_.data());
+    scores_[row] = student.get_score();
+    aggregates_.replace(old_score, student.get_score());
+    if (rank_index_) {
+      rank_index_->update(row_slots_[row], student.get_score());
+    }
+    sorted_indexes_[static_cast<std::size_t>(SortKey::score)].mark(row_slots_[row]);
+    if (histogram_) {
+      histogram_->replace(old_score, student.get_score());
+    }
+    if (journal_) {
+      journal_->log_score(student.get_id(), student.get_score());
+      maybe_compact_journal();
+    }
+    if (read_publisher_) {
+      read_publisher_->mark_score(row);
+      count_read_change();
+    }
+  }
+
+  void StudentManager::replace_student(Student& student, const Student& value) {
+    auto row = static_cast<std::uint32_t>(&student - students_.data());
+    bool id_changed = value.get_id() != student.get_id();
+    bool name_changed = value.get_name() != student.get_name();
+    if (id_changed && find_row(value.get_id()) != IdIndex::npos) {
+      throw std::invalid_argument("Student: 学号 " + std::string(value.get_id())
+                                  + " 已被其他学生使用");
+    }
+    if (id_changed || name_changed) {
+      // 先复制新的字符串（value 可能就是本管理器中的另一个学生），再修改索引
+      CompactString name(value.get_name());
+      CompactString id(value.get_id());
+      std::uint32_t slot = row_slots_[row];
+      if (journal_) {
+        // 日志中记为删除再添加，回放后这名学生排在列表末尾，内容相同
+        journal_->log_remove(student.get_id());
+      }
+      if (id_changed) {
+        id_index_.erase(IdKey(student.get_id()), row_matcher());
+      }
+      for (const CompactString* text : {&student.name_, &student.id_}) {
+        if (text->in_arena()) {
+          arena_garbage_ += text->size();
+        }
+      }
+      student.name_ = std::move(name);
+      student.id_ = std::move(id);
+      pack_strings(row);
+      if (id_changed) {
+        IdKey key(student.get_id());
+        id_keys_[row] = key.packed();
+        id_index_.insert(key, row);
+      }
+      if (name_changed && name_index_) {
+        name_index_->erase(slot);
+        name_index_->insert(slot, student.get_name());
+      }
+      mark_sorted(slot);
+      if (journal_) {
+        journal_->log_add(student.get_name(), student.get_id(), student.get_score());
+      }
+      if (read_publisher_) {
+        read_publisher_->mark_row(row);
+        count_read_change();
+      }
+    }
+    student.set_score(value.get_score());
+  }
+
+  std::uint32_t StudentManager::find_row(std::string_view student_id) const {
+    return id_index_.find(IdKey(student_id), row_matcher());
+  }
+
+  StudentHandle StudentManager::append_row(Student&& student) {
+    auto row = static_cast<std::uint32_t>(students_.size());
+    if (students_.size() == students_.capacity()) {
+      reserve_rows(std::max<std::size_t>(8, students_.capacity() * 2));
+    }
+    students_.emplace_back(std::move(student));
+    adopt_rows(row);
+    scores_.push_back(students_.back().get_score());
+    aggregates_.add(students_.back().get_score());
+    subject_scores_.push_row();
+    IdKey key(students_.back().get_id());
+    id_keys_.push_back(key.packed());
+    id_index_.insert(key, row);
+    StudentHandle handle = slots_.allocate(row);
+    row_slots_.push_back(handle.slot);
+    pack_strings(row);
+    if (rank_index_) {
+      rank_index_->insert(handle.slot, students_.back().get_score());
+    }
+    if (histogram_) {
+      histogram_->add(students_.back().get_score());
+    }
+    if (name_index_) {
+      name_index_->insert(handle.slot, students_.back().get_name());
+    }
+    mark_sorted(handle.slot);
+    if (journal_) {
+      const Student& added = students_.back();
+      journal_->log_add(added.get_name(), added.get_id(), added.get_score());
+      maybe_compact_journal();
+    }
+    if (read_publisher_) {
+      read_publisher_->mark_row(row);
+      count_read_change();
+    }
+    return handle;
+  }
+
+  void StudentManager::erase_row(std::uint32_t row) {
+    if (journal_) {
+      journal_->log_remove(students_[row].get_id());
+    }
+    auto matches = row_matcher();
+    id_index_.erase(IdKey(students_[row].get_id()), matches);
+    slots_.release(row_slots_[row]);
+    aggregates_.remove(students_[row].get_score());
+    if (rank_index_) {
+      rank_index_->erase(row_slots_[row]);
+    }
+    if (histogram_) {
+      histogram_->remove(students_[row].get_score());
+    }
+    if (name_index_) {
+      name_index_->erase(row_slots_[row]);
+    }
+    mark_sorted(row_slots_[row]);
+    for (const CompactString* text : {&students_[row].name_, &students_[row].id_}) {
+      if (text->in_arena()) {
+        arena_garbage_ += text->size();
+      }
+    }
+
+    // swap-and-pop：用最后一个学生填补空位，只需移动一个元素
+    subject_scores_.swap_remove(row);
+    auto last = static_cast<std::uint32_t>(students_.size() - 1);
+    if (row != last) {
+      // 先更新索引（此时最后一行的学号仍然有效），再移动元素
+      id_index_.update_row(IdKey(students_[last].get_id()), row, matches);
+      // 赋值期间暂时解除双方的归属：目标不会把"搬运"误当成修改成绩，来源的字符串直接被接管
+      students_[row].owner_ = nullptr;
+      students_[last].owner_ = nullptr;
+      students_[row] = std::move(students_[last]);
+      students_[row].owner_ = this;
+      row_slots_[row] = row_slots_[last];
+      slots_.set_row(row_slots_[row], row);
+      scores_[row] = scores_[last];
+      id_keys_[row] = id_keys_[last];
+      for (SortedIndex& index : sorted_indexes_) {
+        index.mark_moved();
+      }
+    }
+    students_.pop_back();
+    row_slots_.pop_back();
+    scores_.pop_back();
+    id_keys_.pop_back();
+    // 空洞超过一个内存块且超过字符串区的一半时整体重建，均摊 O(1)
+    if (arena_garbage_ > StringArena::kBlockSize
+        && arena_garbage_ * 2 > string_arena_.bytes_used()) {
+      compact_strings();
+    }
+    if (journal_) {
+      maybe_compact_journal();
+    }
+    if (read_publisher_) {
+      // 被删除的行和被搬走的最后一行所在的块都变了
+      read_publisher_->mark_row(row);
+      read_publisher_->mark_row(last);
+      count_read_change();
+    }
+  }
+
   bool StudentManager::add_student(const Student& student) {
-    if (find_student(student.get_id())) {
+    STUDENT_MANAGER_TIME_OPERATION(add_student);
+    if (find_row(student.get_id()) != IdIndex::npos) {
+      STUDENT_MANAGER_COUNT_EVENT(duplicate_rejected, 1);
       return false;  // 学号已存在
     }
-    students_.emplace_back(student);
+    append_row(Student(student));
     return true;
   }
 
   bool StudentManager::add_student(Student&& student) {
-    if (find_student(student.get_id())) {
+    STUDENT_MANAGER_TIME_OPERATION(add_student);
+    if (find_row(student.get_id()) != IdIndex::npos) {
+      STUDENT_MANAGER_COUNT_EVENT(duplicate_rejected, 1);
       return false;  // 学号已存在
     }
-    students_.emplace_back(std::move(student));
+    append_row(std::move(student));
     return true;
   }
 
+  AddStatus StudentManager::add_batch_row(const Student& student, std::size_t batch_begin) {
+    std::uint32_t row = find_row(student.get_id());
+    if (row != IdIndex::npos) {
+      STUDENT_MANAGER_COUNT_EVENT(duplicate_rejected, 1);
+      return row >= batch_begin ? AddStatus::duplicate_in_batch : AddStatus::duplicate_existing;
+    }
+    append_row(Student(student));
+    return AddStatus::added;
+  }
+
+  AddStatus StudentManager::add_batch_row(Student&& student, std::size_t batch_begin) {
+    std::uint32_t row = find_row(student.get_id());
+    if (row != IdIndex::npos) {
+      STUDENT_MANAGER_COUNT_EVENT(duplicate_rejected, 1);
+      return row >= batch_begin ? AddStatus::duplicate_in_batch : AddStatus::duplicate_existing;
+    }
+    append_row(std::move(student));
+    return AddStatus::added;
+  }
+
+  void StudentManager::reserve(size_type count) {
+    reserve_rows(count);
+    id_index_.reserve(count);
+    id_keys_.reserve(count);
+    slots_.reserve(count);
+    row_slots_.reserve(count);
+    scores_.reserve(count);
+    subject_scores_.reserve(count);
+    if (rank_index_) {
+      rank_index_->reserve(count);
+    }
+    if (name_index_) {
+      name_index_->reserve(count);
+    }
+  }
+
+  std::optional<StudentHandle> StudentManager::insert_student(Student student) {
+    STUDENT_MANAGER_TIME_OPERATION(insert_student);
+    if (find_row(student.get_id()) != IdIndex::npos) {
+      STUDENT_MANAGER_COUNT_EVENT(duplicate_rejected, 1);
+      return std::nullopt;  // 学号已存在
+    }
+    return append_row(std::move(student));
+  }
+
   bool StudentManager::remove_student(std::string_view student_id) {
-    auto it = std::find_if(students_.begin(), students_.end(),
-                           [student_id](const Student& s) { return s.get_id() == student_id; });
-    if (it != students_.end()) {
-      students_.erase(it);
-      return true;
+    STUDENT_MANAGER_TIME_OPERATION(remove_student);
+    std::uint32_t row = find_row(student_id);
+    if (row == IdIndex::npos) {
+      return false;
     }
-    return false;
+    erase_row(row);
+    return true;
+  }
+
+  bool StudentManager::remove_student(StudentHandle handle) {
+    STUDENT_MANAGER_TIME_OPERATION(remove_student);
+    std::uint32_t row = slots_.row_of(handle);
+    if (row == SlotTable::npos) {
+      return false;
+    }
+    erase_row(row);
+    return true;
   }
 
   std::optional<std::reference_wrapper<Student>> StudentManager::find_student(
       std::string_view student_id) {
-    auto it = std::find_if(students_.begin(), students_.end(),
-                           [student_id](const Student& s) { return s.get_id() == student_id; });
-    if (it != students_.end()) {
-      return std::ref(*it);
+    STUDENT_MANAGER_TIME_OPERATION(find_student);
+    std::uint32_t row = find_row(student_id);
+    if (row != IdIndex::npos) {
+      STUDENT_MANAGER_COUNT_EVENT(find_hit, 1);
+      return std::ref(students_[row]);
     }
+    STUDENT_MANAGER_COUNT_EVENT(find_miss, 1);
     return std::nullopt;
   }
 
   std::optional<std::reference_wrapper<const Student>> StudentManager::find_student(
       std::string_view student_id) const {
-    auto it = std::find_if(students_.begin(), students_.end(),
-                           [student_id](const Student& s) { return s.get_id() == student_id; });
-    if (it != students_.end()) {
-      return std::cref(*it);
+    STUDENT_MANAGER_TIME_OPERATION(find_student);
+    std::uint32_t row = find_row(student_id);
+    if (row != IdIndex::npos) {
+      STUDENT_MANAGER_COUNT_EVENT(find_hit, 1);
+      return std::cref(students_[row]);
+    }
+    STUDENT_MANAGER_COUNT_EVENT(find_miss, 1);
+    return std::nullopt;
+  }
+
+  std::optional<StudentHandle> StudentManager::get_handle(std::string_view student_id) const {
+    std::uint32_t row = find_row(student_id);
+    if (row != IdIndex::npos) {
+      return slots_.handle_of(row_slots_[row]);
     }
     return std::nullopt;
   }
 
-  double StudentManager::calculate_average_score() const noexcept {
-    if (students_.empty()) {
-      return 0.0;
+  std::optional<std::reference_wrapper<Student>> StudentManager::get_student(
+      StudentHandle handle) noexcept {
+    std::uint32_t row = slots_.row_of(handle);
+    if (row != SlotTable::npos) {
+      return std::ref(students_[row]);
+    }
+    return std::nullopt;
+  }
+
+  std::optional<std::reference_wrapper<const Student>> StudentManager::get_student(
+      StudentHandle handle) const noexcept {
+    std::uint32_t row = slots_.row_of(handle);
+    if (row != SlotTable::npos) {
+      return std::cref(students_[row]);
+    }
+    return std::nullopt;
+  }
+
+  bool StudentManager::update_score(std::string_view student_id, double new_score) {
+    STUDENT_MANAGER_TIME_OPERATION(update_score);
+    std::uint32_t row = find_row(student_id);
+    if (row == IdIndex::npos) {
+      return false;
+    }
+    students_[row].set_score(new_score);
+    return true;
+  }
+
+  bool StudentManager::update_score(StudentHandle handle, double new_score) {
+    STUDENT_MANAGER_TIME_OPERATION(update_score);
+    std::uint32_t row = slots_.row_of(handle);
+    if (row == SlotTable::npos) {
+      return false;
+    }
+    students_[row].set_score(new_score);
+    return true;
+  }
+
+  std::vector<std::uint32_t> StudentManager::find_rows(const std::vector<IdKey>& keys) const {
+    // 两级预取：提前 kSlotAhead 个学号预取哈希槽位；提前 kRowAhead 个学号时槽位已经在缓存中，
+    // 读出候选行号并预取这一行的学号键（非数字学号还要预取学生本身，比较时要读字符串）
+    constexpr std::size_t kSlotAhead = 16;
+    constexpr std::size_t kRowAhead = 8;
+    const std::size_t count = keys.size();
+    std::vector<std::uint32_t> rows(count);
+    for (std::size_t i = 0; i < std::min(count, kSlotAhead); ++i) {
+      id_index_.prefetch(keys[i]);
+    }
+    auto matches = row_matcher();
+    for (std::size_t i = 0; i < count; ++i) {
+      if (i + kSlotAhead < count) {
+        id_index_.prefetch(keys[i + kSlotAhead]);
+      }
+      if (i + kRowAhead < count) {
+        const IdKey& ahead = keys[i + kRowAhead];
+        std::uint32_t candidate = id_index_.candidate(ahead);
+        if (candidate != IdIndex::npos) {
+          detail::prefetch(&id_keys_[candidate]);
+          if (!ahead.is_numeric()) {
+            detail::prefetch(&students_[candidate]);
+          }
+        }
+      }
+      rows[i] = id_index_.find(keys[i], matches);
+    }
+    return rows;
+  }
+
+  std::vector<UpdateStatus> StudentManager::update_rows(const std::vector<std::uint32_t>& rows,
+                                                        const std::vector<double>& scores) {
+    constexpr std::size_t kRowAhead = 8;
+    const std::size_t count = rows.size();
+    std::vector<UpdateStatus> results(count, UpdateStatus::not_found);
+    for (std::size_t i = 0; i < count; ++i) {
+      if (i + kRowAhead < count && rows[i + kRowAhead] != IdIndex::npos) {
+        detail::prefetch(&students_[rows[i + kRowAhead]]);
+        detail::prefetch(&scores_[rows[i + kRowAhead]]);
+      }
+      if (rows[i] != IdIndex::npos) {
+        students_[rows[i]].set_score(scores[i]);
+        results[i] = UpdateStatus::updated;
+      }
+    }
+    return results;
+  }
+
+  void StudentManager::enable_ranking_index() {
+    RankIndex index;
+    index.reserve(students_.size());
+    for (std::size_t row = 0; row < students_.size(); ++row) {
+      index.insert(row_slots_[row], scores_[row]);
+    }
+    rank_index_ = std::move(index);
+  }
+
+  std::optional<StudentManager::size_type> StudentManager::rank_of(
+      std::string_view student_id) const {
+    STUDENT_MANAGER_TIME_OPERATION(rank_of);
+    std::uint32_t row = find_row(student_id);
+    if (row == IdIndex::npos) {
+      return std::nullopt;
+    }
+    double score = scores_[row];
+    if (rank_index_) {
+      return rank_index_->count_greater(score) + 1;
+    }
+    return parallel::count_if(scores_.size(), ParallelOptions{},
+                              [&](std::size_t other) { return scores_[other] > score; })
+           + 1;
+  }
+
+  std::optional<double> StudentManager::kth_score(size_type k) const {
+    STUDENT_MANAGER_TIME_OPERATION(kth_score);
+    if (k == 0 || k > students_.size()) {
+      return std::nullopt;
+    }
+    if (rank_index_) {
+      return rank_index_->score_of(rank_index_->kth_largest(k - 1));
+    }
+    std::vector<double> scores = scores_;
+    auto nth = scores.begin() + static_cast<std::ptrdiff_t>(k - 1);
+    std::nth_element(scores.begin(), nth, scores.end(), std::greater<>());
+    return *nth;
+  }
+
+  std::vector<std::reference_wrapper<const Student>> StudentManager::top_k(size_type k) const {
+    STUDENT_MANAGER_TIME_OPERATION(top_k);
+    std::vector<std::reference_wrapper<const Student>> result;
+    k = std::min(k, students_.size());
+    result.reserve(k);
+    if (rank_index_) {
+      for (std::uint32_t slot : rank_index_->top(k)) {
+        result.push_back(std::cref(students_[slots_.row_of_slot(slot)]));
+      }
+      return result;
+    }
+    std::vector<std::uint32_t> rows(students_.size());
+    std::iota(rows.begin(), rows.end(), 0u);
+    auto middle = rows.begin() + static_cast<std::ptrdiff_t>(k);
+    std::partial_sort(rows.begin(), middle, rows.end(), [this](std::uint32_t a, std::uint32_t b) {
+      return scores_[a] > scores_[b];
+    });
+    for (auto it = rows.begin(); it != middle; ++it) {
+      result.push_back(std::cref(students_[*it]));
+    }
+    return result;
+  }
+
+  std::vector<std::reference_wrapper<const Student>> StudentManager::bottom_k(size_type k) const {
+    STUDENT_MANAGER_TIME_OPERATION(bottom_k);
+    std::vector<std::reference_wrapper<const Student>> result;
+    k = std::min(k, students_.size());
+    result.reserve(k);
+    if (rank_index_) {
+      for (std::uint32_t slot : rank_index_->bottom(k)) {
+        result.push_back(std::cref(students_[slots_.row_of_slot(slot)]));
+      }
+      return result;
+    }
+    std::vector<std::uint32_t> rows(students_.size());
+    std::iota(rows.begin(), rows.end(), 0u);
+    auto middle = rows.begin() + static_cast<std::ptrdiff_t>(k);
+    std::partial_sort(rows.begin(), middle, rows.end(), [this](std::uint32_t a, std::uint32_t b) {
+      return scores_[a] < scores_[b];
+    });
+    for (auto it = rows.begin(); it != middle; ++it) {
+      result.push_back(std::cref(students_[*it]));
+    }
+    return result;
+  }
+
+  ScoreHistogram StudentManager::build_histogram() const {
+    ScoreHistogram histogram;
+    for (double score : scores_) {
+      histogram.add(score);
+    }
+    return histogram;
+  }
+
+  void StudentManager::enable_score_histogram() { histogram_ = build_histogram(); }
+
+  StudentManager::size_type StudentManager::count_in_range(double low, double high) const {
+    STUDENT_MANAGER_TIME_OPERATION(count_in_range);
+    if (histogram_) {
+      return histogram_->count_in_range(low, high);
+    }
+    return build_histogram().count_in_range(low, high);
+  }
+
+  std::vector<StudentManager::size_type> StudentManager::grade_distribution(
+      const std::vector<double>& boundaries) const {
+    STUDENT_MANAGER_TIME_OPERATION(grade_distribution);
+    if (histogram_) {
+      return histogram_->distribution(boundaries);
+    }
+    return build_histogram().distribution(boundaries);
+  }
+
+  void StudentManager::enable_name_index() {
+    NameIndex index;
+    index.reserve(students_.size());
+    for (std::size_t row = 0; row < students_.size(); ++row) {
+      index.insert(row_slots_[row], students_[row].get_name());
+    }
+    name_index_ = std::move(index);
+  }
+
+  std::vector<std::reference_wrapper<const Student>> StudentManager::rows_of_slots(
+      const std::vector<std::uint32_t>& slots) const {
+    std::vector<std::uint32_t> rows;
+    rows.reserve(slots.size());
+    for (std::uint32_t slot : slots) {
+      rows.push_back(slots_.row_of_slot(slot));
+    }
+    std::sort(rows.begin(), rows.end());
+    std::vector<std::reference_wrapper<const Student>> result;
+    result.reserve(rows.size());
+    for (std::uint32_t row : rows) {
+      result.push_back(std::cref(students_[row]));
+    }
+    return result;
+  }
+
+  std::vector<std::reference_wrapper<const Student>> StudentManager::find_students_by_name(
+      std::string_view name) const {
+    STUDENT_MANAGER_TIME_OPERATION(find_by_name);
+    if (name_index_) {
+      return rows_of_slots(name_index_->find_exact(name));
+    }
+    return find_students_if([name](const Student& student) { return student.get_name() == name; });
+  }
+
+  std::vector<std::reference_wrapper<const Student>> StudentManager::find_students_by_name_prefix(
+      std::string_view prefix, size_type limit) const {
+    STUDENT_MANAGER_TIME_OPERATION(find_by_name);
+    std::vector<std::reference_wrapper<const Student>> result;
+    if (name_index_) {
+      for (std::uint32_t slot : name_index_->find_prefix(prefix, limit)) {
+        result.push_back(std::cref(students_[slots_.row_of_slot(slot)]));
+      }
+      return result;
+    }
+    prefix = NameIndex::complete_prefix(prefix);
+    result = find_students_if([prefix](const Student& student) {
+      return student.get_name().substr(0, prefix.size()) == prefix;
+    });
+    std::stable_sort(result.begin(), result.end(), [](const Student& a, const Student& b) {
+      return a.get_name() < b.get_name();
+    });
+    if (result.size() > limit) {
+      result.erase(result.begin() + static_cast<std::ptrdiff_t>(limit), result.end());
+    }
+    return result;
+  }
+
+  std::vector<std::reference_wrapper<const Student>>
+  StudentManager::find_students_by_name_substring(std::string_view text) const {
+    STUDENT_MANAGER_TIME_OPERATION(find_by_name);
+    if (name_index_) {
+      return rows_of_slots(name_index_->find_substring(text));
+    }
+    return find_students_if([text](const Student& student) {
+      return student.get_name().find(text) != std::string_view::npos;
+    });
+  }
+
+  std::optional<double> StudentManager::approximate_percentile(double percentile) const {
+    STUDENT_MANAGER_TIME_OPERATION(approximate_percentile);
+    double value = histogram_ ? histogram_->percentile(percentile)
+                              : build_histogram().percentile(percentile);
+    if (value < 0.0) {
+      return std::nullopt;  // 没有可统计的成绩
+    }
+    return value;
+  }
+
+  std::optional<std::size_t> StudentManager::add_subject(std::string_view name, double credits,
+                                                         ScoreStorage storage) {
+    if (!(credits > 0.0) || subject_scores_.find_subject(name) != ScoreMatrix::npos) {
+      return std::nullopt;
+    }
+    return subject_scores_.add_subject(name, credits, storage);
+  }
+
+  bool StudentManager::remove_subject(std::string_view name) {
+    std::size_t subject = subject_scores_.find_subject(name);
+    if (subject == ScoreMatrix::npos) {
+      return false;
+    }
+    subject_scores_.remove_subject(subject);
+    return true;
+  }
+
+  std::uint32_t StudentManager::subject_row(std::string_view student_id,
+                                            std::size_t subject) const {
+    return subject < subject_scores_.subject_count() ? find_row(student_id) : IdIndex::npos;
+  }
+
+  bool StudentManager::set_subject_score(std::string_view student_id, std::size_t subject,
+                                         double score) {
+    // 科目成绩不写入日志，日志模式下接受修改就等于在崩溃时悄悄丢掉它
+    if (journal_) {
+      return false;
+    }
+    std::uint32_t row = subject_row(student_id, subject);
+    if (row == IdIndex::npos || !Student::is_valid_score(score)) {
+      return false;
     }
-    double total
-        = std::accumulate(students_.begin(), students_.end(), 0.0,
-                          [](double sum, const Student& s) { return sum + s.get_score(); });
-    return total / static_cast<double>(students_.size());
+    subject_scores_.set(subject, row, score);
+    return true;
   }
 
-  std::optional<double> StudentManager::get_max_score() const noexcept {
-    if (students_.empty()) {
+  bool StudentManager::clear_subject_score(std::string_view student_id, std::size_t subject) {
+    if (journal_) {
+      return false;
+    }
+    std::uint32_t row = subject_row(student_id, subject);
+    if (row == IdIndex::npos || !subject_scores_.has(subject, row)) {
+      return false;
+    }
+    subject_scores_.unset(subject, row);
+    return true;
+  }
+
+  std::optional<double> StudentManager::get_subject_score(std::string_view student_id,
+                                                          std::size_t subject) const {
+    std::uint32_t row = subject_row(student_id, subject);
+    if (row == IdIndex::npos || !subject_scores_.has(subject, row)) {
       return std::nullopt;
     }
-    auto it = std::max_element(
-        students_.begin(), students_.end(),
-        [](const Student& a, const Student& b) { return a.get_score() < b.get_score(); });
-    return it->get_score();
+    return subject_scores_.get(subject, row);
   }
 
-  std::optional<double> StudentManager::get_min_score() const noexcept {
-    if (students_.empty()) {
+  std::optional<double> StudentManager::subject_average(std::size_t subject) const noexcept {
+    STUDENT_MANAGER_TIME_OPERATION(subject_average);
+    if (subject >= subject_scores_.subject_count() || subject_scores_.count(subject) == 0) {
       return std::nullopt;
     }
-    auto it = std::min_element(
-        students_.begin(), students_.end(),
-        [](const Student& a, const Student& b) { return a.get_score() < b.get_score(); });
-    return it->get_score();
+    return subject_scores_.average(subject);
+  }
+
+  ScoreStatistics StudentManager::compute_subject_statistics(
+      std::size_t subject, const ParallelOptions& options) const {
+    STUDENT_MANAGER_TIME_OPERATION(subject_statistics);
+    if (subject >= subject_scores_.subject_count()) {
+      return ScoreStatistics{};
+    }
+    if (subject_scores_.storage(subject) == ScoreStorage::hundredths) {
+      std::vector<std::uint16_t> hundredths = subject_scores_.valid_hundredths(subject);
+      return compute_fixed_score_statistics(hundredths.data(), hundredths.size());
+    }
+    std::vector<double> scores = subject_scores_.valid_scores(subject);
+    return compute_score_statistics(scores.data(), scores.size(), options);
+  }
+
+  std::optional<double> StudentManager::student_average(std::string_view student_id) const {
+    std::uint32_t row = find_row(student_id);
+    if (row == IdIndex::npos) {
+      return std::nullopt;
+    }
+    double average = subject_scores_.row_average(row);
+    return average < 0.0 ? std::nullopt : std::optional<double>(average);
+  }
+
+  std::optional<double> StudentManager::student_gpa(std::string_view student_id) const {
+    std::uint32_t row = find_row(student_id);
+    if (row == IdIndex::npos) {
+      return std::nullopt;
+    }
+    double gpa = subject_scores_.row_gpa(row);
+    return gpa < 0.0 ? std::nullopt : std::optional<double>(gpa);
+  }
+
+  std::vector<std::optional<double>> StudentManager::compute_gpas() const {
+    STUDENT_MANAGER_TIME_OPERATION(compute_gpas);
+    std::vector<double> gpas = subject_scores_.gpas();
+    std::vector<std::optional<double>> result(gpas.size());
+    for (std::size_t row = 0; row < gpas.size(); ++row) {
+      if (gpas[row] >= 0.0) {
+        result[row] = gpas[row];
+      }
+    }
+    return result;
+  }
+
+  bool StudentManager::id_less(std::uint32_t a, std::uint32_t b) const noexcept {
+    bool a_numeric = id_keys_[a] != IdKey::kNotNumeric;
+    bool b_numeric = id_keys_[b] != IdKey::kNotNumeric;
+    if (a_numeric != b_numeric) {
+      return a_numeric;  // 纯数字学号在前
+    }
+    if (a_numeric) {
+      return id_keys_[a] < id_keys_[b];  // 键的高位是位数，因此先比位数再比数值
+    }
+    return students_[a].get_id() < students_[b].get_id();
+  }
+
+  bool StudentManager::score_less(std::uint32_t a, std::uint32_t b) const noexcept {
+    if (scores_[a] != scores_[b]) {
+      return scores_[a] < scores_[b];
+    }
+    return id_less(a, b);
+  }
+
+  bool StudentManager::name_less(std::uint32_t a, std::uint32_t b) const noexcept {
+    int compare = students_[a].get_name().compare(students_[b].get_name());
+    return compare != 0 ? compare < 0 : id_less(a, b);
+  }
+
+  SortedView StudentManager::sorted_by(SortKey key) const {
+    STUDENT_MANAGER_TIME_OPERATION(sorted_by);
+    // 缓存是 mutable 的，多个线程同时取得视图时由锁保证只有一个在修补；
+    // 数据没有变化时修补是空操作，先得到的视图不会被后来的调用改动
+    std::lock_guard<std::mutex> lock(sorted_mutex_);
+    SortedIndex& index = sorted_indexes_[static_cast<std::size_t>(key)];
+    switch (key) {
+      case SortKey::id:
+        index.refresh(slots_, row_slots_,
+                      [this](std::uint32_t a, std::uint32_t b) { return id_less(a, b); });
+        break;
+      case SortKey::score:
+        index.refresh(slots_, row_slots_,
+                      [this](std::uint32_t a, std::uint32_t b) { return score_less(a, b); });
+        break;
+      case SortKey::name:
+        index.refresh(slots_, row_slots_,
+                      [this](std::uint32_t a, std::uint32_t b) { return name_less(a, b); });
+        break;
+    }
+    return SortedView(students_, index.rows());
+  }
+
+  MemoryUsage StudentManager::memory_usage() const {
+    STUDENT_MANAGER_TIME_OPERATION(memory_usage);
+    MemoryUsage usage;
+    usage.students = students_.size();
+    usage.records = students_.capacity() * sizeof(Student);
+    usage.strings = string_arena_.bytes_reserved();
+    for (const Student& student : students_) {
+      // 通过赋值换上的长字符串不在字符串区中，单独计算
+      usage.strings += student.name_.on_heap() ? student.name_.size() : 0;
+      usage.strings += student.id_.on_heap() ? student.id_.size() : 0;
+    }
+    usage.score_column = scores_.capacity() * sizeof(double);
+    usage.subject_scores = subject_scores_.memory_bytes();
+    usage.indexes = id_index_.memory_bytes() + id_keys_.capacity() * sizeof(std::uint64_t)
+                    + slots_.memory_bytes()
+                    + row_slots_.capacity() * sizeof(std::uint32_t) + aggregates_.memory_bytes();
+    if (rank_index_) {
+      usage.indexes += rank_index_->memory_bytes();
+    }
+    if (histogram_) {
+      usage.indexes += histogram_->memory_bytes();
+    }
+    if (name_index_) {
+      usage.indexes += name_index_->memory_bytes();
+    }
+    {
+      std::lock_guard<std::mutex> lock(sorted_mutex_);
+      for (const SortedIndex& index : sorted_indexes_) {
+        usage.indexes += index.memory_bytes();
+      }
+    }
+    return usage;
+  }
+
+  std::array<SortedIndex, kSortKeyCount> StudentManager::copy_sorted_indexes()
+      const {
+    std::lock_guard<std::mutex> lock(sorted_mutex_);
+    return sorted_indexes_;
+  }
+
+  SnapshotStatus StudentManager::load_snapshot(const std::string& path) {
+    STUDENT_MANAGER_TIME_OPERATION(load_snapshot);
+    SnapshotView view;
+    SnapshotStatus status = view.open(path);
+    if (status != SnapshotStatus::ok) {
+      return status;
+    }
+    // 整体替换数据不会逐条记录到日志中，加载之后立即写出新快照，让日志与数据重新对应
+    std::unique_ptr<Journal> journal = std::move(journal_);
+    status = load_from(view);
+    journal_ = std::move(journal);
+    if (status == SnapshotStatus::ok && journal_) {
+      status = checkpoint();
+    }
+    return status;
+  }
+
+  SnapshotStatus StudentManager::load_from(const SnapshotView& view) {
+    SnapshotStatus status = view.verify();
+    if (status != SnapshotStatus::ok) {
+      return status;
+    }
+
+    StudentManager loaded;
+    loaded.subject_scores_.copy_subjects_from(subject_scores_);  // 快照中没有科目成绩
+    loaded.reserve(view.size());
+    for (std::size_t row = 0; row < view.size(); ++row) {
+      if (!loaded.add_student(Student(view.name(row), view.id(row), view.score(row)))) {
+        return SnapshotStatus::corrupted;  // 快照中不应出现重复的学号
+      }
+    }
+    if (rank_index_) {
+      loaded.enable_ranking_index();
+    }
+    if (histogram_) {
+      loaded.enable_score_histogram();
+    }
+    if (name_index_) {
+      loaded.enable_name_index();
+    }
+    if (read_publisher_) {
+      loaded.enable_read_snapshots(read_publisher_->publish_every());
+    }
+#if STUDENT_MANAGER_METRICS
+    loaded.metrics_ = std::move(metrics_);  // 性能统计属于这个对象，不随数据一起替换
+#endif
+    *this = std::move(loaded);
+    return SnapshotStatus::ok;
+  }
+
+  // ==================== 只读快照 ====================
+
+  void StudentManager::enable_read_snapshots(size_type publish_every) {
+    read_publisher_.emplace(publish_every);
+    read_publisher_->publish(students_, scores_);
+  }
+
+  void StudentManager::publish_read_snapshot() {
+    if (read_publisher_) {
+      read_publisher_->publish(students_, scores_);
+    }
+  }
+
+  void StudentManager::count_read_change() {
+    if (read_publisher_->count_change()) {
+      read_publisher_->publish(students_, scores_);
+    }
+  }
+
+  // ==================== 日志模式 ====================
+
+  SnapshotStatus StudentManager::open_journal(const std::string& snapshot_path,
+                                              const std::string& journal_path,
+                                              const JournalOptions& options) {
+    STUDENT_MANAGER_TIME_OPERATION(open_journal);
+    // 0. 已经处于日志模式时，先把缓冲区中的记录和正在进行的压缩落盘，回放才能读到全部修改。
+    //    原来的日志一直保留到新日志打开成功，失败时管理器保持不变
+    if (journal_) {
+      SnapshotStatus status = journal_->sync();
+      SnapshotStatus compaction = journal_->wait_for_compaction();
+      if (status != SnapshotStatus::ok) {
+        return status;
+      }
+      if (compaction != SnapshotStatus::ok) {
+        return compaction;
+      }
+    }
+
+    StudentManager recovered;
+    recovered.subject_scores_.copy_subjects_from(subject_scores_);
+    if (rank_index_) {
+      recovered.enable_ranking_index();
+    }
+    if (histogram_) {
+      recovered.enable_score_histogram();
+    }
+    if (name_index_) {
+      recovered.enable_name_index();
+    }
+
+    // 1. 加载快照（不存在时从空数据开始）
+    std::uint64_t sequence = 0;
+    {
+      SnapshotView view;
+      SnapshotStatus status = view.open(snapshot_path);
+      if (status == SnapshotStatus::ok) {
+        status = recovered.load_from(view);
+        sequence = view.journal_sequence();
+      } else if (status == SnapshotStatus::open_failed) {
+        status = SnapshotStatus::ok;
+      }
+      if (status != SnapshotStatus::ok) {
+        return status;
+      }
+    }
+
+    // 2. 依次回放压缩时留下的旧日志和当前日志中快照之后的记录
+    auto apply = [&recovered](const JournalRecord& record) {
+      recovered.apply_journal_record(record);
+    };
+    JournalReplay old_replay
+        = replay_journal(Journal::old_journal_path(journal_path), sequence, apply);
+    const bool has_old_journal = old_replay.status == SnapshotStatus::ok;
+    if (!has_old_journal && old_replay.status != SnapshotStatus::open_failed) {
+      return old_replay.status;
+    }
+    sequence = std::max(sequence, old_replay.last_sequence);
+    JournalReplay replay = replay_journal(journal_path, sequence, apply);
+    if (replay.status != SnapshotStatus::ok && replay.status != SnapshotStatus::open_failed) {
+      return replay.status;
+    }
+    sequence = std::max(sequence, replay.last_sequence);
+
+    // 3. 打开日志继续追加（原来的日志在替换数据时才关闭）
+    auto journal = std::make_unique<Journal>(snapshot_path, journal_path, options);
+    SnapshotStatus status
+        = journal->open(sequence, replay.status == SnapshotStatus::ok ? replay.valid_bytes : 0);
+    if (status != SnapshotStatus::ok) {
+      return status;
+    }
+    if (read_publisher_) {
+      // 回放期间不逐条发布，恢复完成后发布一次
+      recovered.enable_read_snapshots(read_publisher_->publish_every());
+    }
+#if STUDENT_MANAGER_METRICS
+    recovered.metrics_ = std::move(metrics_);
+#endif
+    *this = std::move(recovered);
+    journal_ = std::move(journal);
+
+    // 上一次压缩没有完成：立即把两份日志合并进新快照
+    if (has_old_journal) {
+      return checkpoint();
+    }
+    return SnapshotStatus::ok;
+  }
+
+  void StudentManager::apply_journal_record(const JournalRecord& record) {
+    switch (record.type) {
+      case JournalRecordType::add:
+        add_student(Student(record.name, record.id, record.score));
+        break;
+      case JournalRecordType::remove:
+        remove_student(record.id);
+        break;
+      case JournalRecordType::score:
+        update_score(record.id, record.score);
+        break;
+      case JournalRecordType::clear:
+        clear();
+        break;
+    }
+  }
+
+  SnapshotStatus StudentManager::close_journal() {
+    if (!journal_) {
+      return SnapshotStatus::ok;
+    }
+    SnapshotStatus status = journal_->sync();
+    SnapshotStatus compaction = journal_->wait_for_compaction();
+    journal_.reset();
+    return status != SnapshotStatus::ok ? status : compaction;
+  }
+
+  SnapshotStatus StudentManager::sync_journal() {
+    return journal_ ? journal_->sync() : SnapshotStatus::ok;
+  }
+
+  SnapshotStatus StudentManager::checkpoint() {
+    return journal_ ? journal_->checkpoint(students_) : SnapshotStatus::io_error;
+  }
+
+  SnapshotStatus StudentManager::compact_journal() {
+    return journal_ ? journal_->start_compaction(students_) : SnapshotStatus::io_error;
+  }
+
+  void StudentManager::maybe_compact_journal() {
+    if (journal_->wants_compaction()) {
+      // 失败时旧日志仍然完整，下一次修改会再次尝试
+      (void)journal_->start_compaction(students_);
+    }
   }
 
 }  // namespace student_manager
@@ -0,0 +1,303 @@
+/**
+ * @file batch_mode.cpp
+ * @brief 批处理模式的实现
+ */
+
+#include "batch_mode.h"
+
+#include <array>        // std::array
+#include <charconv>     // std::from_chars, std::to_chars
+#include <cstdlib>      // std::strtod
+#include <cstring>      // std::memchr, std::memcpy, std::memmove
+#include <string>       // std::string
+#include <string_view>  // std::string_view
+#include <vector>       // std::vector
+
+using namespace student_manager;
+
+namespace {
+
+  /// 每次从输入读取的字节数
+  constexpr std::size_t kReadSize = 64 * 1024;
+
+  /// 输出缓冲区攒到这么多字节时写出
+  constexpr std::size_t kFlushSize = 64 * 1024;
+
+  /**
+   * @brief 按块读取输入，逐行返回 std::string_view
+   *
+   * 返回的行指向内部缓冲区，下一次调用 next() 后失效。一行超过缓冲区时缓冲区会自动扩大。
+   */
+  class LineReader {
+  public:
+    explicit LineReader(std::FILE* file) : file_(file), buffer_(kReadSize) {}
+
+    /// 读取下一行（不含行尾的 \n 和 \r），没有更多行时返回 false
+    bool next(std::string_view& line) {
+      while (true) {
+        const char* start = buffer_.data() + begin_;
+        const auto* newline = static_cast<const char*>(std::memchr(start, '\n', end_ - begin_));
+        if (newline != nullptr) {
+          line = std::string_view(start, static_cast<std::size_t>(newline - start));
+          begin_ += line.size() + 1;
+          strip_carriage_return(line);
+          return true;
+        }
+        if (eof_) {
+          if (begin_ == end_) {
+            return false;
+          }
+          line = std::string_view(start, end_ - begin_);  // 最后一行没有换行符
+          begin_ = end_;
+          strip_carriage_return(line);
+          return true;
+        }
+        refill();
+      }
+    }
+
+  private:
+    std::FILE* file_;
+    std::vector<char> buffer_;
+    std::size_t begin_ = 0;  ///< 还没有返回的数据的起点
+    std::size_t end_ = 0;    ///< 缓冲区中有效数据的终点
+    bool eof_ = false;
+
+    /// 把未处理完的半行移到缓冲区开头，再读入一块
+    void refill() {
+      std::size_t remaining = end_ - begin_;
+      std::memmove(buffer_.data(), buffer_.data() + begin_, remaining);
+      begin_ = 0;
+      end_ = remaining;
+      if (buffer_.size() - end_ < kReadSize) {
+        buffer_.resize(end_ + kReadSize);
+      }
+      std::size_t read = std::fread(buffer_.data() + end_, 1, buffer_.size() - end_, file_);
+      end_ += read;
+      eof_ = read == 0;
+    }
+
+    static void strip_carriage_return(std::string_view& line) {
+      if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+      }
+    }
+  };
+
+  /**
+   * @brief 输出缓冲区：攒够一块后一次写出，析构时写出剩余内容
+   */
+  class OutputBuffer {
+  public:
+    explicit OutputBuffer(std::FILE* file) : file_(file) { buffer_.reserve(kFlushSize * 2); }
+
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    ~OutputBuffer() { flush(); }
+
+    OutputBuffer& operator<<(std::string_view text) {
+      buffer_.append(text);
+      return *this;
+    }
+
+    OutputBuffer& operator<<(char c) {
+      buffer_.push_back(c);
+      return *this;
+    }
+
+    OutputBuffer& operator<<(std::size_t value) {
+      std::array<char, 24> text{};
+      auto result = std::to_chars(text.data(), text.data() + text.size(), value);
+      buffer_.append(text.data(), result.ptr);
+      return *this;
+    }
+
+    OutputBuffer& operator<<(double value) {
+      std::array<char, 32> text{};
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+      auto result = std::to_chars(text.data(), text.data() + text.size(), value);
+      buffer_.append(text.data(), result.ptr);
+#else
+      int length = std::snprintf(text.data(), text.size(), "%.17g", value);
+      buffer_.append(text.data(), static_cast<std::size_t>(length));
+#endif
+      return *this;
+    }
+
+    /// 结束一行；缓冲区攒满时写出
+    void end_line() {
+      buffer_.push_back('\n');
+      if (buffer_.size() >= kFlushSize) {
+        flush();
+      }
+    }
+
+    void flush() {
+      if (!buffer_.empty()) {
+        std::fwrite(buffer_.data(), 1, buffer_.size(), file_);
+        buffer_.clear();
+      }
+      std::fflush(file_);
+    }
+
+  private:
+    std::FILE* file_;
+    std::string buffer_;
+  };
+
+  /// 一行最多的字段数（命令本身 + 3 个参数）
+  constexpr std::size_t kMaxFields = 4;
+
+  /**
+   * @brief 按空格和制表符切分字段，# 之后的内容是注释
+   * @return 字段个数；字段多于 kMaxFields 时返回 kMaxFields + 1
+   */
+  std::size_t split_fields(std::string_view line,
+                           std::array<std::string_view, kMaxFields>& fields) {
+    std::size_t count = 0;
+    std::size_t pos = 0;
+    while (true) {
+      while (pos < line.size() && (line[pos] == ' ' || line[pos] == '\t')) {
+        ++pos;
+      }
+      if (pos == line.size() || line[pos] == '#') {
+        return count;
+      }
+      std::size_t start = pos;
+      while (pos < line.size() && line[pos] != ' ' && line[pos] != '\t') {
+        ++pos;
+      }
+      if (count == kMaxFields) {
+        return kMaxFields + 1;
+      }
+      fields[count++] = line.substr(start, pos - start);
+    }
+  }
+
+  /// 解析成绩（必须是 0-100 之间的数字）
+  bool parse_score(std::string_view text, double& score) noexcept {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), score);
+    bool parsed = error == std::errc() && end == text.data() + text.size();
+#else
+    char buffer[64];
+    if (text.size() >= sizeof(buffer)) {
+      return false;
+    }
+    std::memcpy(buffer, text.data(), text.size());
+    buffer[text.size()] = '\0';
+    char* end = nullptr;
+    score = std::strtod(buffer, &end);
+    bool parsed = end == buffer + text.size();
+#endif
+    return parsed && Student::is_valid_score(score);
+  }
+
+  /// 一条命令的期望参数个数（不包括命令本身），未知命令返回 -1
+  int expected_arguments(std::string_view command) noexcept {
+    if (command == "add") {
+      return 3;
+    }
+    if (command == "set") {
+      return 2;
+    }
+    if (command == "find" || command == "remove") {
+      return 1;
+    }
+    if (command == "stats") {
+      return 0;
+    }
+    return -1;
+  }
+
+}  // namespace
+
+BatchResult run_batch(StudentManager& manager, std::FILE* input, std::FILE* output,
+                      std::FILE* errors, const BatchOptions& options) {
+  BatchResult result;
+  LineReader reader(input);
+  OutputBuffer out(output);
+  OutputBuffer err(errors);
+  std::array<std::string_view, kMaxFields> fields;
+  std::string_view line;
+
+  // 格式错误：写到标准错误并跳过这一行
+  std::size_t line_number = 0;
+  auto syntax_error = [&](std::string_view message) {
+    ++result.syntax_errors;
+    err << "第 " << line_number << " 行: " << message;
+    err.end_line();
+  };
+  // add / set / remove 的结果，--quiet 时不输出
+  auto acknowledge = [&](bool ok, std::string_view failure) {
+    if (!ok) {
+      ++result.failed;
+    }
+    if (!options.quiet) {
+      out << (ok ? std::string_view("ok") : failure);
+      out.end_line();
+    }
+  };
+
+  while (reader.next(line)) {
+    ++line_number;
+    std::size_t count = split_fields(line, fields);
+    if (count == 0) {
+      continue;  // 空行或注释
+    }
+    std::string_view command = fields[0];
+    int expected = expected_arguments(command);
+    if (expected < 0) {
+      syntax_error("未知命令");
+      continue;
+    }
+    if (count != static_cast<std::size_t>(expected) + 1) {
+      syntax_error("参数个数不对");
+      continue;
+    }
+
+    double score = 0.0;
+    if ((command == "add" && !parse_score(fields[3], score))
+        || (command == "set" && !parse_score(fields[2], score))) {
+      syntax_error("成绩必须是 0-100 之间的数字");
+      continue;
+    }
+
+    ++result.commands;
+    if (command == "add") {
+      acknowledge(manager.add_student(Student(fields[1], fields[2], score)), "duplicate");
+    } else if (command == "set") {
+      acknowledge(manager.update_score(fields[1], score), "not_found");
+    } else if (command == "remove") {
+      acknowledge(manager.remove_student(fields[1]), "not_found");
+    } else if (command == "find") {
+      auto student = manager.find_student(fields[1]);
+      if (student) {
+        const Student& found = student->get();
+        out << found.get_name() << ' ' << found.get_id() << ' ' << found.get_score();
+      } else {
+        ++result.failed;
+        out << "not_found";
+      }
+      out.end_line();
+    } else {  // stats
+      out << "count=" << static_cast<std::size_t>(manager.get_student_count())
+          << " average=" << manager.calculate_average_score();
+      if (auto max = manager.get_max_score(), min = manager.get_min_score(); max && min) {
+        out << " max=" << *max << " min=" << *min;
+      } else {
+        out << " max=- min=-";  // 没有学生
+      }
+      out.end_line();
+    }
+  }
+
+  out.flush();
+  if (!options.quiet) {
+    err << "已执行 " << result.commands << " 条命令，" << result.failed << " 条未成功，"
+        << result.syntax_errors << " 行格式错误";
+    err.end_line();
+  }
+  return result;
+}
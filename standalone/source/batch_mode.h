@@ -0,0 +1,62 @@
+/**
+ * @file batch_mode.h
+ * @brief 批处理模式 - 从文件或标准输入读取命令，不显示菜单和提示
+ *
+ * @details
+ * 交互式菜单每次操作都要打印菜单、分几次读取输入，适合手工使用，不适合脚本。
+ * 批处理模式每行一条命令，字段之间用空格或制表符分隔：
+ *
+ * @code
+ * # 以 # 开头的行和空行会被跳过
+ * add 张三 2023001 85.5     # 添加学生（姓名 学号 成绩），输出 ok 或 duplicate
+ * find 2023001              # 查找学生，输出 "姓名 学号 成绩" 或 not_found
+ * set 2023001 90            # 修改成绩，输出 ok 或 not_found
+ * remove 2023001            # 删除学生，输出 ok 或 not_found
+ * stats                     # 输出 count=人数 average=平均分 max=最高分 min=最低分
+ * @endcode
+ *
+ * 每条命令在标准输出上对应一行结果（没有学生时 stats 输出 max=- min=-）；
+ * 格式错误（未知命令、参数个数不对、成绩无效）写到标准错误，注明行号，并跳过这一行。
+ * 字段中不能有空格；以 # 开头的字段及其后面的内容是注释。
+ *
+ * 为了能在几秒内回放上百万条命令：
+ * - 按 64 KB 的块读取输入，在块中直接以 std::string_view 切分行和字段，不逐个字段读取
+ * - 成绩用 std::from_chars 解析、用 std::to_chars 输出
+ * - 所有输出先写入一个缓冲区，攒满后一次写出，不在每行之后刷新
+ */
+
+#pragma once
+
+#include <cstddef>  // std::size_t
+#include <cstdio>   // std::FILE
+
+#include "student_manager/student_manager.h"
+
+/**
+ * @brief 批处理选项
+ */
+struct BatchOptions {
+  /// 不输出 add / set / remove 的结果（find 和 stats 的结果照常输出），结束时也不输出汇总
+  bool quiet = false;
+};
+
+/**
+ * @brief 批处理结果
+ */
+struct BatchResult {
+  std::size_t commands = 0;       ///< 执行的命令数（不包括跳过的行）
+  std::size_t failed = 0;         ///< 执行了但没有成功的命令数（学号不存在、学号重复）
+  std::size_t syntax_errors = 0;  ///< 格式错误而被跳过的行数
+};
+
+/**
+ * @brief 依次执行 input 中的命令
+ * @param manager 要操作的学生管理器
+ * @param input 命令来源（文件或 stdin）
+ * @param output 命令结果写到这里
+ * @param errors 格式错误和汇总写到这里
+ * @param options 批处理选项
+ * @return 执行结果
+ */
+BatchResult run_batch(student_manager::StudentManager& manager, std::FILE* input,
+                      std::FILE* output, std::FILE* errors, const BatchOptions& options = {});
@@ -9,11 +9,17 @@
  * 3. 如何使用循环和条件语句构建交互式程序
  */
 
-#include <iomanip>   // 用于格式化输出
-#include <iostream>  // 用于输入输出
-#include <limits>    // 用于 numeric_limits
-#include <string>    // 用于字符串处理
+#include <cstdio>       // 用于批处理模式的文件读写
+#include <iomanip>      // 用于格式化输出
+#include <iostream>     // 用于输入输出
+#include <limits>       // 用于 numeric_limits
+#include <string>       // 用于字符串处理
+#include <string_view>  // 用于比较命令行参数
 
+#include "batch_mode.h"
+
+#include "student_manager/csv.h"
+#include "student_manager/report_writer.h"
 #include "student_manager/student_manager.h"
 
 using namespace student_manager;
@@ -34,6 +40,11 @@ void show_menu() {
   std::cout << "5. 显示所有学生\n";
   std::cout << "6. 计算平均分\n";
   std::cout << "7. 显示最高/最低分\n";
+  std::cout << "8. 保存到文件\n";
+  std::cout << "9. 从文件加载\n";
+  std::cout << "10. 从 CSV 导入\n";
+  std::cout << "11. 导出为 CSV\n";
+  std::cout << "12. 性能统计\n";
   std::cout << "0. 退出系统\n";
   std::cout << "======================================\n";
   std::cout << "请选择操作: ";
@@ -158,23 +169,26 @@ void modify_score(StudentManager& manager) {
 
 /// 显示所有学生
 void show_all_students(const StudentManager& manager) {
-  const auto& students = manager.get_all_students();
-
-  if (students.empty()) {
+  if (manager.empty()) {
     std::cout << "暂无学生数据！\n";
     return;
   }
 
-  std::cout << "\n" << std::left;
-  std::cout << std::setw(15) << "姓名" << std::setw(15) << "学号" << std::setw(10) << "成绩"
-            << "\n";
-  std::cout << std::string(40, '-') << "\n";
-
-  for (const auto& student : students) {
-    std::cout << std::setw(15) << student.get_name() << std::setw(15) << student.get_id()
-              << std::setw(10) << student.get_score() << "\n";
+  std::cout << "排序方式 (0=添加顺序 1=学号 2=姓名 3=成绩从高到低): ";
+  int order = 0;
+  if (!(std::cin >> order) || order < 0 || order > 3) {
+    std::cout << "输入错误！\n";
+    clear_input_buffer();
+    return;
   }
 
+  ReportOptions options;
+  options.order = static_cast<ReportOrder>(order);
+  options.descending = options.order == ReportOrder::by_score;
+  ReportWriter report(manager, options);
+
+  std::cout << "\n";
+  report.write_all(std::cout);
   std::cout << "共 " << manager.get_student_count() << " 名学生\n";
 }
 
@@ -208,7 +222,144 @@ void show_statistics(const StudentManager& manager) {
   }
 }
 
-int main() {
+/// 把所有学生保存为快照文件
+void save_to_file(const StudentManager& manager) {
+  std::string path;
+
+  std::cout << "请输入文件名: ";
+  if (!(std::cin >> path)) {
+    std::cout << "输入错误！\n";
+    clear_input_buffer();
+    return;
+  }
+
+  SnapshotStatus status = manager.save_snapshot(path);
+  if (status == SnapshotStatus::ok) {
+    std::cout << "已保存 " << manager.get_student_count() << " 名学生！\n";
+  } else {
+    std::cout << "保存失败：" << to_string(status) << "\n";
+  }
+}
+
+/// 从快照文件加载学生（替换当前数据）
+void load_from_file(StudentManager& manager) {
+  std::string path;
+
+  std::cout << "请输入文件名: ";
+  if (!(std::cin >> path)) {
+    std::cout << "输入错误！\n";
+    clear_input_buffer();
+    return;
+  }
+
+  SnapshotStatus status = manager.load_snapshot(path);
+  if (status == SnapshotStatus::ok) {
+    std::cout << "已加载 " << manager.get_student_count() << " 名学生！\n";
+  } else {
+    std::cout << "加载失败：" << to_string(status) << "\n";
+  }
+}
+
+/// 从 CSV 文件导入学生（追加到当前数据）
+void import_from_csv(StudentManager& manager) {
+  std::string path;
+
+  std::cout << "请输入 CSV 文件名: ";
+  if (!(std::cin >> path)) {
+    std::cout << "输入错误！\n";
+    clear_input_buffer();
+    return;
+  }
+
+  CsvImportResult result = import_csv(manager, path);
+  if (!result.opened) {
+    std::cout << "无法打开文件！\n";
+    return;
+  }
+  std::cout << "已导入 " << result.added << " 名学生，" << result.error_count << " 行有错误\n";
+  constexpr std::size_t kShownErrors = 10;
+  for (std::size_t i = 0; i < result.errors.size() && i < kShownErrors; ++i) {
+    std::cout << "  第 " << result.errors[i].line << " 行: " << result.errors[i].message << "\n";
+  }
+  if (result.error_count > kShownErrors) {
+    std::cout << "  ...\n";
+  }
+}
+
+/// 把所有学生导出为 CSV 文件
+void export_to_csv(const StudentManager& manager) {
+  std::string path;
+
+  std::cout << "请输入 CSV 文件名: ";
+  if (!(std::cin >> path)) {
+    std::cout << "输入错误！\n";
+    clear_input_buffer();
+    return;
+  }
+
+  if (export_csv(manager, path)) {
+    std::cout << "已导出 " << manager.get_student_count() << " 名学生！\n";
+  } else {
+    std::cout << "导出失败！\n";
+  }
+}
+
+/// 显示各个操作的调用次数和耗时分布
+void show_metrics(const StudentManager& manager) { std::cout << manager.metrics().to_text(); }
+
+/// 显示命令行用法
+void show_usage() {
+  std::cout << "用法:\n";
+  std::cout << "  student_manager                       交互式菜单\n";
+  std::cout << "  student_manager --batch [文件] [--quiet]  批处理模式：从文件（默认标准输入）读取命令\n";
+  std::cout << "\n批处理命令（每行一条）:\n";
+  std::cout << "  add 姓名 学号 成绩 | remove 学号 | find 学号 | set 学号 成绩 | stats\n";
+}
+
+/// 批处理模式：执行命令后退出，有格式错误时返回 1
+int run_batch_mode(const char* path, const BatchOptions& options) {
+  std::FILE* input = stdin;
+  if (path != nullptr) {
+    input = std::fopen(path, "rb");
+    if (input == nullptr) {
+      std::cerr << "无法打开文件: " << path << "\n";
+      return 2;
+    }
+  }
+  StudentManager manager;
+  BatchResult result = run_batch(manager, input, stdout, stderr, options);
+  if (input != stdin) {
+    std::fclose(input);
+  }
+  return result.syntax_errors == 0 ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+  // 命令行参数：--batch 进入批处理模式，否则显示交互式菜单
+  bool batch = false;
+  const char* batch_path = nullptr;
+  BatchOptions batch_options;
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg = argv[i];
+    if (arg == "--batch") {
+      batch = true;
+    } else if (arg == "--quiet") {
+      batch_options.quiet = true;
+    } else if (arg == "--help" || arg == "-h") {
+      show_usage();
+      return 0;
+    } else if (batch && batch_path == nullptr && arg.substr(0, 2) != "--") {
+      batch_path = argv[i];
+    } else {
+      std::cerr << "未知参数: " << arg << "\n";
+      show_usage();
+      return 2;
+    }
+  }
+  if (batch) {
+    return run_batch_mode(batch_path, batch_options);
+  }
+
   StudentManager manager;
   int choice;
 
@@ -244,6 +395,21 @@ int main() {
       case 7:
         show_statistics(manager);
         break;
+      case 8:
+        save_to_file(manager);
+        break;
+      case 9:
+        load_from_file(manager);
+        break;
+      case 10:
+        import_from_csv(manager);
+        break;
+      case 11:
+        export_to_csv(manager);
+        break;
+      case 12:
+        show_metrics(manager);
+        break;
       case 0:
         std::cout << "感谢使用，再见！\n";
         return 0;
@@ -0,0 +1,82 @@
+/**
+ * @file batch_lookup_tests.cpp
+ * @brief 批量查找和批量修改成绩的单元测试
+ */
+
+#include <doctest/doctest.h>
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "student_manager/student_manager.h"
+
+using namespace student_manager;
+
+TEST_CASE("批量查找按输入顺序返回结果") {
+  StudentManager manager;
+  for (int i = 0; i < 500; ++i) {
+    manager.add_student(Student("学生" + std::to_string(i), std::to_string(2023000 + i), i % 100));
+  }
+  // 不能压缩成整数的学号（字母、前导零）走字符串比较
+  manager.add_student(Student("张三", "S001", 88.0));
+  manager.add_student(Student("李四", "007", 77.0));
+
+  std::vector<std::string> ids = {"2023499", "S001", "9999999", "007", "2023000", "7", "S001"};
+  auto found = manager.find_students(ids);
+  REQUIRE(found.size() == ids.size());
+  CHECK(found[0]->get().get_name() == "学生499");
+  CHECK(found[1]->get().get_name() == "张三");
+  CHECK_FALSE(found[2].has_value());
+  CHECK(found[3]->get().get_name() == "李四");
+  CHECK(found[4]->get().get_name() == "学生0");
+  CHECK_FALSE(found[5].has_value());
+  CHECK(&found[6]->get() == &found[1]->get());
+
+  // 结果与逐个调用 find_student() 相同
+  std::vector<std::string_view> views;
+  for (int i = 0; i < 600; i += 7) {
+    views.push_back(manager.get_all_students()[static_cast<std::size_t>(i) % 502].get_id());
+  }
+  views.push_back("不存在");
+  auto batch = manager.find_students(views);
+  bool same = true;
+  for (std::size_t i = 0; i < views.size(); ++i) {
+    auto single = manager.find_student(views[i]);
+    same = same && batch[i].has_value() == single.has_value()
+           && (!single || &batch[i]->get() == &single->get());
+  }
+  CHECK(same);
+
+  CHECK(manager.find_students(std::vector<std::string>{}).empty());
+  CHECK_FALSE(StudentManager().find_students(ids)[0].has_value());
+}
+
+TEST_CASE("批量修改成绩") {
+  StudentManager manager;
+  manager.add_student(Student("张三", "2023001", 60.0));
+  manager.add_student(Student("李四", "2023002", 70.0));
+  manager.add_student(Student("王五", "A-3", 80.0));
+  manager.enable_ranking_index();
+
+  std::vector<std::pair<std::string, double>> updates = {
+      {"2023001", 90.0}, {"9999999", 50.0}, {"A-3", 40.0}, {"2023001", 95.0}};
+  auto results = manager.update_scores(updates);
+  CHECK(results
+        == std::vector<UpdateStatus>{UpdateStatus::updated, UpdateStatus::not_found,
+                                     UpdateStatus::updated, UpdateStatus::updated});
+
+  // 同一学号出现多次时以最后一次为准，统计量和排名索引随之更新
+  CHECK(manager.find_student("2023001")->get().get_score() == doctest::Approx(95.0));
+  CHECK(manager.find_student("A-3")->get().get_score() == doctest::Approx(40.0));
+  CHECK(manager.get_max_score() == doctest::Approx(95.0));
+  CHECK(manager.get_min_score() == doctest::Approx(40.0));
+  CHECK(manager.calculate_average_score() == doctest::Approx((95.0 + 70.0 + 40.0) / 3));
+  CHECK(manager.rank_of("2023001") == 1);
+
+  std::vector<std::pair<std::string_view, int>> integral = {{"2023002", 100}};
+  CHECK(manager.update_scores(integral) == std::vector<UpdateStatus>{UpdateStatus::updated});
+  CHECK(manager.get_max_score() == doctest::Approx(100.0));
+  CHECK(manager.update_scores(std::vector<std::pair<std::string, double>>{}).empty());
+}
@@ -0,0 +1,167 @@
+/**
+ * @file batch_mode_tests.cpp
+ * @brief 独立程序批处理模式单元测试
+ *
+ * 输入和输出都使用 std::tmpfile() 创建的临时文件，与读写真实文件或标准输入输出的路径相同。
+ */
+
+#include <doctest/doctest.h>
+
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include "batch_mode.h"
+#include "student_manager/student_manager.h"
+
+using namespace student_manager;
+
+namespace {
+
+  struct FileCloser {
+    void operator()(std::FILE* file) const noexcept { std::fclose(file); }
+  };
+  using File = std::unique_ptr<std::FILE, FileCloser>;
+
+  /// 读出整个文件的内容
+  std::string read_all(std::FILE* file) {
+    std::rewind(file);
+    std::string text;
+    char buffer[4096];
+    for (std::size_t read; (read = std::fread(buffer, 1, sizeof(buffer), file)) > 0;) {
+      text.append(buffer, read);
+    }
+    return text;
+  }
+
+  /// 一次批处理的结果和输出
+  struct BatchRun {
+    BatchResult result;
+    std::string output;
+    std::string errors;
+  };
+
+  BatchRun run(StudentManager& manager, const std::string& commands,
+               const BatchOptions& options = {}) {
+    File input(std::tmpfile());
+    File output(std::tmpfile());
+    File errors(std::tmpfile());
+    REQUIRE(input);
+    REQUIRE(output);
+    REQUIRE(errors);
+    std::fwrite(commands.data(), 1, commands.size(), input.get());
+    std::rewind(input.get());
+
+    BatchRun run;
+    run.result = run_batch(manager, input.get(), output.get(), errors.get(), options);
+    run.output = read_all(output.get());
+    run.errors = read_all(errors.get());
+    return run;
+  }
+
+}  // namespace
+
+TEST_CASE("批处理执行每一种命令") {
+  StudentManager manager;
+  BatchRun batch = run(manager,
+                       "add 张三 2023001 85.5\n"
+                       "add 李四 2023002 60\n"
+                       "add 王五 2023001 70\n"
+                       "find 2023001\n"
+                       "set 2023002 90\n"
+                       "set 9999999 90\n"
+                       "remove 2023001\n"
+                       "remove 2023001\n"
+                       "find 2023001\n"
+                       "stats\n");
+  CHECK(batch.output
+        == "ok\nok\nduplicate\n张三 2023001 85.5\nok\nnot_found\nok\nnot_found\nnot_found\n"
+           "count=1 average=90 max=90 min=90\n");
+  CHECK(batch.result.commands == 10);
+  CHECK(batch.result.failed == 4);
+  CHECK(batch.result.syntax_errors == 0);
+  CHECK(batch.errors == "已执行 10 条命令，4 条未成功，0 行格式错误\n");
+  CHECK(manager.get_student_count() == 1);
+
+  manager.clear();
+  CHECK(run(manager, "stats").output == "count=0 average=0 max=- min=-\n");
+}
+
+TEST_CASE("批处理跳过注释、空行和行尾的 \\r") {
+  StudentManager manager;
+  BatchRun batch = run(manager,
+                       "# 注释\r\n"
+                       "\r\n"
+                       "   \t  \n"
+                       "add\t张三   2023001 85 # 行尾注释\r\n"
+                       "find 2023001\r\n"
+                       "find 2023001");  // 最后一行没有换行符
+  CHECK(batch.output == "ok\n张三 2023001 85\n张三 2023001 85\n");
+  CHECK(batch.result.commands == 3);
+  CHECK(batch.result.syntax_errors == 0);
+}
+
+TEST_CASE("批处理报告格式错误的行号并跳过这一行") {
+  StudentManager manager;
+  BatchRun batch = run(manager,
+                       "add 张三 2023001\n"
+                       "add 张三 2023001 85 extra\n"
+                       "hello 2023001\n"
+                       "set 2023001\n"
+                       "add 张三 2023001 abc\n"
+                       "add 张三 2023001 101\n"
+                       "stats now\n"
+                       "add 张三 2023001 85\n");
+  CHECK(batch.output == "ok\n");
+  CHECK(batch.result.commands == 1);
+  CHECK(batch.result.syntax_errors == 7);
+  CHECK(batch.errors
+        == "第 1 行: 参数个数不对\n"
+           "第 2 行: 参数个数不对\n"
+           "第 3 行: 未知命令\n"
+           "第 4 行: 参数个数不对\n"
+           "第 5 行: 成绩必须是 0-100 之间的数字\n"
+           "第 6 行: 成绩必须是 0-100 之间的数字\n"
+           "第 7 行: 参数个数不对\n"
+           "已执行 1 条命令，0 条未成功，7 行格式错误\n");
+}
+
+TEST_CASE("批处理 --quiet 只输出查询结果") {
+  StudentManager manager;
+  BatchOptions options;
+  options.quiet = true;
+  BatchRun batch = run(manager,
+                       "add 张三 2023001 85\n"
+                       "add 张三 2023001 85\n"
+                       "set 2023001 95\n"
+                       "remove 9999999\n"
+                       "find 2023001\n"
+                       "find 9999999\n"
+                       "stats\n"
+                       "oops\n",
+                       options);
+  CHECK(batch.output == "张三 2023001 95\nnot_found\ncount=1 average=95 max=95 min=95\n");
+  CHECK(batch.result.failed == 3);
+  CHECK(batch.errors == "第 8 行: 未知命令\n");  // 格式错误照常报告，没有汇总
+}
+
+TEST_CASE("批处理读取跨越多个 64 KB 块的输入和超长的行") {
+  StudentManager manager;
+  std::string commands;
+  for (int i = 0; i < 20000; ++i) {
+    commands += "add 学生" + std::to_string(i) + " " + std::to_string(100000 + i) + " "
+                + std::to_string(i % 101) + "\n";
+  }
+  std::string long_name(200000, 'x');  // 一行比读取块大得多
+  commands += "add " + long_name + " L1 50\n";
+  commands += "find L1\n";
+  commands += "find 119999\n";
+
+  BatchOptions options;
+  options.quiet = true;
+  BatchRun batch = run(manager, commands, options);
+  CHECK(batch.result.commands == 20003);
+  CHECK(batch.result.syntax_errors == 0);
+  CHECK(manager.get_student_count() == 20001);
+  CHECK(batch.output == long_name + " L1 50\n学生19999 119999 1\n");
+}
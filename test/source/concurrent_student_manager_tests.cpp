@@ -0,0 +1,134 @@
+/**
+ * @file concurrent_student_manager_tests.cpp
+ * @brief 线程安全学生管理类的单元测试和多线程压力测试
+ */
+
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "student_manager/concurrent_student_manager.h"
+
+using namespace student_manager;
+
+TEST_CASE("分片管理器的单线程行为与 StudentManager 相同") {
+  ConcurrentStudentManager manager(8);
+  CHECK(manager.shard_count() == 8);
+  CHECK(manager.empty());
+  CHECK_FALSE(manager.get_max_score());
+
+  CHECK(manager.add_student(Student("张三", "2023001", 80.0)));
+  CHECK(manager.add_student(Student("李四", "2023002", 90.0)));
+  CHECK_FALSE(manager.add_student(Student("重复", "2023001", 10.0)));
+  CHECK(manager.get_student_count() == 2);
+  CHECK(manager.calculate_average_score() == doctest::Approx(85.0));
+  CHECK(*manager.get_max_score() == 90.0);
+  CHECK(*manager.get_min_score() == 80.0);
+
+  REQUIRE(manager.find_student("2023001"));
+  CHECK(manager.find_student("2023001")->get_name() == "张三");
+  CHECK(manager.update_score("2023001", 70.0));
+  CHECK(manager.adjust_score("2023001", [](double score) { return score + 5.0; }));
+  double seen = 0.0;
+  CHECK(manager.visit_student("2023001", [&](const Student& s) { seen = s.get_score(); }));
+  CHECK(seen == 75.0);
+  CHECK_FALSE(manager.update_score("9999999", 70.0));
+
+  CHECK(manager.remove_student("2023002"));
+  CHECK_FALSE(manager.contains("2023002"));
+  CHECK(manager.get_all_students().size() == 1);
+  manager.clear();
+  CHECK(manager.empty());
+}
+
+TEST_CASE("分片数向上取整到 2 的幂") {
+  CHECK(ConcurrentStudentManager(1).shard_count() == 1);
+  CHECK(ConcurrentStudentManager(5).shard_count() == 8);
+  CHECK(ConcurrentStudentManager().shard_count() >= 16);
+
+  // 只有一个分片时所有学生都在同一个分片中
+  ConcurrentStudentManager single(1);
+  for (int i = 0; i < 100; ++i) {
+    single.add_student(Student("学生", std::to_string(i), i));
+  }
+  CHECK(single.get_student_count() == 100);
+  CHECK(single.find_student("42")->get_score() == 42.0);
+}
+
+TEST_CASE("多线程同时增删查改后数据保持一致") {
+  constexpr int kThreads = 8;
+  constexpr int kIdsPerThread = 2000;
+  ConcurrentStudentManager manager(16);
+  manager.reserve(kThreads * kIdsPerThread);
+
+  // 每个线程只修改自己的学号范围，同时读取所有线程的学号，并且不断查询整体统计
+  std::atomic<bool> failed{false};
+  std::vector<std::thread> workers;
+  for (int t = 0; t < kThreads; ++t) {
+    workers.emplace_back([&, t] {
+      std::mt19937 rng(static_cast<unsigned>(t));
+      std::uniform_int_distribution<int> pick(0, kIdsPerThread - 1);
+      std::uniform_int_distribution<int> other(0, kThreads * kIdsPerThread - 1);
+      auto id_of = [](int index) { return std::to_string(1000000 + index); };
+
+      for (int i = 0; i < kIdsPerThread; ++i) {
+        if (!manager.add_student(Student("学生", id_of(t * kIdsPerThread + i), 50.0))) {
+          failed = true;
+        }
+      }
+      for (int step = 0; step < 20000; ++step) {
+        int mine = t * kIdsPerThread + pick(rng);
+        switch (step % 5) {
+          case 0:
+            manager.update_score(id_of(mine), step % 101);
+            break;
+          case 1:
+            manager.adjust_score(id_of(mine), [](double score) { return 100.0 - score; });
+            break;
+          case 2:
+            (void)manager.find_student(id_of(other(rng)));
+            break;
+          case 3:
+            // 删除后立即加回，学生总数在最后保持不变
+            if (manager.remove_student(id_of(mine))
+                && !manager.add_student(Student("学生", id_of(mine), 50.0))) {
+              failed = true;
+            }
+            break;
+          default: {
+            double average = manager.calculate_average_score();
+            if (average < 0.0 || average > 100.0) {
+              failed = true;
+            }
+            break;
+          }
+        }
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  CHECK_FALSE(failed.load());
+  CHECK(manager.get_student_count() == kThreads * kIdsPerThread);
+
+  // 合并得到的统计量与逐个学生重新计算的结果一致
+  auto students = manager.get_all_students();
+  REQUIRE(students.size() == static_cast<std::size_t>(kThreads * kIdsPerThread));
+  double total = 0.0;
+  double max_score = 0.0;
+  for (const Student& student : students) {
+    total += student.get_score();
+    max_score = std::max(max_score, student.get_score());
+    CHECK(Student::is_valid_score(student.get_score()));
+  }
+  CHECK(manager.calculate_average_score()
+        == doctest::Approx(total / static_cast<double>(students.size())));
+  CHECK(*manager.get_max_score() == max_score);
+}
@@ -0,0 +1,153 @@
+/**
+ * @file csv_tests.cpp
+ * @brief CSV 导入导出单元测试
+ */
+
+#include <doctest/doctest.h>
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+#include "student_manager/csv.h"
+#include "student_manager/student_manager.h"
+
+using namespace student_manager;
+
+TEST_CASE("CSV 导出后可以原样导入") {
+  StudentManager manager;
+  manager.add_student(Student("张三", "2023001", 85.5));
+  manager.add_student(Student("Smith, John", "2023002", 92.0));
+  manager.add_student(Student("say \"hi\"", "S-3", 0.1));
+
+  std::stringstream buffer;
+  REQUIRE(export_csv(manager, buffer));
+  CHECK(buffer.str().find("\"Smith, John\",2023002,92\n") != std::string::npos);
+  CHECK(buffer.str().find("\"say \"\"hi\"\"\"") != std::string::npos);
+
+  StudentManager loaded;
+  CsvImportResult result = import_csv(loaded, buffer);
+  CHECK(result.opened);
+  CHECK(result.rows == 3);
+  CHECK(result.added == 3);
+  CHECK(result.error_count == 0);
+  REQUIRE(loaded.get_student_count() == 3);
+  CHECK(loaded.find_student("2023002")->get().get_name() == "Smith, John");
+  CHECK(loaded.find_student("S-3")->get().get_name() == "say \"hi\"");
+  CHECK(loaded.find_student("S-3")->get().get_score() == 0.1);
+}
+
+TEST_CASE("CSV 引号中的换行可以原样导出和导入") {
+  StudentManager manager;
+  manager.add_student(Student("a\nb", "1", 10.0));
+  manager.add_student(Student("c\r\nd", "2", 20.0));
+  for (int i = 3; i < 200; ++i) {
+    manager.add_student(Student("line\n" + std::to_string(i), std::to_string(i), 30.0));
+  }
+
+  std::stringstream buffer;
+  REQUIRE(export_csv(manager, buffer));
+
+  CsvOptions options;
+  options.chunk_size = 7;  // 块边界会落在引号中间
+  options.threads = 3;
+  StudentManager loaded;
+  CsvImportResult result = import_csv(loaded, buffer, options);
+  CHECK(result.error_count == 0);
+  CHECK(result.added == 199);
+  REQUIRE(loaded.get_student_count() == 199);
+  CHECK(loaded.find_student("1")->get().get_name() == "a\nb");
+  CHECK(loaded.find_student("2")->get().get_name() == "c\r\nd");
+  CHECK(loaded.find_student("199")->get().get_name() == "line\n199");
+
+  // 跨行的记录按物理行计算行号，错误报告在记录开始的一行
+  std::istringstream in("name,id,score\n\"x\ny\",7,50\nbad,8,abc\n");
+  StudentManager other;
+  result = import_csv(other, in);
+  CHECK(result.added == 1);
+  REQUIRE(result.errors.size() == 1);
+  CHECK(result.errors[0].line == 4);
+}
+
+TEST_CASE("CSV 导入时报告每一行的错误") {
+  std::istringstream in(
+      "\xEF\xBB\xBF姓名,学号,成绩\r\n"
+      "张三,2023001,85\r\n"
+      "\r\n"
+      "李四,2023002\r\n"
+      "王五,2023003,abc\r\n"
+      "赵六,2023004,101\r\n"
+      "钱七,,60\r\n"
+      "孙八,2023001,70\r\n"
+      "\"周九,2023005,70\r\n"
+      " 吴十 , 2023006 , 99.5 \r\n");
+
+  StudentManager manager;
+  CsvImportResult result = import_csv(manager, in);
+  CHECK(result.rows == 8);
+  CHECK(result.added == 2);
+  CHECK(result.error_count == 6);
+  REQUIRE(result.errors.size() == 6);
+  CHECK(result.errors[0].line == 4);
+  CHECK(result.errors[0].message == "字段数量应为 3");
+  CHECK(result.errors[1].line == 5);
+  CHECK(result.errors[2].line == 6);
+  CHECK(result.errors[3].line == 7);
+  CHECK(result.errors[3].message == "学号为空");
+  CHECK(result.errors[4].line == 8);
+  CHECK(result.errors[4].message == "学号重复");
+  CHECK(result.errors[5].line == 9);
+
+  // 第一次出现的学号被保留，字段两端的空格被去掉
+  CHECK(manager.find_student("2023001")->get().get_score() == 85.0);
+  REQUIRE(manager.find_student("2023006"));
+  CHECK(manager.find_student("2023006")->get().get_name() == "吴十");
+}
+
+TEST_CASE("CSV 分成很多小块并行解析时结果与顺序解析相同") {
+  std::string text = "name,id,score\n";
+  for (int i = 0; i < 2000; ++i) {
+    text += "student" + std::to_string(i) + "," + std::to_string(100000 + i % 1500) + ","
+            + std::to_string(i % 101) + "\n";
+  }
+
+  CsvOptions options;
+  options.chunk_size = 97;  // 故意让块边界落在行中间
+  options.threads = 4;
+  options.max_errors = 10;
+
+  std::istringstream in(text);
+  StudentManager manager;
+  CsvImportResult result = import_csv(manager, in, options);
+  CHECK(result.rows == 2000);
+  CHECK(result.added == 1500);
+  CHECK(result.error_count == 500);
+  REQUIRE(result.errors.size() == 10);
+  CHECK(result.errors.front().line == 1502);  // 第 1501 个学生（表头是第 1 行）
+  CHECK(manager.get_student_count() == 1500);
+  CHECK(manager.find_student("100007")->get().get_name() == "student7");
+  CHECK(manager.find_student("101499")->get().get_score() == 1499 % 101);
+}
+
+TEST_CASE("CSV 支持自定义分隔符和无表头文件") {
+  CsvOptions options;
+  options.delimiter = ';';
+  options.has_header = false;
+
+  std::istringstream in("a;1;50\nb;2;60");  // 最后一行没有换行
+  StudentManager manager;
+  CsvImportResult result = import_csv(manager, in, options);
+  CHECK(result.added == 2);
+  CHECK(manager.find_student("2")->get().get_score() == 60.0);
+
+  std::ostringstream out;
+  REQUIRE(export_csv(manager, out, options));
+  CHECK(out.str() == "a;1;50\nb;2;60\n");
+}
+
+TEST_CASE("CSV 文件不存在时导入失败") {
+  StudentManager manager;
+  CsvImportResult result = import_csv(manager, "no_such_file_for_csv_test.csv");
+  CHECK_FALSE(result.opened);
+  CHECK(manager.empty());
+}
@@ -0,0 +1,132 @@
+/**
+ * @file fixed_score_tests.cpp
+ * @brief 定点成绩单元测试
+ */
+
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "student_manager/fixed_score.h"
+#include "student_manager/statistics.h"
+#include "student_manager/student_manager.h"
+
+using namespace student_manager;
+
+TEST_CASE("FixedScore 与 double 互相换算") {
+  CHECK(FixedScore::from_double(0.0)->raw() == 0);
+  CHECK(FixedScore::from_double(100.0)->raw() == FixedScore::kMaxRaw);
+  CHECK(FixedScore::from_double(85.555)->raw() == 8556);  // 四舍五入
+  CHECK(FixedScore::from_double(85.554)->raw() == 8555);
+  CHECK_FALSE(FixedScore::from_double(-0.01));
+  CHECK_FALSE(FixedScore::from_double(100.01));
+  CHECK_FALSE(FixedScore::from_double(std::numeric_limits<double>::quiet_NaN()));
+
+  // 每个两位小数换算回 double 后与直接写出的字面量完全相同
+  for (std::uint16_t raw = 0; raw <= FixedScore::kMaxRaw; ++raw) {
+    double value = FixedScore::from_raw(raw).to_double();
+    REQUIRE(FixedScore::from_double(value)->raw() == raw);
+  }
+  CHECK(FixedScore::from_raw(8556).to_double() == 85.56);
+  CHECK(FixedScore::from_raw(1) < FixedScore::from_raw(2));
+}
+
+TEST_CASE("定点统计与 double 统计一致") {
+  CHECK(compute_fixed_score_statistics(nullptr, 0).count == 0);
+
+  std::mt19937 rng(5);
+  for (std::size_t count : {1u, 2u, 4u, 5u, 1000u, 54321u}) {
+    std::vector<std::uint16_t> raw(count);
+    std::vector<double> scores(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      raw[i] = static_cast<std::uint16_t>(rng() % 10001);
+      scores[i] = FixedScore::from_raw(raw[i]).to_double();
+    }
+    ScoreStatistics fixed = compute_fixed_score_statistics(raw.data(), count);
+    ScoreStatistics expected = compute_score_statistics(scores.data(), count);
+    CHECK(fixed.count == expected.count);
+    CHECK(fixed.mean == doctest::Approx(expected.mean));
+    CHECK(fixed.variance == doctest::Approx(expected.variance));
+    CHECK(fixed.min == expected.min);
+    CHECK(fixed.max == expected.max);
+    CHECK(fixed.percentile_25 == doctest::Approx(expected.percentile_25));
+    CHECK(fixed.median == doctest::Approx(expected.median));
+    CHECK(fixed.percentile_75 == doctest::Approx(expected.percentile_75));
+    CHECK(fixed.percentile_90 == doctest::Approx(expected.percentile_90));
+  }
+}
+
+TEST_CASE("定点平均分是精确的") {
+  // 0.1 分无法用 double 精确表示：逐个累加 double 会产生误差，整数累加不会
+  std::vector<std::uint16_t> raw(1'000'000, 10);
+  ScoreStatistics stats = compute_fixed_score_statistics(raw.data(), raw.size());
+  CHECK(stats.mean == 0.1);
+  CHECK(stats.variance == 0.0);
+
+  double naive = 0.0;
+  for (std::size_t i = 0; i < raw.size(); ++i) {
+    naive += 0.1;
+  }
+  CHECK(naive / static_cast<double>(raw.size()) != 0.1);
+}
+
+TEST_CASE("定点科目") {
+  StudentManager manager;
+  manager.add_student(Student("张三", "2023001", 0.0));
+  manager.add_student(Student("李四", "2023002", 0.0));
+  manager.add_student(Student("王五", "2023003", 0.0));
+  std::size_t math = *manager.add_subject("高等数学", 4.0, ScoreStorage::hundredths);
+  std::size_t english = *manager.add_subject("大学英语", 2.0);
+  CHECK(manager.get_subject_scores().storage(math) == ScoreStorage::hundredths);
+  CHECK(manager.get_subject_scores().storage(english) == ScoreStorage::binary64);
+
+  CHECK(manager.set_subject_score("2023001", math, 90.126));
+  CHECK(manager.set_subject_score("2023002", math, 80.0));
+  CHECK_FALSE(manager.set_subject_score("2023003", math, 100.5));
+  CHECK(manager.set_subject_score("2023001", english, 90.126));
+
+  // 定点科目四舍五入到 0.01 分，double 科目保持原值
+  CHECK(manager.get_subject_score("2023001", math) == std::optional<double>(90.13));
+  CHECK(manager.get_subject_score("2023001", english) == std::optional<double>(90.126));
+  CHECK(manager.subject_average(math) == std::optional<double>(85.065));
+  CHECK(manager.student_gpa("2023001") == doctest::Approx(
+            (4.0 * ScoreMatrix::grade_point(90.13) + 2.0 * ScoreMatrix::grade_point(90.126))
+            / 6.0));
+
+  ScoreStatistics stats = manager.compute_subject_statistics(math);
+  CHECK(stats.count == 2);
+  CHECK(stats.min == 80.0);
+  CHECK(stats.max == 90.13);
+  CHECK(stats.median == doctest::Approx(85.065));
+
+  // 删除学生后成绩随行移动；加载快照时保留存放方式
+  manager.set_subject_score("2023003", math, 70.5);
+  CHECK(manager.remove_student("2023001"));
+  CHECK(manager.get_subject_score("2023003", math) == std::optional<double>(70.5));
+  CHECK(manager.subject_average(math) == std::optional<double>(75.25));
+  CHECK(manager.clear_subject_score("2023002", math));
+  CHECK(manager.get_subject_scores().count(math) == 1);
+
+  StudentManager copy(manager);
+  copy.clear();
+  CHECK(copy.get_subject_scores().storage(math) == ScoreStorage::hundredths);
+  CHECK_FALSE(copy.subject_average(math));
+
+  // 每个成绩 2 字节
+  StudentManager large;
+  large.reserve(10000);
+  for (int i = 0; i < 10000; ++i) {
+    large.add_student(Student("学生", std::to_string(i), 60.0));
+  }
+  std::size_t before = large.memory_usage().subject_scores;
+  large.add_subject("定点", 1.0, ScoreStorage::hundredths);
+  std::size_t fixed_bytes = large.memory_usage().subject_scores - before;
+  large.add_subject("浮点", 1.0);
+  std::size_t double_bytes = large.memory_usage().subject_scores - before - fixed_bytes;
+  CHECK(fixed_bytes < double_bytes / 3);
+}
@@ -0,0 +1,76 @@
+/**
+ * @file id_key_tests.cpp
+ * @brief 学号键单元测试
+ */
+
+#include <doctest/doctest.h>
+
+#include <string>
+
+#include "student_manager/id_key.h"
+#include "student_manager/student_manager.h"
+
+using namespace student_manager;
+
+TEST_CASE("IdKey 压缩纯数字学号") {
+  std::uint64_t key = IdKey::pack("2023001");
+  CHECK(key != IdKey::kNotNumeric);
+  CHECK(IdKey::width(key) == 7);
+  CHECK(IdKey::value(key) == 2023001);
+
+  // 前导零通过位数保留下来
+  CHECK(IdKey::pack("001234") != IdKey::pack("1234"));
+  CHECK(IdKey::width(IdKey::pack("001234")) == 6);
+  CHECK(IdKey::value(IdKey::pack("001234")) == 1234);
+  CHECK(IdKey::pack("0") != IdKey::pack("00"));
+
+  CHECK(IdKey::pack("99999999999999999") != IdKey::kNotNumeric);  // 17 位
+  CHECK(IdKey::pack("999999999999999999") == IdKey::kNotNumeric);  // 18 位
+}
+
+TEST_CASE("IdKey 非数字学号不压缩") {
+  CHECK(IdKey::pack("") == IdKey::kNotNumeric);
+  CHECK(IdKey::pack("S2023001") == IdKey::kNotNumeric);
+  CHECK(IdKey::pack("2023-001") == IdKey::kNotNumeric);
+  CHECK(IdKey::pack(" 2023001") == IdKey::kNotNumeric);
+  CHECK(IdKey("学号").is_numeric() == false);
+}
+
+TEST_CASE("IdKey 比较与哈希") {
+  auto text_of = [](std::string_view text) { return [text] { return text; }; };
+
+  IdKey numeric("2023001");
+  CHECK(numeric.matches(IdKey::pack("2023001"), text_of("2023001")));
+  CHECK_FALSE(numeric.matches(IdKey::pack("02023001"), text_of("02023001")));
+  CHECK_FALSE(numeric.matches(IdKey::kNotNumeric, text_of("S2023001")));
+
+  IdKey text("S2023001");
+  CHECK(text.matches(IdKey::kNotNumeric, text_of("S2023001")));
+  CHECK_FALSE(text.matches(IdKey::kNotNumeric, text_of("S2023002")));
+  CHECK_FALSE(text.matches(IdKey::pack("2023001"), text_of("2023001")));
+
+  CHECK(IdKey("2023001").hash() == numeric.hash());
+  CHECK(IdKey("2023001").hash() != IdKey("2023002").hash());
+}
+
+TEST_CASE("StudentManager 混合数字和非数字学号") {
+  StudentManager manager;
+  CHECK(manager.add_student(Student("甲", "001234", 80.0)));
+  CHECK(manager.add_student(Student("乙", "1234", 81.0)));
+  CHECK(manager.add_student(Student("丙", "A1234", 82.0)));
+  CHECK(manager.add_student(Student("丁", "123456789012345678901", 83.0)));  // 超过 17 位
+  CHECK_FALSE(manager.add_student(Student("重复", "001234", 0.0)));
+  CHECK_FALSE(manager.add_student(Student("重复", "A1234", 0.0)));
+
+  CHECK(manager.find_student("001234")->get().get_name() == "甲");
+  CHECK(manager.find_student("1234")->get().get_name() == "乙");
+  CHECK(manager.find_student("A1234")->get().get_name() == "丙");
+  CHECK(manager.find_student("123456789012345678901")->get().get_name() == "丁");
+  CHECK(manager.find_student("01234").has_value() == false);
+
+  // 删除引起的行移动之后，键列与学生列表仍然对应
+  CHECK(manager.remove_student("001234"));
+  CHECK(manager.find_student("123456789012345678901")->get().get_score() == 83.0);
+  CHECK(manager.find_student("1234")->get().get_score() == 81.0);
+  CHECK(manager.find_student("001234").has_value() == false);
+}
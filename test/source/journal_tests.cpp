@@ -0,0 +1,267 @@
+/**
+ * @file journal_tests.cpp
+ * @brief 预写日志单元测试
+ */
+
+#include <doctest/doctest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <optional>
+#include <string>
+
+#include "student_manager/journal.h"
+#include "student_manager/student_manager.h"
+
+using namespace student_manager;
+
+namespace {
+  /// 测试用的快照和日志文件，构造和析构时删除
+  struct JournalFiles {
+    std::string snapshot;
+    std::string journal;
+
+    explicit JournalFiles(const std::string& name)
+        : snapshot(name + ".snap"), journal(name + ".journal") {
+      remove_all();
+    }
+    ~JournalFiles() { remove_all(); }
+
+    void remove_all() const {
+      for (const std::string& path : {snapshot, snapshot + ".tmp", journal,
+                                      Journal::old_journal_path(journal)}) {
+        std::remove(path.c_str());
+      }
+    }
+  };
+
+  bool file_exists(const std::string& path) { return std::ifstream(path).good(); }
+
+  std::size_t count_records(const std::string& path, std::uint64_t after_sequence = 0) {
+    return replay_journal(path, after_sequence, [](const JournalRecord&) {}).applied;
+  }
+}  // namespace
+
+TEST_CASE("日志模式下的修改在重新打开后恢复") {
+  JournalFiles files("journal_recover_test");
+  {
+    StudentManager manager;
+    REQUIRE(manager.open_journal(files.snapshot, files.journal) == SnapshotStatus::ok);
+    CHECK(manager.has_journal());
+    manager.add_student(Student("张三", "2023001", 85.0));
+    manager.add_student(Student("李四", "2023002", 90.0));
+    manager.add_student(Student("一个很长很长的名字用来测试长字符串", "S-2023003", 70.0));
+    manager.find_student("2023001")->get().set_score(88.5);
+    manager.update_score("2023002", 60.0);
+    manager.remove_student("S-2023003");
+    CHECK(manager.sync_journal() == SnapshotStatus::ok);
+    CHECK(count_records(files.journal) == 6);
+  }  // 析构时同步并关闭日志
+
+  StudentManager recovered;
+  REQUIRE(recovered.open_journal(files.snapshot, files.journal) == SnapshotStatus::ok);
+  REQUIRE(recovered.get_student_count() == 2);
+  CHECK(recovered.find_student("2023001")->get().get_score() == 88.5);
+  CHECK(recovered.find_student("2023002")->get().get_score() == 60.0);
+  CHECK_FALSE(recovered.find_student("S-2023003"));
+
+  // 继续追加的记录接在已有记录之后
+  recovered.clear();
+  recovered.add_student(Student("王五", "2023004", 75.0));
+  CHECK(recovered.close_journal() == SnapshotStatus::ok);
+  CHECK_FALSE(recovered.has_journal());
+
+  StudentManager again;
+  REQUIRE(again.open_journal(files.snapshot, files.journal) == SnapshotStatus::ok);
+  REQUIRE(again.get_student_count() == 1);
+  CHECK(again.find_student("2023004"));
+}
+
+TEST_CASE("重新打开正在使用的日志不会丢失缓冲区中的记录") {
+  JournalFiles files("journal_reopen_test");
+  JournalOptions options;
+  options.group_commit_records = 1000;  // 记录留在缓冲区中，不会马上写入文件
+  options.group_commit_delay = std::chrono::milliseconds(10000);
+
+  StudentManager manager;
+  REQUIRE(manager.open_journal(files.snapshot, files.journal, options) == SnapshotStatus::ok);
+  manager.add_student(Student("张三", "2023001", 85.0));
+  manager.add_student(Student("李四", "2023002", 90.0));
+  REQUIRE(manager.open_journal(files.snapshot, files.journal, options) == SnapshotStatus::ok);
+  CHECK(manager.get_student_count() == 2);
+
+  // 新日志打开失败时保留原来的日志和数据
+  CHECK(manager.open_journal(files.snapshot, "no_such_dir/students.journal", options)
+        != SnapshotStatus::ok);
+  CHECK(manager.has_journal());
+  CHECK(manager.get_student_count() == 2);
+  manager.update_score("2023001", 95.0);
+  CHECK(manager.close_journal() == SnapshotStatus::ok);
+
+  StudentManager recovered;
+  REQUIRE(recovered.open_journal(files.snapshot, files.journal) == SnapshotStatus::ok);
+  REQUIRE(recovered.get_student_count() == 2);
+  CHECK(recovered.find_student("2023001")->get().get_score() == 95.0);
+}
+
+TEST_CASE("日志末尾写了一半的记录被截掉") {
+  JournalFiles files("journal_torn_test");
+  {
+    StudentManager manager;
+    REQUIRE(manager.open_journal(files.snapshot, files.journal) == SnapshotStatus::ok);
+    manager.add_student(Student("张三", "2023001", 85.0));
+    manager.add_student(Student("李四", "2023002", 90.0));
+  }
+  {
+    // 模拟断电：最后一条记录只写了一部分
+    std::ofstream out(files.journal, std::ios::binary | std::ios::app);
+    const char partial[20] = {48, 0, 0, 0, 1};
+    out.write(partial, sizeof(partial));
+  }
+
+  StudentManager manager;
+  REQUIRE(manager.open_journal(files.snapshot, files.journal) == SnapshotStatus::ok);
+  CHECK(manager.get_student_count() == 2);
+  manager.add_student(Student("王五", "2023003", 75.0));
+  CHECK(manager.close_journal() == SnapshotStatus::ok);
+  CHECK(count_records(files.journal) == 3);
+
+  StudentManager recovered;
+  REQUIRE(recovered.open_journal(files.snapshot, files.journal) == SnapshotStatus::ok);
+  CHECK(recovered.get_student_count() == 3);
+}
+
+TEST_CASE("同步压缩后日志被清空，快照记录了日志序号") {
+  JournalFiles files("journal_checkpoint_test");
+  StudentManager manager;
+  REQUIRE(manager.open_journal(files.snapshot, files.journal) == SnapshotStatus::ok);
+  for (int i = 0; i < 100; ++i) {
+    manager.add_student(Student("学生", std::to_string(2023000 + i), i));
+  }
+  REQUIRE(manager.checkpoint() == SnapshotStatus::ok);
+  CHECK(count_records(files.journal) == 0);
+
+  SnapshotView view;
+  REQUIRE(view.open(files.snapshot) == SnapshotStatus::ok);
+  CHECK(view.size() == 100);
+  CHECK(view.journal_sequence() == 100);
+
+  manager.update_score("2023005", 99.0);
+  CHECK(manager.close_journal() == SnapshotStatus::ok);
+  CHECK(count_records(files.journal) == 1);
+  CHECK(count_records(files.journal, 101) == 0);  // 序号不超过 101 的记录都被跳过
+
+  StudentManager recovered;
+  REQUIRE(recovered.open_journal(files.snapshot, files.journal) == SnapshotStatus::ok);
+  CHECK(recovered.get_student_count() == 100);
+  CHECK(recovered.find_student("2023005")->get().get_score() == 99.0);
+}
+
+TEST_CASE("后台压缩期间可以继续修改") {
+  JournalFiles files("journal_compact_test");
+  StudentManager manager;
+  REQUIRE(manager.open_journal(files.snapshot, files.journal) == SnapshotStatus::ok);
+  for (int i = 0; i < 1000; ++i) {
+    manager.add_student(Student("学生", std::to_string(2023000 + i), 60.0));
+  }
+  REQUIRE(manager.compact_journal() == SnapshotStatus::ok);
+  manager.update_score("2023000", 100.0);
+  manager.remove_student("2023999");
+  REQUIRE(manager.close_journal() == SnapshotStatus::ok);
+
+  CHECK_FALSE(file_exists(Journal::old_journal_path(files.journal)));
+  CHECK(count_records(files.journal) == 2);
+  SnapshotView view;
+  REQUIRE(view.open(files.snapshot) == SnapshotStatus::ok);
+  CHECK(view.journal_sequence() == 1000);
+
+  StudentManager recovered;
+  REQUIRE(recovered.open_journal(files.snapshot, files.journal) == SnapshotStatus::ok);
+  CHECK(recovered.get_student_count() == 999);
+  CHECK(recovered.find_student("2023000")->get().get_score() == 100.0);
+  CHECK(recovered.calculate_average_score() == doctest::Approx(60.04004));
+}
+
+TEST_CASE("压缩中途崩溃留下的旧日志在恢复时被合并") {
+  JournalFiles files("journal_old_test");
+  {
+    StudentManager manager;
+    REQUIRE(manager.open_journal(files.snapshot, files.journal) == SnapshotStatus::ok);
+    manager.add_student(Student("张三", "2023001", 85.0));
+    manager.add_student(Student("李四", "2023002", 90.0));
+  }
+  // 模拟：日志已改名为旧日志，新日志中又有一条记录，但快照还没写出
+  REQUIRE(std::rename(files.journal.c_str(), Journal::old_journal_path(files.journal).c_str())
+          == 0);
+  {
+    Journal journal(files.snapshot, files.journal, {});
+    REQUIRE(journal.open(2, 0) == SnapshotStatus::ok);
+    journal.log_score("2023001", 100.0);
+  }
+
+  StudentManager recovered;
+  REQUIRE(recovered.open_journal(files.snapshot, files.journal) == SnapshotStatus::ok);
+  CHECK(recovered.get_student_count() == 2);
+  CHECK(recovered.find_student("2023001")->get().get_score() == 100.0);
+  // 恢复时已经把两份日志合并进快照
+  CHECK_FALSE(file_exists(Journal::old_journal_path(files.journal)));
+  CHECK(count_records(files.journal) == 0);
+}
+
+TEST_CASE("日志超过阈值时自动压缩") {
+  JournalFiles files("journal_threshold_test");
+  JournalOptions options;
+  options.compact_threshold_bytes = 4096;
+  options.group_commit_records = 16;
+
+  StudentManager manager;
+  REQUIRE(manager.open_journal(files.snapshot, files.journal, options) == SnapshotStatus::ok);
+  for (int i = 0; i < 500; ++i) {
+    manager.add_student(Student("学生", std::to_string(2023000 + i), 60.0));
+  }
+  REQUIRE(manager.close_journal() == SnapshotStatus::ok);
+  CHECK(file_exists(files.snapshot));
+  CHECK(count_records(files.journal) < 500);
+
+  StudentManager recovered;
+  REQUIRE(recovered.open_journal(files.snapshot, files.journal) == SnapshotStatus::ok);
+  CHECK(recovered.get_student_count() == 500);
+}
+
+TEST_CASE("日志模式下不能修改科目成绩，打开日志时科目成绩被清空") {
+  JournalFiles files("journal_subject_test");
+  StudentManager manager;
+  manager.add_student(Student("张三", "2023001", 85.0));
+  std::size_t math = *manager.add_subject("高等数学", 4.0);
+  REQUIRE(manager.set_subject_score("2023001", math, 90.0));
+
+  REQUIRE(manager.open_journal(files.snapshot, files.journal) == SnapshotStatus::ok);
+  CHECK(manager.find_subject("高等数学") == std::optional<std::size_t>(math));
+  manager.add_student(Student("张三", "2023001", 85.0));
+  CHECK_FALSE(manager.get_subject_score("2023001", math));
+  CHECK_FALSE(manager.set_subject_score("2023001", math, 95.0));
+  CHECK_FALSE(manager.get_subject_score("2023001", math));
+  CHECK_FALSE(manager.clear_subject_score("2023001", math));
+
+  REQUIRE(manager.close_journal() == SnapshotStatus::ok);
+  CHECK(manager.set_subject_score("2023001", math, 95.0));
+  CHECK(manager.clear_subject_score("2023001", math));
+}
+
+TEST_CASE("拷贝出来的管理器不带日志") {
+  JournalFiles files("journal_copy_test");
+  StudentManager manager;
+  REQUIRE(manager.open_journal(files.snapshot, files.journal) == SnapshotStatus::ok);
+  manager.add_student(Student("张三", "2023001", 85.0));
+
+  StudentManager copy = manager;
+  CHECK_FALSE(copy.has_journal());
+  copy.add_student(Student("李四", "2023002", 90.0));
+
+  StudentManager moved = std::move(manager);
+  CHECK(moved.has_journal());
+  moved.update_score("2023001", 70.0);
+  REQUIRE(moved.close_journal() == SnapshotStatus::ok);
+  CHECK(count_records(files.journal) == 2);
+}
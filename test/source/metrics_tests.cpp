@@ -0,0 +1,155 @@
+/**
+ * @file metrics_tests.cpp
+ * @brief 性能统计单元测试
+ *
+ * 耗时直方图总是参与编译；StudentManager 的计数只在开启 STUDENT_MANAGER_METRICS 时检查。
+ */
+
+#include <doctest/doctest.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "student_manager/concurrent_student_manager.h"
+#include "student_manager/metrics.h"
+#include "student_manager/student_manager.h"
+
+using namespace student_manager;
+
+TEST_CASE("耗时直方图的分桶和百分位数") {
+  // 小于 16 纳秒每纳秒一个桶，之后相对误差不超过 1/16
+  CHECK(LatencyHistogram::bucket_of(0) == 0);
+  CHECK(LatencyHistogram::bucket_of(15) == 15);
+  CHECK(LatencyHistogram::bucket_of(16) == 16);
+  CHECK(LatencyHistogram::bucket_of(17) == 17);
+  CHECK(LatencyHistogram::bucket_of(32) == 32);
+  CHECK(LatencyHistogram::bucket_of(33) == 32);
+  CHECK(LatencyHistogram::bucket_of(~std::uint64_t{0}) == LatencyHistogram::kBuckets - 1);
+  bool bounded = true;
+  for (std::uint64_t value = 1; value < (std::uint64_t{1} << 39); value = value * 3 + 1) {
+    std::size_t bucket = LatencyHistogram::bucket_of(value);
+    std::uint64_t upper = LatencyHistogram::bucket_upper(bucket);
+    bounded = bounded && value <= upper && upper - value <= value / 16
+              && (bucket == 0 || LatencyHistogram::bucket_upper(bucket - 1) < value);
+  }
+  CHECK(bounded);
+
+  LatencyHistogram histogram;
+  CHECK(histogram.percentile(50) == 0);
+  for (std::uint64_t value = 1; value <= 1000; ++value) {
+    histogram.record(value * 1000);  // 1 到 1000 微秒
+  }
+  CHECK(histogram.count() == 1000);
+  CHECK(histogram.mean() == doctest::Approx(500500.0));
+  CHECK(histogram.max() == 1000000);
+  CHECK(histogram.percentile(100) == 1000000);
+  auto near = [](std::uint64_t actual, double expected) {
+    return actual >= expected && static_cast<double>(actual) <= expected * (1.0 + 1.0 / 16);
+  };
+  CHECK(near(histogram.percentile(50), 500000.0));
+  CHECK(near(histogram.percentile(99), 990000.0));
+  CHECK(histogram.percentile(0)
+        == LatencyHistogram::bucket_upper(LatencyHistogram::bucket_of(1000)));
+
+  LatencyHistogram other;
+  other.record(5000000);
+  histogram.merge(other);
+  CHECK(histogram.count() == 1001);
+  CHECK(histogram.max() == 5000000);
+}
+
+TEST_CASE("合并统计报告") {
+  MetricsReport a;
+  MetricsReport b;
+  b.enabled = true;
+  b.find_hits = 3;
+  b.find_misses = 1;
+  b.latency[static_cast<std::size_t>(Operation::find_student)].record(100);
+  a.merge(b);
+  a.merge(b);
+  CHECK(a.enabled);
+  CHECK(a.calls(Operation::find_student) == 2);
+  CHECK(a.find_hit_ratio() == doctest::Approx(0.75));
+  CHECK(a.to_text().find("find_student") != std::string::npos);
+  CHECK(MetricsReport().find_hit_ratio() == 0.0);
+}
+
+#if STUDENT_MANAGER_METRICS
+
+TEST_CASE("StudentManager 记录调用次数、命中率和重复学号") {
+  StudentManager manager;
+  manager.add_student(Student("张三", "2023001", 85.0));
+  manager.add_student(Student("李四", "2023002", 90.0));
+  manager.add_student(Student("张三", "2023001", 70.0));  // 重复
+  std::vector<Student> batch = {Student("王五", "2023003", 60.0), Student("赵六", "2023002", 1.0)};
+  manager.add_students(batch);
+
+  (void)manager.find_student("2023001");
+  (void)manager.find_student("2023003");
+  (void)manager.find_student("9999999");
+  manager.update_score("2023001", 95.0);
+  manager.remove_student("2023003");
+  (void)manager.compute_statistics();
+  (void)manager.sorted_by(SortKey::score);
+  (void)manager.count_in_range(60.0, 100.0);
+  (void)manager.kth_score(1);
+  (void)manager.top_k(1);
+  (void)manager.bottom_k(1);
+  (void)manager.bottom_k(2);
+  (void)manager.subject_average(0);
+  (void)manager.memory_usage();
+
+  MetricsReport report = manager.metrics();
+  CHECK(report.enabled);
+  CHECK(report.calls(Operation::add_student) == 3);
+  CHECK(report.calls(Operation::add_students) == 1);
+  CHECK(report.calls(Operation::find_student) == 3);
+  CHECK(report.calls(Operation::update_score) == 1);
+  CHECK(report.calls(Operation::remove_student) == 1);
+  CHECK(report.calls(Operation::compute_statistics) == 1);
+  CHECK(report.calls(Operation::sorted_by) == 1);
+  CHECK(report.calls(Operation::count_in_range) == 1);
+  CHECK(report.calls(Operation::kth_score) == 1);
+  CHECK(report.calls(Operation::top_k) == 1);
+  CHECK(report.calls(Operation::bottom_k) == 2);
+  CHECK(report.calls(Operation::subject_average) == 1);
+  CHECK(report.calls(Operation::memory_usage) == 1);
+  CHECK(report.find_hits == 2);
+  CHECK(report.find_misses == 1);
+  CHECK(report.duplicates_rejected == 2);
+  const LatencyHistogram& adds = report.of(Operation::add_student);
+  CHECK(adds.max() >= adds.percentile(50));
+  CHECK(report.to_text().find("remove_student") != std::string::npos);
+
+  // 复制时统计一起复制；清空数据不清空统计
+  StudentManager copy(manager);
+  CHECK(copy.metrics().calls(Operation::find_student) == 3);
+  manager.clear();
+  CHECK(manager.metrics().calls(Operation::clear) == 1);
+  CHECK(manager.metrics().calls(Operation::find_student) == 3);
+  manager.reset_metrics();
+  CHECK(manager.metrics().calls(Operation::find_student) == 0);
+
+  ConcurrentStudentManager concurrent(4);
+  for (int i = 0; i < 100; ++i) {
+    concurrent.add_student(Student("学生", std::to_string(i), 60.0));
+  }
+  (void)concurrent.find_student("5");
+  CHECK(concurrent.metrics().calls(Operation::add_student) == 100);
+  CHECK(concurrent.metrics().find_hits == 1);
+}
+
+#else
+
+TEST_CASE("未开启性能统计时返回空报告") {
+  StudentManager manager;
+  manager.add_student(Student("张三", "2023001", 85.0));
+  (void)manager.find_student("2023001");
+  MetricsReport report = manager.metrics();
+  CHECK_FALSE(report.enabled);
+  CHECK(report.calls(Operation::find_student) == 0);
+  CHECK(report.to_text().find("STUDENT_MANAGER_METRICS") != std::string::npos);
+}
+
+#endif
@@ -0,0 +1,114 @@
+/**
+ * @file name_index_tests.cpp
+ * @brief 姓名索引单元测试
+ */
+
+#include <doctest/doctest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "student_manager/name_index.h"
+#include "student_manager/student_manager.h"
+
+using namespace student_manager;
+
+namespace {
+  std::vector<std::string> ids_of(const std::vector<std::reference_wrapper<const Student>>& rows) {
+    std::vector<std::string> ids;
+    for (const Student& student : rows) {
+      ids.emplace_back(student.get_id());
+    }
+    return ids;
+  }
+}  // namespace
+
+TEST_CASE("姓名索引的精确、前缀和包含查找") {
+  NameIndex index;
+  index.insert(0, "张三");
+  index.insert(1, "张三丰");
+  index.insert(2, "李四");
+  index.insert(3, "张三");
+  index.insert(4, "Alice");
+  CHECK(index.size() == 5);
+
+  CHECK(index.find_exact("张三") == std::vector<std::uint32_t>{0, 3});
+  CHECK(index.find_exact("王五").empty());
+
+  CHECK(index.find_prefix("张") == std::vector<std::uint32_t>{0, 3, 1});
+  CHECK(index.find_prefix("张", 2) == std::vector<std::uint32_t>{0, 3});
+  CHECK(index.find_prefix("Al") == std::vector<std::uint32_t>{4});
+  // "张" 的 UTF-8 编码是 3 个字节，只给出前两个字节时忽略这半个字符，匹配所有姓名
+  CHECK(index.find_prefix(std::string_view("张").substr(0, 2)).size() == 5);
+
+  CHECK(index.find_substring("三") == std::vector<std::uint32_t>{0, 1, 3});
+  CHECK(index.find_substring("三丰") == std::vector<std::uint32_t>{1});
+  CHECK(index.find_substring("张三丰") == std::vector<std::uint32_t>{1});
+  CHECK(index.find_substring("lic") == std::vector<std::uint32_t>{4});
+  CHECK(index.find_substring("四三").empty());
+  CHECK(index.find_substring("").size() == 5);
+
+  // 删除后查不到；槽位重新使用后只返回新的姓名
+  index.erase(1);
+  CHECK(index.find_substring("丰").empty());
+  index.insert(1, "王丰");
+  CHECK(index.find_substring("丰") == std::vector<std::uint32_t>{1});
+  CHECK(index.find_substring("三丰").empty());
+
+  NameIndex copy(index);
+  index.clear();
+  CHECK(index.find_exact("张三").empty());
+  CHECK(copy.find_exact("张三") == std::vector<std::uint32_t>{0, 3});
+  copy.erase(0);
+  CHECK(copy.find_exact("张三") == std::vector<std::uint32_t>{3});
+}
+
+TEST_CASE("启用与未启用姓名索引时查找结果相同") {
+  StudentManager manager;
+  const std::vector<std::string> surnames = {"张", "李", "王", "赵", "欧阳"};
+  const std::vector<std::string> given = {"三", "四", "明", "小明", "丽"};
+  std::mt19937 rng(11);
+  for (int i = 0; i < 3000; ++i) {
+    std::string name = surnames[rng() % surnames.size()] + given[rng() % given.size()];
+    manager.add_student(Student(name, std::to_string(100000 + i), 60.0));
+  }
+  // 删除一部分学生（会有学生被搬到前面的空位）
+  for (int i = 0; i < 3000; i += 3) {
+    manager.remove_student(std::to_string(100000 + i));
+  }
+
+  auto check_same = [&] {
+    StudentManager plain(manager);
+    plain.disable_name_index();
+    CHECK(ids_of(manager.find_students_by_name("张三"))
+          == ids_of(plain.find_students_by_name("张三")));
+    CHECK(ids_of(manager.find_students_by_name_substring("小明"))
+          == ids_of(plain.find_students_by_name_substring("小明")));
+    CHECK(ids_of(manager.find_students_by_name_substring("阳"))
+          == ids_of(plain.find_students_by_name_substring("阳")));
+    auto indexed = manager.find_students_by_name_prefix("欧阳");
+    auto scanned = plain.find_students_by_name_prefix("欧阳");
+    REQUIRE(indexed.size() == scanned.size());
+    bool same_names = true;
+    for (std::size_t i = 0; i < indexed.size(); ++i) {
+      same_names = same_names && indexed[i].get().get_name() == scanned[i].get().get_name();
+    }
+    CHECK(same_names);
+    CHECK(manager.find_students_by_name_prefix("王", 5).size() == 5);
+  };
+
+  manager.enable_name_index();
+  CHECK(manager.has_name_index());
+  check_same();
+
+  // 索引随添加和删除更新
+  manager.remove_student("100001");
+  manager.add_student(Student("张三", "999999", 90.0));
+  check_same();
+  CHECK(manager.find_students_by_name("张三").back().get().get_id() == "999999");
+  CHECK(manager.memory_usage().indexes > 0);
+
+  manager.clear();
+  CHECK(manager.find_students_by_name("张三").empty());
+}
@@ -0,0 +1,104 @@
+/**
+ * @file parallel_tests.cpp
+ * @brief 线程池和并行扫描单元测试
+ */
+
+#include <doctest/doctest.h>
+
+#include <atomic>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "student_manager/parallel.h"
+#include "student_manager/student_manager.h"
+
+using namespace student_manager;
+
+namespace {
+  /// 强制并行执行：不设串行阈值
+  const ParallelOptions kParallel{4, 0};
+
+  bool same_bits(double a, double b) { return std::memcmp(&a, &b, sizeof(double)) == 0; }
+}  // namespace
+
+TEST_CASE("线程池把每个任务恰好执行一次") {
+  ThreadPool pool(4);
+  CHECK(pool.thread_count() == 4);
+
+  std::vector<std::atomic<int>> runs(1000);
+  pool.run(runs.size(), 0, [&](std::size_t i) { ++runs[i]; });
+  bool all_once = true;
+  for (const auto& count : runs) {
+    all_once = all_once && count == 1;
+  }
+  CHECK(all_once);
+
+  // 任务内部再次调用 run() 时串行执行，不会死锁
+  std::atomic<int> inner{0};
+  pool.run(8, 0, [&](std::size_t) { pool.run(10, 0, [&](std::size_t) { ++inner; }); });
+  CHECK(inner == 80);
+
+  // 异常在调用线程中重新抛出，线程池之后仍然可用
+  CHECK_THROWS_AS(pool.run(100, 0,
+                           [](std::size_t i) {
+                             if (i == 42) {
+                               throw std::runtime_error("任务失败");
+                             }
+                           }),
+                  std::runtime_error);
+  std::atomic<int> after{0};
+  pool.run(10, 2, [&](std::size_t) { ++after; });
+  CHECK(after == 10);
+}
+
+TEST_CASE("并行和串行的统计结果逐位一致") {
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<double> dist(0.0, 100.0);
+  std::vector<double> scores(300'000);
+  for (double& score : scores) {
+    score = dist(rng);
+  }
+
+  auto serial = compute_score_statistics(scores.data(), scores.size(), ParallelOptions::serial());
+  auto parallel = compute_score_statistics(scores.data(), scores.size(), kParallel);
+  CHECK(same_bits(serial.mean, parallel.mean));
+  CHECK(same_bits(serial.variance, parallel.variance));
+  CHECK(serial.min == parallel.min);
+  CHECK(serial.max == parallel.max);
+  CHECK(serial.median == parallel.median);
+  CHECK(serial.percentile_90 == parallel.percentile_90);
+
+  double serial_sum = parallel::sum(scores.data(), scores.size(), ParallelOptions::serial());
+  CHECK(same_bits(serial_sum, parallel::sum(scores.data(), scores.size(), kParallel)));
+  CHECK(same_bits(serial_sum, parallel::sum(scores.data(), scores.size(), ParallelOptions{2, 0})));
+  CHECK(serial_sum / static_cast<double>(scores.size()) == doctest::Approx(serial.mean));
+}
+
+TEST_CASE("条件查询按原来的顺序返回结果") {
+  StudentManager manager;
+  for (int i = 0; i < 50'000; ++i) {
+    manager.add_student(Student("学生", std::to_string(1000000 + i), i % 101));
+  }
+
+  auto failed = [](const Student& student) { return student.get_score() < 60.0; };
+  auto count = manager.count_students_if(failed, kParallel);
+  CHECK(count == manager.count_students_if(failed, ParallelOptions::serial()));
+
+  auto rows = manager.find_students_if(failed, kParallel);
+  REQUIRE(rows.size() == count);
+  bool ordered = true;
+  for (std::size_t i = 1; i < rows.size(); ++i) {
+    ordered = ordered && &rows[i - 1].get() < &rows[i].get();
+  }
+  CHECK(ordered);
+  CHECK(rows.front().get().get_id() == "1000000");
+
+  // 没有学生时返回空结果
+  StudentManager empty;
+  CHECK(empty.count_students_if(failed) == 0);
+  CHECK(empty.find_students_if(failed).empty());
+  CHECK(empty.compute_statistics(kParallel).count == 0);
+}
@@ -0,0 +1,145 @@
+/**
+ * @file rank_index_tests.cpp
+ * @brief 成绩排名索引单元测试
+ */
+
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "student_manager/rank_index.h"
+#include "student_manager/student_manager.h"
+
+using namespace student_manager;
+
+TEST_CASE("RankIndex 基本操作") {
+  RankIndex index;
+  index.insert(0, 80.0);
+  index.insert(1, 95.0);
+  index.insert(2, 60.0);
+  index.insert(3, 80.0);
+
+  CHECK(index.size() == 4);
+  CHECK(index.count_greater(80.0) == 1);
+  CHECK(index.count_greater(100.0) == 0);
+  CHECK(index.count_greater(0.0) == 4);
+  CHECK(index.kth_largest(0) == 1);
+  CHECK(index.score_of(index.kth_largest(3)) == 60.0);
+
+  index.update(2, 99.0);
+  CHECK(index.kth_largest(0) == 2);
+
+  index.erase(1);
+  CHECK(index.size() == 3);
+  CHECK(index.top(10) == std::vector<std::uint32_t>{2, 3, 0});
+  CHECK(index.bottom(2) == std::vector<std::uint32_t>{0, 3});
+}
+
+TEST_CASE("StudentManager 排名查询") {
+  StudentManager manager;
+  manager.add_student(Student("学生A", "8000001", 90.0));
+  manager.add_student(Student("学生B", "8000002", 75.0));
+  manager.add_student(Student("学生C", "8000003", 90.0));
+  manager.add_student(Student("学生D", "8000004", 60.0));
+
+  for (bool indexed : {false, true}) {
+    if (indexed) {
+      manager.enable_ranking_index();
+    }
+    CHECK(manager.has_ranking_index() == indexed);
+
+    CHECK(*manager.rank_of("8000001") == 1);
+    CHECK(*manager.rank_of("8000003") == 1);
+    CHECK(*manager.rank_of("8000002") == 3);
+    CHECK(*manager.rank_of("8000004") == 4);
+    CHECK(manager.rank_of("9999999").has_value() == false);
+
+    CHECK(*manager.kth_score(1) == 90.0);
+    CHECK(*manager.kth_score(3) == 75.0);
+    CHECK(manager.kth_score(0).has_value() == false);
+    CHECK(manager.kth_score(5).has_value() == false);
+
+    auto top = manager.top_k(2);
+    REQUIRE(top.size() == 2);
+    CHECK(top[0].get().get_score() == 90.0);
+    CHECK(top[1].get().get_score() == 90.0);
+
+    auto bottom = manager.bottom_k(10);
+    REQUIRE(bottom.size() == 4);
+    CHECK(bottom[0].get().get_id() == "8000004");
+    CHECK(bottom[1].get().get_id() == "8000002");
+  }
+
+  // 索引随改分、删除同步更新
+  manager.find_student("8000004")->get().set_score(100.0);
+  CHECK(*manager.rank_of("8000004") == 1);
+  CHECK(*manager.rank_of("8000001") == 2);
+  manager.remove_student("8000004");
+  CHECK(*manager.rank_of("8000001") == 1);
+  CHECK(manager.top_k(1)[0].get().get_score() == 90.0);
+
+  manager.clear();
+  CHECK(manager.has_ranking_index() == true);
+  CHECK(manager.top_k(3).empty());
+  manager.add_student(Student("学生E", "8000005", 50.0));
+  CHECK(*manager.rank_of("8000005") == 1);
+}
+
+TEST_CASE("StudentManager 排名索引与全量排序一致（随机操作）") {
+  StudentManager indexed;
+  indexed.enable_ranking_index();
+  StudentManager plain;
+
+  std::mt19937 rng(11);
+  std::uniform_int_distribution<int> id_dist(0, 399);
+  std::uniform_int_distribution<int> score_dist(0, 100);
+
+  for (int step = 0; step < 6000; ++step) {
+    std::string id = std::to_string(id_dist(rng));
+    double score = score_dist(rng);
+    switch (step % 5) {
+      case 0:
+      case 1:
+        indexed.add_student(Student("学生", id, score));
+        plain.add_student(Student("学生", id, score));
+        break;
+      case 2:
+        indexed.update_score(id, score);
+        plain.update_score(id, score);
+        break;
+      case 3:
+        indexed.remove_student(id);
+        plain.remove_student(id);
+        break;
+      default:
+        if (auto rank = plain.rank_of(id)) {
+          CHECK(indexed.rank_of(id) == rank);
+        }
+    }
+  }
+
+  REQUIRE(indexed.get_student_count() == plain.get_student_count());
+  std::vector<double> sorted = plain.get_scores();
+  std::sort(sorted.begin(), sorted.end(), std::greater<>());
+
+  for (std::size_t k = 1; k <= sorted.size(); ++k) {
+    CHECK(*indexed.kth_score(k) == sorted[k - 1]);
+  }
+  auto top = indexed.top_k(sorted.size());
+  auto bottom = indexed.bottom_k(25);
+  for (std::size_t i = 0; i < top.size(); ++i) {
+    CHECK(top[i].get().get_score() == sorted[i]);
+  }
+  for (std::size_t i = 0; i < bottom.size(); ++i) {
+    CHECK(bottom[i].get().get_score() == sorted[sorted.size() - 1 - i]);
+  }
+
+  // 拷贝后的索引仍然可用
+  StudentManager copy = indexed;
+  CHECK(copy.has_ranking_index());
+  CHECK(*copy.kth_score(1) == sorted.front());
+}
@@ -0,0 +1,173 @@
+/**
+ * @file read_snapshot_tests.cpp
+ * @brief 只读快照的单元测试和读写并发测试
+ */
+
+#include <doctest/doctest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "student_manager/student_manager.h"
+
+using namespace student_manager;
+
+TEST_CASE("只读快照默认不启用") {
+  StudentManager manager;
+  CHECK_FALSE(manager.has_read_snapshots());
+  CHECK(manager.read_snapshot() == nullptr);
+  manager.publish_read_snapshot();  // 未启用时什么也不做
+  CHECK(manager.read_snapshot() == nullptr);
+}
+
+TEST_CASE("只读快照反映发布时的数据") {
+  StudentManager manager;
+  manager.add_student(Student("张三", "2023001", 80.0));
+  manager.add_student(Student("李四", "2023002", 90.0));
+  manager.enable_read_snapshots();
+
+  auto first = manager.read_snapshot();
+  REQUIRE(first);
+  CHECK(first->size() == 2);
+  CHECK(first->name(0) == "张三");
+  CHECK(first->id(1) == "2023002");
+  CHECK(first->calculate_average_score() == doctest::Approx(85.0));
+  CHECK(*first->get_max_score() == 90.0);
+  CHECK(*first->get_min_score() == 80.0);
+
+  // 之后的修改立即发布新版本，已经取得的快照保持不变
+  manager.update_score("2023001", 60.0);
+  manager.find_student("2023002")->get().set_score(100.0);
+  manager.remove_student("2023001");
+  auto second = manager.read_snapshot();
+  CHECK(second->version() > first->version());
+  CHECK(second->size() == 1);
+  CHECK(second->score(0) == 100.0);
+  CHECK(first->size() == 2);
+  CHECK(first->score(0) == 80.0);
+  CHECK(first->name(0) == "张三");
+
+  manager.clear();
+  CHECK(manager.read_snapshot()->empty());
+  CHECK_FALSE(manager.read_snapshot()->get_max_score());
+  CHECK(manager.read_snapshot()->calculate_average_score() == 0.0);
+
+  manager.disable_read_snapshots();
+  CHECK(manager.read_snapshot() == nullptr);
+  CHECK(second->size() == 1);
+}
+
+TEST_CASE("增量发布的快照与完整数据一致") {
+  StudentManager manager;
+  manager.enable_read_snapshots(0);
+  for (int i = 0; i < 5000; ++i) {
+    manager.add_student(Student("学生" + std::to_string(i), std::to_string(100000 + i), i % 101));
+  }
+  manager.publish_read_snapshot();
+  auto before = manager.read_snapshot();
+
+  // 改分、删除中间的学生（最后一个学生被搬到空位）、在末尾添加
+  manager.update_score("100007", 3.5);
+  manager.remove_student("101500");
+  manager.add_student(Student("新同学", "200000", 77.0));
+  CHECK(manager.read_snapshot() == before);  // publish_every = 0：只在手动发布时更新
+  manager.publish_read_snapshot();
+
+  auto after = manager.read_snapshot();
+  const auto& students = manager.get_all_students();
+  REQUIRE(after->size() == students.size());
+  std::size_t row = 0;
+  bool same = true;
+  after->for_each([&](std::string_view name, std::string_view id, double score) {
+    const Student& expected = students[row++];
+    same = same && name == expected.get_name() && id == expected.get_id()
+           && score == expected.get_score();
+  });
+  CHECK(same);
+  CHECK(after->calculate_average_score() == doctest::Approx(manager.calculate_average_score()));
+  CHECK(*after->get_min_score() == *manager.get_min_score());
+  CHECK(after->compute_statistics().median == manager.compute_statistics().median);
+  CHECK(after->get_all_students().size() == students.size());
+
+  // 旧版本仍然是删除之前的样子
+  CHECK(before->size() == 5000);
+  CHECK(before->id(1500) == "101500");
+  CHECK(before->score(7) == 7.0);
+}
+
+TEST_CASE("拷贝、移动和重新加载保留只读快照") {
+  StudentManager manager;
+  manager.add_student(Student("张三", "2023001", 80.0));
+  manager.enable_read_snapshots();
+
+  StudentManager copy(manager);
+  copy.update_score("2023001", 10.0);
+  CHECK(copy.read_snapshot()->score(0) == 10.0);
+  CHECK(manager.read_snapshot()->score(0) == 80.0);
+
+  StudentManager moved(std::move(copy));
+  CHECK(moved.has_read_snapshots());
+  moved.add_student(Student("李四", "2023002", 90.0));
+  CHECK(moved.read_snapshot()->size() == 2);
+
+  const std::string path = "read_snapshot_test.snap";
+  REQUIRE(moved.save_snapshot(path) == SnapshotStatus::ok);
+  REQUIRE(manager.load_snapshot(path) == SnapshotStatus::ok);
+  CHECK(manager.has_read_snapshots());
+  CHECK(manager.read_snapshot()->size() == 2);
+  std::remove(path.c_str());
+}
+
+TEST_CASE("读线程在写线程修改的同时看到一致的数据") {
+  constexpr int kStudents = 3000;
+  StudentManager manager;
+  for (int i = 0; i < kStudents; ++i) {
+    manager.add_student(Student("学生", std::to_string(100000 + i), 50.0));
+  }
+  manager.enable_read_snapshots(0);
+
+  // 写线程每次把 10 分从一个学生挪给另一个学生，两次修改之后才发布，
+  // 因此每个快照中的总分和人数都保持不变
+  std::atomic<bool> done{false};
+  std::atomic<bool> failed{false};
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 3; ++t) {
+    readers.emplace_back([&] {
+      std::uint64_t last_version = 0;
+      while (!done) {
+        auto snapshot = manager.read_snapshot();
+        double total = 0.0;
+        snapshot->for_each(
+            [&](std::string_view, std::string_view, double score) { total += score; });
+        if (snapshot->size() != kStudents || total != 50.0 * kStudents
+            || snapshot->calculate_average_score() != 50.0 || snapshot->version() < last_version) {
+          failed = true;
+        }
+        last_version = snapshot->version();
+      }
+    });
+  }
+
+  for (int step = 0; step < 2000; ++step) {
+    std::string from = std::to_string(100000 + (step * 7) % kStudents);
+    std::string to = std::to_string(100000 + (step * 13 + 1) % kStudents);
+    if (from == to) {
+      continue;
+    }
+    double from_score = manager.find_student(from)->get().get_score();
+    double to_score = manager.find_student(to)->get().get_score();
+    double moved = from_score >= 10.0 && to_score <= 90.0 ? 10.0 : 0.0;
+    manager.update_score(from, from_score - moved);
+    manager.update_score(to, to_score + moved);
+    manager.publish_read_snapshot();
+  }
+  done = true;
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  CHECK_FALSE(failed.load());
+}
@@ -0,0 +1,166 @@
+/**
+ * @file report_writer_tests.cpp
+ * @brief 学生列表报表单元测试
+ */
+
+#include <doctest/doctest.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "student_manager/report_writer.h"
+#include "student_manager/student_manager.h"
+
+using namespace student_manager;
+
+namespace {
+
+  std::vector<std::string> lines_of(const std::string& text) {
+    std::vector<std::string> lines;
+    std::istringstream in(text);
+    for (std::string line; std::getline(in, line);) {
+      lines.push_back(line);
+    }
+    return lines;
+  }
+
+  /// 每一行（表头之后）的学号
+  std::vector<std::string> ids_of(const std::string& text) {
+    std::vector<std::string> ids;
+    auto lines = lines_of(text);
+    for (std::size_t i = 2; i < lines.size(); ++i) {
+      std::istringstream fields(lines[i]);
+      std::string name, id;
+      fields >> name >> id;
+      ids.push_back(id);
+    }
+    return ids;
+  }
+
+}  // namespace
+
+TEST_CASE("显示宽度") {
+  CHECK(ReportWriter::display_width("") == 0);
+  CHECK(ReportWriter::display_width("Alice") == 5);
+  CHECK(ReportWriter::display_width("张三") == 4);
+  CHECK(ReportWriter::display_width("김철수") == 6);
+  CHECK(ReportWriter::display_width("ＡＢ") == 4);      // 全角字母
+  CHECK(ReportWriter::display_width("e\xCC\x81") == 1);  // e + 组合重音符
+  CHECK(ReportWriter::display_width("Zoë") == 3);
+  CHECK(ReportWriter::display_width("\xFF\xE4") == 2);  // 不合法的字节各算 1 列
+}
+
+TEST_CASE("报表按显示宽度对齐") {
+  StudentManager manager;
+  manager.add_student(Student("张三", "2023001", 85.5));
+  manager.add_student(Student("Alexander", "S-1", 100.0));
+  manager.add_student(Student("欧阳娜娜", "7", 9.25));
+
+  std::ostringstream out;
+  ReportWriter report(manager);
+  report.write_all(out);
+  auto lines = lines_of(out.str());
+  REQUIRE(lines.size() == 5);
+  CHECK(lines[0] == "姓名       学号       成绩");
+  CHECK(lines[1] == std::string(26, '-'));
+  CHECK(lines[2] == "张三       2023001   85.50");
+  CHECK(lines[3] == "Alexander  S-1      100.00");
+  CHECK(lines[4] == "欧阳娜娜   7          9.25");
+  for (const auto& line : lines) {
+    CHECK(ReportWriter::display_width(line) == 26);
+  }
+
+  ReportOptions options;
+  options.score_precision = 0;
+  std::ostringstream rounded;
+  ReportWriter(manager, options).write_all(rounded);
+  CHECK(lines_of(rounded.str())[2] == "张三       2023001    86");
+}
+
+TEST_CASE("报表中定点数放不下的成绩改用科学计数法") {
+  StudentManager manager;
+  manager.add_student(Student("张三", "2023001", 1e30));
+  manager.add_student(Student("李四", "2023002", -1e300));
+
+  std::ostringstream out;
+  ReportWriter(manager).write_all(out);
+  auto lines = lines_of(out.str());
+  REQUIRE(lines.size() == 4);
+  CHECK(lines[2].find("1e+30") != std::string::npos);
+  CHECK(lines[3].find("-1e+300") != std::string::npos);
+  for (std::size_t i = 2; i < lines.size(); ++i) {
+    for (char c : lines[i]) {
+      CHECK(c != '\0');
+    }
+  }
+}
+
+TEST_CASE("报表排序") {
+  StudentManager manager;
+  manager.add_student(Student("王五", "100", 70.0));
+  manager.add_student(Student("李四", "S01", 90.0));
+  manager.add_student(Student("张三", "99", 70.0));
+  manager.add_student(Student("李四", "0100", 60.0));
+
+  auto ids = [&](ReportOrder order, bool descending) {
+    ReportOptions options;
+    options.order = order;
+    options.descending = descending;
+    ReportWriter report(manager, options);
+    std::ostringstream out;
+    report.write_all(out);
+    return ids_of(out.str());
+  };
+  using Ids = std::vector<std::string>;
+  CHECK(ids(ReportOrder::insertion, false) == Ids{"100", "S01", "99", "0100"});
+  CHECK(ids(ReportOrder::insertion, true) == Ids{"0100", "99", "S01", "100"});
+  // 纯数字学号按数值，位数少的在前；其他学号在后
+  CHECK(ids(ReportOrder::by_id, false) == Ids{"99", "100", "0100", "S01"});
+  CHECK(ids(ReportOrder::by_id, true) == Ids{"S01", "0100", "100", "99"});
+  // 按 UTF-8 编码：张(E5 BC A0) < 李(E6 9D 8E) < 王(E7 8E 8B)，同名按学号
+  CHECK(ids(ReportOrder::by_name, false) == Ids{"99", "0100", "S01", "100"});
+  // 同分按学号，倒序时整个顺序反过来
+  CHECK(ids(ReportOrder::by_score, false) == Ids{"0100", "99", "100", "S01"});
+  CHECK(ids(ReportOrder::by_score, true) == Ids{"S01", "100", "99", "0100"});
+}
+
+TEST_CASE("报表分页") {
+  StudentManager manager;
+  for (int i = 0; i < 2500; ++i) {
+    manager.add_student(Student("学生", std::to_string(10000 + i), (i % 101) * 1.0));
+  }
+  ReportOptions options;
+  options.order = ReportOrder::by_id;
+  options.page_size = 1000;
+  ReportWriter report(manager, options);
+  CHECK(report.row_count() == 2500);
+  CHECK(report.page_count() == 3);
+
+  std::ostringstream last;
+  report.write_page(2, last);
+  auto lines = lines_of(last.str());
+  REQUIRE(lines.size() == 2 + 500 + 1);
+  CHECK(lines[2].find("12000") != std::string::npos);
+  CHECK(lines.back() == "第 3/3 页");
+
+  std::ostringstream beyond;
+  report.write_page(3, beyond);
+  CHECK(lines_of(beyond.str()).size() == 2);  // 只有表头
+
+  // 全部输出：每页的列宽一致，页与页之间空一行
+  std::ostringstream all;
+  report.write_all(all);
+  auto all_lines = lines_of(all.str());
+  CHECK(all_lines.size() == 3 * 3 + 2500 + 2);
+  CHECK(all_lines[1002] == "第 1/3 页");
+  CHECK(all_lines[1003].empty());
+  CHECK(all_lines[1004] == all_lines[0]);
+
+  StudentManager empty;
+  ReportWriter none(empty, options);
+  CHECK(none.page_count() == 1);
+  std::ostringstream header_only;
+  none.write_all(header_only);
+  CHECK(lines_of(header_only.str()).size() == 3);
+}
@@ -0,0 +1,141 @@
+/**
+ * @file score_histogram_tests.cpp
+ * @brief 成绩直方图单元测试
+ */
+
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "student_manager/score_histogram.h"
+#include "student_manager/student_manager.h"
+
+using namespace student_manager;
+
+TEST_CASE("ScoreHistogram 基本操作") {
+  ScoreHistogram histogram;
+  for (double score : {0.0, 59.99, 60.0, 69.99, 70.0, 85.5, 100.0}) {
+    histogram.add(score);
+  }
+  histogram.add(-1.0);  // 超出范围
+  histogram.add(101.0);
+
+  CHECK(histogram.total() == 9);
+  CHECK(histogram.out_of_range() == 2);
+  CHECK(histogram.count_in_range(60.0, 69.99) == 2);
+  CHECK(histogram.count_in_range(0.0, 100.0) == 7);
+  CHECK(histogram.count_in_range(-50.0, 200.0) == 7);
+  CHECK(histogram.count_in_range(70.01, 85.49) == 0);
+  CHECK(histogram.count_in_range(90.0, 80.0) == 0);
+  CHECK(histogram.count_below(60.0) == 2);
+
+  CHECK(histogram.distribution({0, 60, 70, 80, 90, 100})
+        == std::vector<std::size_t>{2, 2, 1, 1, 1});
+
+  CHECK(histogram.percentile(0.0) == 0.0);
+  CHECK(histogram.percentile(50.0) == 69.99);
+  CHECK(histogram.percentile(100.0) == 100.0);
+
+  histogram.replace(85.5, 60.5);
+  CHECK(histogram.count_in_range(60.0, 69.99) == 3);
+  histogram.remove(101.0);
+  CHECK(histogram.out_of_range() == 1);
+
+  histogram.clear();
+  CHECK(histogram.total() == 0);
+  CHECK(histogram.percentile(50.0) < 0.0);
+}
+
+TEST_CASE("ScoreHistogram 边界分数归入正确的桶") {
+  // 69.99 * 100 在浮点数中略小于 6999，不能被截断到 6998
+  CHECK(ScoreHistogram::bucket_of(69.99) == 6999);
+  CHECK(ScoreHistogram::bucket_of(0.29) == 29);
+  CHECK(ScoreHistogram::bucket_of(100.0) == 10000);
+  CHECK(ScoreHistogram::bucket_of(-0.01) == ScoreHistogram::kBucketCount);
+  CHECK(ScoreHistogram::bucket_of(std::nan("")) == ScoreHistogram::kBucketCount);
+}
+
+TEST_CASE("StudentManager 分数段统计") {
+  StudentManager manager;
+  manager.add_student(Student("学生A", "8100001", 95.0));
+  manager.add_student(Student("学生B", "8100002", 65.5));
+  manager.add_student(Student("学生C", "8100003", 59.99));
+  manager.add_student(Student("学生D", "8100004", 78.0));
+
+  for (bool enabled : {false, true}) {
+    if (enabled) {
+      manager.enable_score_histogram();
+    }
+    CHECK(manager.has_score_histogram() == enabled);
+    CHECK(manager.count_in_range(60.0, 100.0) == 3);
+    CHECK(manager.grade_distribution({0, 60, 80, 100}) == std::vector<std::size_t>{1, 2, 1});
+    CHECK(*manager.approximate_percentile(50.0) == 65.5);
+  }
+
+  // 改分、删除、清空都会同步更新直方图
+  manager.find_student("8100003")->get().set_score(60.0);
+  CHECK(manager.count_in_range(60.0, 100.0) == 4);
+  manager.update_score("8100001", 10.0);
+  CHECK(manager.count_in_range(0.0, 59.99) == 1);
+  manager.remove_student("8100002");
+  CHECK(manager.count_in_range(60.0, 69.99) == 1);
+
+  StudentManager copy = manager;
+  CHECK(copy.has_score_histogram());
+  CHECK(copy.count_in_range(0.0, 100.0) == 3);
+
+  manager.clear();
+  CHECK(manager.count_in_range(0.0, 100.0) == 0);
+  CHECK(manager.approximate_percentile(50.0).has_value() == false);
+
+  manager.disable_score_histogram();
+  CHECK(manager.has_score_histogram() == false);
+}
+
+TEST_CASE("StudentManager 直方图与遍历结果一致（随机操作）") {
+  std::mt19937 rng(8);
+  std::uniform_int_distribution<int> hundredths(0, 10000);
+  std::uniform_int_distribution<int> id_pick(0, 299);
+
+  StudentManager manager;
+  manager.enable_score_histogram();
+  for (int step = 0; step < 3000; ++step) {
+    std::string id = std::to_string(8200000 + id_pick(rng));
+    double score = hundredths(rng) / 100.0;
+    switch (step % 3) {
+      case 0:
+        manager.add_student(Student("学生", id, score));
+        break;
+      case 1:
+        manager.update_score(id, score);
+        break;
+      default:
+        manager.remove_student(id);
+        break;
+    }
+  }
+
+  const auto& scores = manager.get_scores();
+  for (int i = 0; i < 50; ++i) {
+    double low = hundredths(rng) / 100.0;
+    double high = hundredths(rng) / 100.0;
+    if (low > high) {
+      std::swap(low, high);
+    }
+    auto expected = std::count_if(scores.begin(), scores.end(),
+                                  [&](double s) { return s >= low && s <= high; });
+    CHECK(manager.count_in_range(low, high) == static_cast<std::size_t>(expected));
+  }
+
+  // 最近秩法：排序后第 ceil(p * n) 个成绩
+  std::vector<double> sorted = scores;
+  std::sort(sorted.begin(), sorted.end());
+  for (double p : {1.0, 25.0, 50.0, 90.0, 100.0}) {
+    auto rank = static_cast<std::size_t>(std::ceil(p / 100.0 * sorted.size()));
+    CHECK(*manager.approximate_percentile(p) == sorted[rank - 1]);
+  }
+}
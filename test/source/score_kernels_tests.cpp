@@ -0,0 +1,159 @@
+/**
+ * @file score_kernels_tests.cpp
+ * @brief 成绩列统计内核单元测试
+ */
+
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "student_manager/score_kernels.h"
+#include "student_manager/student_manager.h"
+
+using namespace student_manager;
+
+namespace {
+  std::vector<double> random_scores(std::size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> dist(0.0, 100.0);
+    std::vector<double> scores(count);
+    for (auto& score : scores) {
+      score = dist(rng);
+    }
+    return scores;
+  }
+
+  const kernels::SimdLevel all_levels[] = {kernels::SimdLevel::scalar, kernels::SimdLevel::sse2,
+                                           kernels::SimdLevel::avx2};
+}  // namespace
+
+TEST_CASE("kernels 最高分和最低分与标准算法一致") {
+  for (std::size_t count : {1u, 2u, 3u, 7u, 8u, 9u, 31u, 1000u, 1003u}) {
+    auto scores = random_scores(count, static_cast<unsigned>(count));
+    double expected_min = *std::min_element(scores.begin(), scores.end());
+    double expected_max = *std::max_element(scores.begin(), scores.end());
+
+    for (auto level : all_levels) {
+      CHECK(kernels::min(scores.data(), count, level) == expected_min);
+      CHECK(kernels::max(scores.data(), count, level) == expected_max);
+    }
+  }
+}
+
+TEST_CASE("kernels 求和在所有指令集下逐位相同") {
+  CHECK(kernels::sum(nullptr, 0) == 0.0);
+
+  for (std::size_t count : {1u, 5u, 8u, 15u, 16u, 17u, 1000u, 100003u}) {
+    auto scores = random_scores(count, 42);
+    double scalar = kernels::sum(scores.data(), count, kernels::SimdLevel::scalar);
+
+    double naive = 0.0;
+    for (double score : scores) {
+      naive += score;
+    }
+    CHECK(scalar == doctest::Approx(naive));
+
+    for (auto level : all_levels) {
+      CHECK(kernels::sum(scores.data(), count, level) == scalar);
+    }
+  }
+}
+
+TEST_CASE("定点成绩 kernels 与标准算法一致") {
+  CHECK(kernels::sum_fixed(nullptr, 0) == 0);
+
+  std::mt19937 rng(11);
+  for (std::size_t count : {1u, 7u, 8u, 15u, 16u, 17u, 33u, 1000u, 100003u}) {
+    std::vector<std::uint16_t> scores(count);
+    for (auto& score : scores) {
+      score = static_cast<std::uint16_t>(rng() % 10001);
+    }
+    std::uint64_t expected_sum = 0;
+    for (std::uint16_t score : scores) {
+      expected_sum += score;
+    }
+    std::uint16_t expected_min = *std::min_element(scores.begin(), scores.end());
+    std::uint16_t expected_max = *std::max_element(scores.begin(), scores.end());
+
+    for (auto level : all_levels) {
+      CHECK(kernels::sum_fixed(scores.data(), count, level) == expected_sum);
+      CHECK(kernels::min_fixed(scores.data(), count, level) == expected_min);
+      CHECK(kernels::max_fixed(scores.data(), count, level) == expected_max);
+    }
+  }
+
+  // 超过 32768 的值（SSE2 的有符号比较需要翻转最高位）和 32 位累加器需要合并的长度
+  std::vector<std::uint16_t> large(16 * 65536 + 5, 65535);
+  large[3] = 40000;
+  large[large.size() - 1] = 32768;
+  for (auto level : all_levels) {
+    CHECK(kernels::sum_fixed(large.data(), large.size(), level)
+          == std::uint64_t{65535} * (large.size() - 2) + 40000 + 32768);
+    CHECK(kernels::min_fixed(large.data(), large.size(), level) == 32768);
+    CHECK(kernels::max_fixed(large.data(), large.size(), level) == 65535);
+  }
+}
+
+TEST_CASE("定点成绩直方图") {
+  std::vector<std::uint16_t> scores = {5, 0, 5, 9, 5, 12, 3};
+  std::vector<std::uint64_t> counts(10, 1);  // 不会先清零
+  kernels::histogram(scores.data(), scores.size(), counts.data(), counts.size());
+  CHECK(counts[0] == 2);
+  CHECK(counts[3] == 2);
+  CHECK(counts[5] == 4);
+  CHECK(counts[9] == 2);
+  CHECK(counts[1] == 1);  // 12 超出范围，不计数
+
+  std::mt19937 rng(3);
+  std::vector<std::uint16_t> many(100003);
+  std::vector<std::uint64_t> expected(101, 0);
+  for (auto& score : many) {
+    score = static_cast<std::uint16_t>(rng() % 101);
+    ++expected[score];
+  }
+  std::vector<std::uint64_t> actual(101, 0);
+  kernels::histogram(many.data(), many.size(), actual.data(), actual.size());
+  CHECK(actual == expected);
+}
+
+TEST_CASE("kernels 指令集检测") {
+  auto level = kernels::detect_simd_level();
+  CHECK(kernels::to_string(level) != nullptr);
+  CHECK(kernels::to_string(kernels::SimdLevel::avx2) == std::string("avx2"));
+}
+
+TEST_CASE("StudentManager 成绩列与学生列表保持一致") {
+  StudentManager manager;
+  std::mt19937 rng(3);
+  std::uniform_int_distribution<int> id_dist(0, 199);
+  std::uniform_real_distribution<double> score_dist(0.0, 100.0);
+
+  for (int step = 0; step < 3000; ++step) {
+    std::string id = std::to_string(id_dist(rng));
+    switch (step % 4) {
+      case 0:
+      case 1:
+        manager.add_student(Student("学生", id, score_dist(rng)));
+        break;
+      case 2:
+        manager.update_score(id, score_dist(rng));
+        break;
+      default:
+        manager.remove_student(id);
+    }
+  }
+
+  const auto& students = manager.get_all_students();
+  const auto& scores = manager.get_scores();
+  REQUIRE(scores.size() == students.size());
+  for (std::size_t i = 0; i < students.size(); ++i) {
+    CHECK(scores[i] == students[i].get_score());
+  }
+  CHECK(kernels::max(scores.data(), scores.size()) == *manager.get_max_score());
+  CHECK(kernels::min(scores.data(), scores.size()) == *manager.get_min_score());
+  CHECK(kernels::sum(scores.data(), scores.size()) / static_cast<double>(scores.size())
+        == doctest::Approx(manager.calculate_average_score()));
+}
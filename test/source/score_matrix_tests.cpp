@@ -0,0 +1,202 @@
+/**
+ * @file score_matrix_tests.cpp
+ * @brief 多科目成绩单元测试
+ */
+
+#include <doctest/doctest.h>
+
+#include <cstdio>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "student_manager/student_manager.h"
+
+using namespace student_manager;
+
+TEST_CASE("绩点公式") {
+  CHECK(ScoreMatrix::grade_point(100.0) == 4.0);
+  CHECK(ScoreMatrix::grade_point(60.0) == doctest::Approx(1.0));
+  CHECK(ScoreMatrix::grade_point(80.0) == doctest::Approx(3.25));
+  CHECK(ScoreMatrix::grade_point(59.9) == 0.0);
+  CHECK(ScoreMatrix::grade_point(0.0) == 0.0);
+}
+
+TEST_CASE("科目的增加、查找和删除") {
+  StudentManager manager;
+  manager.add_student(Student("张三", "2023001", 85.0));
+  auto math = manager.add_subject("高等数学", 5.0);
+  REQUIRE(math);
+  CHECK(*math == 0);
+  CHECK(manager.add_subject("大学英语") == std::optional<std::size_t>(1));
+  CHECK_FALSE(manager.add_subject("高等数学"));   // 名称重复
+  CHECK_FALSE(manager.add_subject("体育", 0.0));  // 学分必须大于 0
+  CHECK(manager.subject_count() == 2);
+  CHECK(manager.find_subject("大学英语") == std::optional<std::size_t>(1));
+  CHECK_FALSE(manager.find_subject("体育"));
+
+  CHECK(manager.set_subject_score("2023001", 1, 70.0));
+  CHECK(manager.remove_subject("高等数学"));
+  CHECK_FALSE(manager.remove_subject("高等数学"));
+  // 后面的科目编号减 1，成绩保留
+  CHECK(manager.find_subject("大学英语") == std::optional<std::size_t>(0));
+  CHECK(manager.get_subject_score("2023001", 0) == std::optional<double>(70.0));
+  CHECK(manager.get_subject_scores().name(0) == "大学英语");
+}
+
+TEST_CASE("科目成绩、平均分和 GPA") {
+  StudentManager manager;
+  manager.add_student(Student("张三", "2023001", 0.0));
+  manager.add_student(Student("李四", "2023002", 0.0));
+  manager.add_student(Student("王五", "2023003", 0.0));
+  std::size_t math = *manager.add_subject("高等数学", 4.0);
+  std::size_t english = *manager.add_subject("大学英语", 2.0);
+
+  CHECK(manager.set_subject_score("2023001", math, 100.0));
+  CHECK(manager.set_subject_score("2023001", english, 60.0));
+  CHECK(manager.set_subject_score("2023002", math, 80.0));
+  CHECK_FALSE(manager.set_subject_score("9999999", math, 80.0));  // 学号不存在
+  CHECK_FALSE(manager.set_subject_score("2023002", 7, 80.0));     // 科目不存在
+  CHECK_FALSE(manager.set_subject_score("2023002", math, 101.0));
+
+  CHECK(manager.get_subject_score("2023002", math) == std::optional<double>(80.0));
+  CHECK_FALSE(manager.get_subject_score("2023002", english));  // 没有成绩
+
+  // 没有成绩的学生不参与平均
+  CHECK(manager.subject_average(math) == doctest::Approx(90.0));
+  CHECK(manager.subject_average(english) == doctest::Approx(60.0));
+  CHECK_FALSE(manager.subject_average(5));
+  ScoreStatistics stats = manager.compute_subject_statistics(math);
+  CHECK(stats.count == 2);
+  CHECK(stats.min == 80.0);
+  CHECK(stats.max == 100.0);
+
+  CHECK(manager.student_average("2023001") == doctest::Approx(80.0));
+  // (4 × 4.0 + 2 × 1.0) / 6
+  CHECK(manager.student_gpa("2023001") == doctest::Approx(3.0));
+  CHECK(manager.student_gpa("2023002") == doctest::Approx(3.25));
+  CHECK_FALSE(manager.student_gpa("2023003"));  // 没有任何科目成绩
+  auto gpas = manager.compute_gpas();
+  REQUIRE(gpas.size() == 3);
+  CHECK(*gpas[0] == doctest::Approx(3.0));
+  CHECK(*gpas[1] == doctest::Approx(3.25));
+  CHECK_FALSE(gpas[2]);
+
+  CHECK(manager.clear_subject_score("2023001", english));
+  CHECK_FALSE(manager.clear_subject_score("2023001", english));
+  CHECK(manager.student_gpa("2023001") == doctest::Approx(4.0));
+  CHECK_FALSE(manager.subject_average(english));
+
+  // 删除学生：最后一名学生的科目成绩随之移动
+  manager.set_subject_score("2023003", english, 90.0);
+  CHECK(manager.remove_student("2023001"));
+  CHECK(manager.get_subject_score("2023003", english) == std::optional<double>(90.0));
+  CHECK(manager.subject_average(math) == doctest::Approx(80.0));
+  CHECK(manager.get_subject_scores().count(math) == 1);
+
+  // 复制时科目成绩一起复制；清空学生保留科目
+  StudentManager copy(manager);
+  CHECK(copy.get_subject_score("2023002", math) == std::optional<double>(80.0));
+  manager.clear();
+  CHECK(manager.subject_count() == 2);
+  CHECK_FALSE(manager.subject_average(math));
+  CHECK(manager.memory_usage().subject_scores > 0);
+}
+
+TEST_CASE("科目成绩与逐个计算的结果一致") {
+  std::mt19937 rng(7);
+  StudentManager manager;
+  const std::size_t subjects = 5;
+  for (std::size_t s = 0; s < subjects; ++s) {
+    manager.add_subject("科目" + std::to_string(s), 1.0 + static_cast<double>(s));
+  }
+  // 对照：每个学生每科的成绩（负数表示没有成绩）
+  std::vector<std::string> ids;
+  std::vector<std::vector<double>> expected;
+  for (int step = 0; step < 3000; ++step) {
+    unsigned choice = rng() % 10;
+    if (choice < 4 || ids.empty()) {
+      std::string id = std::to_string(step);
+      manager.add_student(Student("学生", id, 0.0));
+      ids.push_back(id);
+      expected.emplace_back(subjects, -1.0);
+    } else if (choice < 6) {
+      std::size_t at = rng() % ids.size();
+      manager.remove_student(ids[at]);
+      ids[at] = ids.back();
+      ids.pop_back();
+      expected[at] = expected.back();
+      expected.pop_back();
+    } else {
+      std::size_t at = rng() % ids.size();
+      std::size_t s = rng() % subjects;
+      if (rng() % 5 == 0) {
+        manager.clear_subject_score(ids[at], s);
+        expected[at][s] = -1.0;
+      } else {
+        double score = static_cast<double>(rng() % 101);
+        manager.set_subject_score(ids[at], s, score);
+        expected[at][s] = score;
+      }
+    }
+  }
+
+  for (std::size_t s = 0; s < subjects; ++s) {
+    double total = 0.0;
+    std::size_t count = 0;
+    for (const auto& row : expected) {
+      if (row[s] >= 0.0) {
+        total += row[s];
+        ++count;
+      }
+    }
+    REQUIRE(manager.get_subject_scores().count(s) == count);
+    if (count > 0) {
+      CHECK(*manager.subject_average(s) == doctest::Approx(total / static_cast<double>(count)));
+    }
+  }
+
+  auto gpas = manager.compute_gpas();
+  for (std::size_t i = 0; i < ids.size(); ++i) {
+    double points = 0.0;
+    double credits = 0.0;
+    for (std::size_t s = 0; s < subjects; ++s) {
+      if (expected[i][s] >= 0.0) {
+        points += (1.0 + static_cast<double>(s)) * ScoreMatrix::grade_point(expected[i][s]);
+        credits += 1.0 + static_cast<double>(s);
+      }
+    }
+    auto gpa = manager.student_gpa(ids[i]);
+    std::size_t row = 0;
+    while (manager.get_all_students()[row].get_id() != ids[i]) {
+      ++row;
+    }
+    if (credits == 0.0) {
+      CHECK_FALSE(gpa);
+      CHECK_FALSE(gpas[row]);
+    } else {
+      REQUIRE(gpa);
+      CHECK(*gpa == doctest::Approx(points / credits));
+      REQUIRE(gpas[row]);
+      CHECK(*gpas[row] == doctest::Approx(points / credits));
+    }
+  }
+}
+
+TEST_CASE("加载快照后保留科目定义、清空科目成绩") {
+  const std::string path = "score_matrix_test.snapshot";
+  StudentManager manager;
+  manager.add_student(Student("张三", "2023001", 85.0));
+  std::size_t math = *manager.add_subject("高等数学", 4.0);
+  manager.set_subject_score("2023001", math, 90.0);
+  REQUIRE(manager.save_snapshot(path) == SnapshotStatus::ok);
+  REQUIRE(manager.load_snapshot(path) == SnapshotStatus::ok);
+  std::remove(path.c_str());
+
+  CHECK(manager.get_student_count() == 1);
+  CHECK(manager.find_subject("高等数学") == std::optional<std::size_t>(math));
+  CHECK_FALSE(manager.get_subject_score("2023001", math));
+  CHECK(manager.set_subject_score("2023001", math, 75.0));
+  CHECK(manager.subject_average(math) == doctest::Approx(75.0));
+}
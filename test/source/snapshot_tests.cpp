@@ -0,0 +1,160 @@
+/**
+ * @file snapshot_tests.cpp
+ * @brief 二进制快照单元测试
+ */
+
+#include <doctest/doctest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "student_manager/snapshot.h"
+#include "student_manager/student_manager.h"
+
+using namespace student_manager;
+
+namespace {
+  /// 测试用的临时文件，析构时删除
+  struct TempFile {
+    std::string path;
+    explicit TempFile(std::string name) : path(std::move(name)) { std::remove(path.c_str()); }
+    ~TempFile() { std::remove(path.c_str()); }
+  };
+
+  std::vector<char> read_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+  }
+
+  void write_file(const std::string& path, const std::vector<char>& bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+  }
+}  // namespace
+
+TEST_CASE("快照保存后可以原样加载") {
+  TempFile file("snapshot_roundtrip_test.snap");
+  StudentManager manager;
+  manager.add_student(Student("张三", "2023001", 85.5));
+  manager.add_student(Student("李四", "001234", 92.0));
+  manager.add_student(Student("Maximilian Alexander Schmidt", "EXCHANGE-2024-0001", 77.25));
+  manager.add_student(Student("", "S1", 0.0));
+  REQUIRE(manager.save_snapshot(file.path) == SnapshotStatus::ok);
+
+  StudentManager loaded;
+  loaded.add_student(Student("将被替换", "9999999", 10.0));
+  loaded.enable_ranking_index();
+  REQUIRE(loaded.load_snapshot(file.path) == SnapshotStatus::ok);
+
+  CHECK(loaded.get_student_count() == 4);
+  CHECK(loaded.find_student("9999999").has_value() == false);
+  CHECK(loaded.has_ranking_index());
+  CHECK(*loaded.rank_of("001234") == 1);
+  for (const auto& student : manager) {
+    auto found = loaded.find_student(student.get_id());
+    REQUIRE(found.has_value());
+    CHECK(found->get().get_name() == student.get_name());
+    CHECK(found->get().get_score() == student.get_score());
+  }
+  CHECK(loaded.calculate_average_score() == doctest::Approx(manager.calculate_average_score()));
+}
+
+TEST_CASE("SnapshotView 直接读取映射的数据") {
+  TempFile file("snapshot_view_test.snap");
+  StudentManager manager;
+  for (int i = 0; i < 1000; ++i) {
+    manager.add_student(Student("学生" + std::to_string(i), std::to_string(5000000 + i), i % 101));
+  }
+  REQUIRE(manager.save_snapshot(file.path) == SnapshotStatus::ok);
+
+  SnapshotView view;
+  REQUIRE(view.open(file.path) == SnapshotStatus::ok);
+  CHECK(view.is_open());
+  CHECK(view.size() == 1000);
+  CHECK(view.verify() == SnapshotStatus::ok);
+  CHECK(view.name(10) == manager.get_all_students()[10].get_name());
+  CHECK(view.score(10) == manager.get_scores()[10]);
+
+  auto row = view.find("5000123");
+  REQUIRE(row.has_value());
+  CHECK(view.id(*row) == "5000123");
+  CHECK(view.name(*row) == "学生123");
+  CHECK(view.find("5001000").has_value() == false);
+
+  SnapshotView moved = std::move(view);
+  CHECK(view.is_open() == false);
+  CHECK(moved.find("5000999").has_value());
+}
+
+TEST_CASE("空管理器的快照") {
+  TempFile file("snapshot_empty_test.snap");
+  StudentManager manager;
+  REQUIRE(manager.save_snapshot(file.path) == SnapshotStatus::ok);
+
+  SnapshotView view;
+  REQUIRE(view.open(file.path) == SnapshotStatus::ok);
+  CHECK(view.size() == 0);
+  CHECK(view.verify() == SnapshotStatus::ok);
+  CHECK(view.find("1").has_value() == false);
+
+  StudentManager loaded;
+  loaded.add_student(Student("张三", "2023001", 85.5));
+  CHECK(loaded.load_snapshot(file.path) == SnapshotStatus::ok);
+  CHECK(loaded.empty());
+}
+
+TEST_CASE("损坏的快照会被拒绝") {
+  TempFile file("snapshot_corrupt_test.snap");
+  StudentManager manager;
+  manager.add_student(Student("张三", "2023001", 85.5));
+  manager.add_student(Student("李四", "2023002", 92.0));
+  REQUIRE(manager.save_snapshot(file.path) == SnapshotStatus::ok);
+  const std::vector<char> original = read_file(file.path);
+
+  SnapshotView view;
+  CHECK(view.open("snapshot_does_not_exist.snap") == SnapshotStatus::open_failed);
+  CHECK(view.is_open() == false);
+
+  SUBCASE("数据区被修改") {
+    std::vector<char> bytes = original;
+    bytes[bytes.size() - 9] ^= 0x01;
+    write_file(file.path, bytes);
+    REQUIRE(view.open(file.path) == SnapshotStatus::ok);  // 打开时只检查文件头
+    CHECK(view.verify() == SnapshotStatus::corrupted);
+
+    StudentManager loaded;
+    CHECK(loaded.load_snapshot(file.path) == SnapshotStatus::corrupted);
+    CHECK(loaded.empty());
+  }
+
+  SUBCASE("文件头被修改") {
+    std::vector<char> bytes = original;
+    bytes[16] ^= 0x01;  // 行数
+    write_file(file.path, bytes);
+    CHECK(view.open(file.path) == SnapshotStatus::corrupted);
+  }
+
+  SUBCASE("文件被截断") {
+    std::vector<char> bytes(original.begin(), original.end() - 8);
+    write_file(file.path, bytes);
+    CHECK(view.open(file.path) == SnapshotStatus::corrupted);
+    bytes.resize(10);
+    write_file(file.path, bytes);
+    CHECK(view.open(file.path) == SnapshotStatus::not_a_snapshot);
+  }
+
+  SUBCASE("不是快照文件") {
+    write_file(file.path, std::vector<char>(200, 'x'));
+    CHECK(view.open(file.path) == SnapshotStatus::not_a_snapshot);
+  }
+
+  SUBCASE("版本号不受支持") {
+    std::vector<char> bytes = original;
+    bytes[8] = 99;
+    write_file(file.path, bytes);
+    CHECK(view.open(file.path) == SnapshotStatus::unsupported_format);
+  }
+}
@@ -0,0 +1,189 @@
+/**
+ * @file sorted_view_tests.cpp
+ * @brief 排序视图单元测试
+ */
+
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "student_manager/student_manager.h"
+
+using namespace student_manager;
+
+namespace {
+
+  std::vector<std::string> ids_of(const SortedView& view) {
+    std::vector<std::string> ids;
+    for (const Student& student : view) {
+      ids.emplace_back(student.get_id());
+    }
+    return ids;
+  }
+
+  /// 复制学生列表并整体排序，作为对照
+  std::vector<std::string> expected_ids(const StudentManager& manager, SortKey key) {
+    std::vector<Student> students = manager.get_all_students();
+    auto id_less = [](const Student& a, const Student& b) {
+      bool a_numeric = IdKey::pack(a.get_id()) != IdKey::kNotNumeric;
+      bool b_numeric = IdKey::pack(b.get_id()) != IdKey::kNotNumeric;
+      if (a_numeric != b_numeric) {
+        return a_numeric;
+      }
+      if (a_numeric && a.get_id().size() != b.get_id().size()) {
+        return a.get_id().size() < b.get_id().size();
+      }
+      return a.get_id() < b.get_id();
+    };
+    std::sort(students.begin(), students.end(), [&](const Student& a, const Student& b) {
+      if (key == SortKey::score && a.get_score() != b.get_score()) {
+        return a.get_score() < b.get_score();
+      }
+      if (key == SortKey::name && a.get_name() != b.get_name()) {
+        return a.get_name() < b.get_name();
+      }
+      return id_less(a, b);
+    });
+    std::vector<std::string> ids;
+    for (const Student& student : students) {
+      ids.emplace_back(student.get_id());
+    }
+    return ids;
+  }
+
+}  // namespace
+
+TEST_CASE("排序视图的顺序") {
+  StudentManager manager;
+  manager.add_student(Student("王五", "100", 70.0));
+  manager.add_student(Student("李四", "S01", 90.0));
+  manager.add_student(Student("张三", "99", 70.0));
+  manager.add_student(Student("李四", "0100", 60.0));
+
+  using Ids = std::vector<std::string>;
+  CHECK(ids_of(manager.sorted_by(SortKey::id)) == Ids{"99", "100", "0100", "S01"});
+  CHECK(ids_of(manager.sorted_by(SortKey::score)) == Ids{"0100", "99", "100", "S01"});
+  CHECK(ids_of(manager.sorted_by(SortKey::name)) == Ids{"99", "0100", "S01", "100"});
+
+  SortedView ranking = manager.sorted_by(SortKey::score);
+  REQUIRE(ranking.size() == 4);
+  CHECK(ranking.front().get_id() == "0100");
+  CHECK(ranking.back().get_id() == "S01");
+  CHECK(ranking[1].get_name() == "张三");
+  CHECK(ranking.rbegin()->get_score() == 90.0);
+  CHECK(ranking.end() - ranking.begin() == 4);
+  // 视图引用管理器中的学生，不是副本
+  CHECK(&ranking[0] == &manager.get_all_students()[ranking.rows()[0]]);
+
+  CHECK(StudentManager().sorted_by(SortKey::name).empty());
+}
+
+TEST_CASE("排序视图在修改后增量修补") {
+  StudentManager manager;
+  manager.add_student(Student("甲", "3", 30.0));
+  manager.add_student(Student("乙", "1", 10.0));
+  manager.add_student(Student("丙", "2", 20.0));
+  using Ids = std::vector<std::string>;
+  CHECK(ids_of(manager.sorted_by(SortKey::score)) == Ids{"1", "2", "3"});
+
+  manager.update_score("1", 50.0);
+  manager.add_student(Student("丁", "4", 25.0));
+  CHECK(ids_of(manager.sorted_by(SortKey::score)) == Ids{"2", "4", "3", "1"});
+
+  // 删除中间的学生：最后一个学生被移到空位上，顺序不变
+  manager.remove_student("3");
+  CHECK(ids_of(manager.sorted_by(SortKey::score)) == Ids{"2", "4", "1"});
+  CHECK(ids_of(manager.sorted_by(SortKey::id)) == Ids{"1", "2", "4"});
+
+  // 删除后槽位被新学生复用
+  manager.remove_student("2");
+  manager.add_student(Student("戊", "0", 99.0));
+  CHECK(ids_of(manager.sorted_by(SortKey::id)) == Ids{"0", "1", "4"});
+  CHECK(ids_of(manager.sorted_by(SortKey::score)) == Ids{"4", "1", "0"});
+
+  // 通过引用修改成绩也会被记录
+  manager.find_student("0")->get().set_score(0.0);
+  CHECK(ids_of(manager.sorted_by(SortKey::score)) == Ids{"0", "4", "1"});
+
+  StudentManager copy(manager);
+  copy.add_student(Student("己", "5", 1.0));
+  CHECK(ids_of(copy.sorted_by(SortKey::score)) == Ids{"0", "5", "4", "1"});
+  CHECK(ids_of(manager.sorted_by(SortKey::score)) == Ids{"0", "4", "1"});
+
+  manager.clear();
+  CHECK(manager.sorted_by(SortKey::score).empty());
+  manager.add_student(Student("庚", "7", 70.0));
+  CHECK(ids_of(manager.sorted_by(SortKey::name)) == Ids{"7"});
+}
+
+TEST_CASE("排序视图与整体排序的结果一致") {
+  std::mt19937 rng(42);
+  const std::vector<std::string> names = {"张三", "李四", "王五", "Alice", "Bob", "欧阳"};
+  StudentManager manager;
+  std::vector<std::string> live;
+  for (int round = 0; round < 40; ++round) {
+    int operations = static_cast<int>(rng() % 300);
+    for (int i = 0; i < operations; ++i) {
+      unsigned choice = rng() % 10;
+      if (choice < 5 || live.empty()) {
+        std::string id = rng() % 4 == 0 ? "S" + std::to_string(rng() % 5000)
+                                         : std::to_string(rng() % 5000);
+        double score = static_cast<double>(rng() % 21) * 5.0;  // 大量同分
+        if (manager.add_student(Student(names[rng() % names.size()], id, score))) {
+          live.push_back(id);
+        }
+      } else if (choice < 8) {
+        std::size_t at = rng() % live.size();
+        manager.remove_student(live[at]);
+        live[at] = live.back();
+        live.pop_back();
+      } else {
+        manager.update_score(live[rng() % live.size()], static_cast<double>(rng() % 101));
+      }
+    }
+    // 有时跳过某些视图，让它们累积更多的修改
+    for (SortKey key : {SortKey::id, SortKey::score, SortKey::name}) {
+      if (rng() % 3 != 0) {
+        REQUIRE(ids_of(manager.sorted_by(key)) == expected_ids(manager, key));
+      }
+    }
+  }
+}
+
+TEST_CASE("多个线程可以同时对同一个管理器取得排序视图") {
+  StudentManager manager;
+  for (int i = 0; i < 3000; ++i) {
+    REQUIRE(manager.add_student(
+        Student("学生" + std::to_string(i % 37), std::to_string(100000 + i), i % 101)));
+  }
+  const StudentManager& shared = manager;
+  for (int round = 0; round < 3; ++round) {
+    // 每一轮先修改，使下面第一次取得视图时要修补缓存
+    for (int i = round; i < 3000; i += 7) {
+      manager.update_score(std::to_string(100000 + i), (i + round) % 101);
+    }
+    std::vector<std::vector<std::string>> expected;
+    for (SortKey key : {SortKey::id, SortKey::score, SortKey::name}) {
+      expected.push_back(expected_ids(manager, key));
+    }
+
+    std::vector<std::vector<std::string>> results(6);
+    std::vector<std::thread> readers;
+    for (std::size_t t = 0; t < results.size(); ++t) {
+      readers.emplace_back([&, t] {
+        results[t] = ids_of(shared.sorted_by(static_cast<SortKey>(t % kSortKeyCount)));
+        (void)shared.memory_usage();
+      });
+    }
+    for (std::thread& reader : readers) {
+      reader.join();
+    }
+    for (std::size_t t = 0; t < results.size(); ++t) {
+      CHECK(results[t] == expected[t % kSortKeyCount]);
+    }
+  }
+}
@@ -0,0 +1,114 @@
+/**
+ * @file statistics_tests.cpp
+ * @brief 成绩统计报告单元测试
+ */
+
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "student_manager/statistics.h"
+#include "student_manager/student_manager.h"
+
+using namespace student_manager;
+
+namespace {
+  /// 参照实现：完整排序后按定义计算百分位数
+  double sorted_percentile(std::vector<double> values, double percentile) {
+    std::sort(values.begin(), values.end());
+    double position = static_cast<double>(values.size() - 1) * percentile / 100.0;
+    auto lower = static_cast<std::size_t>(position);
+    double fraction = position - static_cast<double>(lower);
+    if (lower + 1 < values.size()) {
+      return values[lower] + (values[lower + 1] - values[lower]) * fraction;
+    }
+    return values[lower];
+  }
+}  // namespace
+
+TEST_CASE("compute_score_statistics 空数据") {
+  auto stats = compute_score_statistics(nullptr, 0);
+  CHECK(stats.count == 0);
+  CHECK(stats.mean == 0.0);
+  CHECK(stats.median == 0.0);
+}
+
+TEST_CASE("compute_score_statistics 小数据") {
+  std::vector<double> scores = {70.0, 90.0, 80.0, 60.0, 100.0};
+  auto stats = compute_score_statistics(scores.data(), scores.size());
+
+  CHECK(stats.count == 5);
+  CHECK(stats.mean == doctest::Approx(80.0));
+  CHECK(stats.variance == doctest::Approx(200.0));
+  CHECK(stats.stddev == doctest::Approx(std::sqrt(200.0)));
+  CHECK(stats.min == 60.0);
+  CHECK(stats.max == 100.0);
+  CHECK(stats.percentile_25 == doctest::Approx(70.0));
+  CHECK(stats.median == doctest::Approx(80.0));
+  CHECK(stats.percentile_75 == doctest::Approx(90.0));
+  CHECK(stats.percentile_90 == doctest::Approx(96.0));
+}
+
+TEST_CASE("compute_score_statistics 与两遍算法和完整排序一致") {
+  for (std::size_t count : {1u, 2u, 1023u, 1024u, 1025u, 50000u}) {
+    std::mt19937 rng(static_cast<unsigned>(count));
+    std::uniform_real_distribution<double> dist(0.0, 100.0);
+    std::vector<double> scores(count);
+    for (auto& score : scores) {
+      score = dist(rng);
+    }
+
+    double mean = 0.0;
+    for (double score : scores) {
+      mean += score;
+    }
+    mean /= static_cast<double>(count);
+    double variance = 0.0;
+    for (double score : scores) {
+      variance += (score - mean) * (score - mean);
+    }
+    variance /= static_cast<double>(count);
+
+    auto stats = compute_score_statistics(scores.data(), scores.size());
+    CHECK(stats.count == count);
+    CHECK(stats.mean == doctest::Approx(mean));
+    CHECK(stats.variance == doctest::Approx(variance));
+    CHECK(stats.min == *std::min_element(scores.begin(), scores.end()));
+    CHECK(stats.max == *std::max_element(scores.begin(), scores.end()));
+    CHECK(stats.percentile_25 == doctest::Approx(sorted_percentile(scores, 25.0)));
+    CHECK(stats.median == doctest::Approx(sorted_percentile(scores, 50.0)));
+    CHECK(stats.percentile_75 == doctest::Approx(sorted_percentile(scores, 75.0)));
+    CHECK(stats.percentile_90 == doctest::Approx(sorted_percentile(scores, 90.0)));
+  }
+}
+
+TEST_CASE("compute_score_statistics 数值稳定性") {
+  // 均值很大、方差很小时，朴素的 E[x^2] - E[x]^2 公式会严重失真
+  std::vector<double> scores;
+  for (int i = 0; i < 10000; ++i) {
+    scores.push_back(1e9 + (i % 2 == 0 ? 0.5 : -0.5));
+  }
+  auto stats = compute_score_statistics(scores.data(), scores.size());
+  CHECK(stats.mean == doctest::Approx(1e9));
+  CHECK(stats.variance == doctest::Approx(0.25));
+}
+
+TEST_CASE("StudentManager compute_statistics") {
+  StudentManager manager;
+  CHECK(manager.compute_statistics().count == 0);
+
+  manager.add_student(Student("学生A", "7000001", 60.0));
+  manager.add_student(Student("学生B", "7000002", 80.0));
+  manager.add_student(Student("学生C", "7000003", 100.0));
+  manager.update_score("7000001", 40.0);
+
+  auto stats = manager.compute_statistics();
+  CHECK(stats.count == 3);
+  CHECK(stats.mean == doctest::Approx(manager.calculate_average_score()));
+  CHECK(stats.min == doctest::Approx(40.0));
+  CHECK(stats.max == doctest::Approx(100.0));
+  CHECK(stats.median == doctest::Approx(80.0));
+}
@@ -0,0 +1,155 @@
+/**
+ * @file string_storage_tests.cpp
+ * @brief 紧凑字符串和字符串区单元测试
+ */
+
+#include <doctest/doctest.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "student_manager/compact_string.h"
+#include "student_manager/string_arena.h"
+#include "student_manager/student_manager.h"
+
+using namespace student_manager;
+
+TEST_CASE("CompactString 内部与外部存储") {
+  static_assert(sizeof(CompactString) == 16);
+
+  CompactString empty;
+  CHECK(empty.view().empty());
+  CHECK(empty.is_inline());
+
+  CompactString short_text("张三丰");  // 9 字节
+  CHECK(short_text.is_inline());
+  CHECK(short_text.view() == "张三丰");
+
+  CompactString boundary(std::string(15, 'x'));
+  CHECK(boundary.is_inline());
+  CHECK(boundary.size() == 15);
+
+  CompactString long_text("Alexander Hamilton");
+  CHECK(long_text.on_heap());
+  CHECK(long_text.view() == "Alexander Hamilton");
+
+  CompactString copy = long_text;
+  CHECK(copy.view() == long_text.view());
+  CHECK(copy.view().data() != long_text.view().data());
+
+  CompactString moved = std::move(copy);
+  CHECK(moved.view() == "Alexander Hamilton");
+  CHECK(copy.view().empty());
+
+  moved = short_text;
+  CHECK(moved.is_inline());
+  CHECK(moved.view() == "张三丰");
+}
+
+TEST_CASE("CompactString 搬到字符串区") {
+  StringArena arena;
+  CompactString text("a rather long student name");
+  text.move_to_arena(arena.allocate(text.size()));
+  CHECK(text.in_arena());
+  CHECK(text.view() == "a rather long student name");
+  CHECK(arena.bytes_used() == text.size());
+
+  // 拷贝总是得到自己拥有的堆内存
+  CompactString copy = text;
+  CHECK(copy.on_heap());
+  CHECK(copy.view() == text.view());
+}
+
+TEST_CASE("StringArena 分配") {
+  StringArena arena;
+  char* a = arena.allocate(10);
+  char* b = arena.allocate(20);
+  CHECK(b == a + 10);
+  CHECK(arena.bytes_used() == 30);
+  CHECK(arena.bytes_reserved() == StringArena::kBlockSize);
+
+  // 较大的请求单独占一块，不影响当前块
+  CHECK(arena.allocate(StringArena::kBlockSize) != nullptr);
+  CHECK(arena.allocate(1) == b + 20);
+
+  StringArena moved = std::move(arena);
+  CHECK(moved.bytes_used() == 30 + StringArena::kBlockSize + 1);
+  CHECK(arena.bytes_used() == 0);
+
+  moved.clear();
+  CHECK(moved.bytes_reserved() == 0);
+}
+
+TEST_CASE("StudentManager 长姓名和长学号存放在字符串区") {
+  StudentManager manager;
+  const std::string long_name = "Maximilian Alexander Schmidt";
+  for (int i = 0; i < 100; ++i) {
+    manager.add_student(Student(long_name, "CS-2024-LONG-" + std::to_string(i), 70.0));
+  }
+  manager.add_student(Student("张三", "2023001", 85.0));
+
+  auto usage = manager.memory_usage();
+  CHECK(usage.students == 101);
+  CHECK(usage.strings == StringArena::kBlockSize);  // 全部长字符串在同一个内存块中
+  CHECK(usage.bytes_per_student() > 0.0);
+
+  // 拷贝出来的学生不依赖管理器的字符串区
+  Student copy = manager.find_student("CS-2024-LONG-7")->get();
+  {
+    StudentManager copied = manager;
+    CHECK(copied.find_student("CS-2024-LONG-99")->get().get_name() == long_name);
+    manager.clear();
+  }
+  CHECK(copy.get_name() == long_name);
+  CHECK(copy.get_id() == "CS-2024-LONG-7");
+}
+
+TEST_CASE("StudentManager 删除大量学生后整理字符串区") {
+  StudentManager manager;
+  const std::string padding(200, 'n');
+  for (int i = 0; i < 2000; ++i) {
+    manager.add_student(Student(padding + std::to_string(i), "LONG-ID-000000-" + std::to_string(i)));
+  }
+  std::size_t before = manager.memory_usage().strings;
+  for (int i = 0; i < 1900; ++i) {
+    manager.remove_student("LONG-ID-000000-" + std::to_string(i));
+  }
+  CHECK(manager.memory_usage().strings < before / 4);
+
+  // 整理之后剩下的学生数据完好，学号索引仍然可用
+  for (int i = 1900; i < 2000; ++i) {
+    auto student = manager.find_student("LONG-ID-000000-" + std::to_string(i));
+    REQUIRE(student.has_value());
+    CHECK(student->get().get_name() == padding + std::to_string(i));
+  }
+}
+
+TEST_CASE("从管理器中的学生移动出来时复制字符串") {
+  StudentManager manager;
+  const std::string padding(200, 'n');
+  for (int i = 0; i < 5000; ++i) {
+    manager.add_student(Student(padding + std::to_string(i), "LONG-ID-000000-" + std::to_string(i)));
+  }
+  const std::string kept_id = "LONG-ID-000000-4999";
+  Student moved(std::move(manager.find_student(kept_id)->get()));
+  Student swapped("短名", "SHORT-1", 10.0);
+  std::swap(manager.find_student("LONG-ID-000000-4998")->get(), swapped);
+
+  // 删除其余学生，强制整理字符串区、释放旧的内存块
+  for (int i = 0; i < 4998; ++i) {
+    manager.remove_student("LONG-ID-000000-" + std::to_string(i));
+  }
+  CHECK(moved.get_name() == padding + "4999");
+  CHECK(moved.get_id() == kept_id);
+  CHECK(swapped.get_name() == padding + "4998");
+  CHECK(swapped.get_id() == "LONG-ID-000000-4998");
+
+  // 管理器中的记录保持不变，学号仍然可以查找、拒绝重复和删除
+  REQUIRE(manager.find_student(kept_id).has_value());
+  CHECK(manager.find_student(kept_id)->get().get_name() == padding + "4999");
+  CHECK(manager.find_student("SHORT-1").has_value());
+  CHECK_FALSE(manager.add_student(Student("重复", kept_id)));
+  CHECK(manager.remove_student(kept_id));
+  CHECK(manager.get_student_count() == 1);
+}
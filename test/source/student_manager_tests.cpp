@@ -14,6 +14,12 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include <doctest/doctest.h>
 
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 #include "student_manager/student_manager.h"
 
 using namespace student_manager;
@@ -147,6 +153,40 @@ TEST_CASE("StudentManager 通过引用修改学生") {
   CHECK(verify->get().get_score() == doctest::Approx(95.0));
 }
 
+TEST_CASE("StudentManager 通过引用整体替换学生") {
+  StudentManager manager;
+  manager.enable_name_index();
+  manager.add_student(Student("x", "100", 1.0));
+  manager.add_student(Student("z", "300", 3.0));
+  CHECK(manager.sorted_by(SortKey::id).front().get_id() == "100");
+
+  manager.find_student("100")->get() = Student("y", "200", 2.0);
+
+  CHECK_FALSE(manager.find_student("100").has_value());
+  REQUIRE(manager.find_student("200").has_value());
+  CHECK(manager.find_student("200")->get().get_name() == "y");
+  CHECK(manager.find_students_by_name("x").empty());
+  CHECK(manager.find_students_by_name("y").size() == 1);
+  CHECK(manager.sorted_by(SortKey::id).front().get_id() == "200");
+  CHECK(manager.sorted_by(SortKey::name).front().get_name() == "y");
+  CHECK(*manager.get_max_score() == doctest::Approx(3.0));
+  CHECK(*manager.get_min_score() == doctest::Approx(2.0));
+
+  // 学号与另一个学生重复时拒绝，不做任何修改
+  CHECK_THROWS_AS(manager.find_student("200")->get() = Student("w", "300", 50.0),
+                  std::invalid_argument);
+  CHECK(manager.find_student("200")->get().get_name() == "y");
+  CHECK(manager.find_student("300")->get().get_name() == "z");
+  CHECK(manager.get_student_count() == 2);
+
+  // 长姓名和长学号放在字符串区中，替换后仍然能找到
+  std::string long_id(40, '7');
+  manager.find_student("300")->get() = Student(std::string(30, 'n'), long_id, 4.0);
+  REQUIRE(manager.find_student(long_id).has_value());
+  CHECK(manager.find_student(long_id)->get().get_name() == std::string(30, 'n'));
+  CHECK_FALSE(manager.find_student("300").has_value());
+}
+
 TEST_CASE("StudentManager 计算平均分") {
   StudentManager manager;
 
@@ -243,3 +283,304 @@ TEST_CASE("边界条件：单个学生平均分") {
   CHECK(*manager.get_max_score() == doctest::Approx(75.5));
   CHECK(*manager.get_min_score() == doctest::Approx(75.5));
 }
+
+// ==================== 学号索引测试 ====================
+
+TEST_CASE("StudentManager 删除后其他学生仍可查找") {
+  StudentManager manager;
+
+  manager.add_student(Student("学生1", "3000001", 60.0));
+  manager.add_student(Student("学生2", "3000002", 70.0));
+  manager.add_student(Student("学生3", "3000003", 80.0));
+
+  CHECK(manager.remove_student("3000001") == true);
+
+  REQUIRE(manager.find_student("3000002").has_value());
+  REQUIRE(manager.find_student("3000003").has_value());
+  CHECK(manager.find_student("3000003")->get().get_score() == doctest::Approx(80.0));
+  CHECK(manager.find_student("3000001").has_value() == false);
+
+  // 删除后可以重新添加同一学号
+  CHECK(manager.add_student(Student("学生1", "3000001", 65.0)) == true);
+  CHECK(manager.get_student_count() == 3);
+}
+
+TEST_CASE("StudentManager 清空后索引同步清空") {
+  StudentManager manager;
+
+  manager.add_student(Student("学生1", "3100001", 60.0));
+  manager.clear();
+
+  CHECK(manager.find_student("3100001").has_value() == false);
+  CHECK(manager.add_student(Student("学生1", "3100001", 60.0)) == true);
+}
+
+TEST_CASE("IdIndex 与线性查找结果一致（随机操作）") {
+  StudentManager manager;
+  std::vector<Student> reference;  // 用最朴素的线性查找作为参照
+
+  auto linear_find = [&reference](const std::string& id) {
+    return std::find_if(reference.begin(), reference.end(),
+                        [&id](const Student& s) { return s.get_id() == id; });
+  };
+
+  std::mt19937 rng(20240601);
+  std::uniform_int_distribution<int> id_dist(0, 499);
+  std::uniform_int_distribution<int> op_dist(0, 99);
+
+  for (int step = 0; step < 20000; ++step) {
+    std::string id = std::to_string(id_dist(rng));
+    int op = op_dist(rng);
+
+    if (op < 45) {
+      bool expected = linear_find(id) == reference.end();
+      if (expected) {
+        reference.emplace_back("学生" + id, id, static_cast<double>(step % 101));
+      }
+      CHECK(manager.add_student(Student("学生" + id, id, static_cast<double>(step % 101)))
+            == expected);
+    } else if (op < 80) {
+      auto it = linear_find(id);
+      bool expected = it != reference.end();
+      if (expected) {
+        reference.erase(it);
+      }
+      CHECK(manager.remove_student(id) == expected);
+    } else if (op < 99) {
+      auto it = linear_find(id);
+      auto result = manager.find_student(id);
+      REQUIRE(result.has_value() == (it != reference.end()));
+      if (result) {
+        CHECK(result->get().get_id() == id);
+        CHECK(result->get().get_score() == doctest::Approx(it->get_score()));
+      }
+    } else {
+      reference.clear();
+      manager.clear();
+    }
+
+    REQUIRE(manager.get_student_count() == static_cast<int>(reference.size()));
+  }
+
+  for (const auto& student : reference) {
+    CHECK(manager.find_student(student.get_id()).has_value());
+  }
+}
+
+// ==================== 句柄测试 ====================
+
+TEST_CASE("StudentHandle 在其他学生增删后仍然有效") {
+  StudentManager manager;
+
+  auto handle = manager.insert_student(Student("句柄测试", "4000001", 70.0));
+  REQUIRE(handle.has_value());
+
+  // 大量添加会触发扩容，删除前面的学生会移动元素
+  for (int i = 0; i < 1000; ++i) {
+    manager.add_student(Student("填充", "41" + std::to_string(i), 60.0));
+  }
+  for (int i = 0; i < 500; ++i) {
+    manager.remove_student("41" + std::to_string(i));
+  }
+
+  REQUIRE(manager.contains(*handle));
+  auto student = manager.get_student(*handle);
+  REQUIRE(student.has_value());
+  CHECK(student->get().get_id() == "4000001");
+
+  student->get().set_score(99.0);
+  CHECK(manager.find_student("4000001")->get().get_score() == doctest::Approx(99.0));
+}
+
+TEST_CASE("StudentHandle 删除后失效且不会指向新学生") {
+  StudentManager manager;
+
+  auto handle = manager.insert_student(Student("旧学生", "4100001", 70.0));
+  REQUIRE(handle.has_value());
+  CHECK(manager.insert_student(Student("重复", "4100001", 80.0)).has_value() == false);
+
+  CHECK(manager.remove_student(*handle) == true);
+  CHECK(manager.contains(*handle) == false);
+  CHECK(manager.remove_student(*handle) == false);
+
+  // 新学生会复用同一个槽位，但代数不同
+  auto reused = manager.insert_student(Student("新学生", "4100002", 80.0));
+  REQUIRE(reused.has_value());
+  CHECK(reused->slot == handle->slot);
+  CHECK(*reused != *handle);
+  CHECK(manager.get_student(*handle).has_value() == false);
+  CHECK(manager.get_student(*reused)->get().get_id() == "4100002");
+}
+
+TEST_CASE("StudentHandle get_handle 与清空") {
+  StudentManager manager;
+  manager.add_student(Student("学生1", "4200001", 60.0));
+  manager.add_student(Student("学生2", "4200002", 70.0));
+
+  auto handle = manager.get_handle("4200002");
+  REQUIRE(handle.has_value());
+  CHECK(manager.get_handle("9999999").has_value() == false);
+
+  CHECK(manager.remove_student("4200001") == true);
+  const StudentManager& const_manager = manager;
+  REQUIRE(const_manager.get_student(*handle).has_value());
+  CHECK(const_manager.get_student(*handle)->get().get_name() == "学生2");
+
+  manager.clear();
+  CHECK(manager.contains(*handle) == false);
+}
+
+// ==================== 增量统计测试 ====================
+
+TEST_CASE("StudentManager 统计量随增删改同步更新") {
+  StudentManager manager;
+
+  manager.add_student(Student("学生A", "5000001", 60.0));
+  manager.add_student(Student("学生B", "5000002", 95.0));
+  manager.add_student(Student("学生C", "5000003", 75.0));
+
+  // 通过 update_score 修改
+  CHECK(manager.update_score("5000002", 70.0) == true);
+  CHECK(manager.update_score("9999999", 70.0) == false);
+  CHECK(*manager.get_max_score() == doctest::Approx(75.0));
+  CHECK(manager.calculate_average_score() == doctest::Approx(205.0 / 3));
+
+  // 通过 find_student 返回的引用修改，管理器同样能感知
+  manager.find_student("5000001")->get().set_score(100.0);
+  CHECK(*manager.get_max_score() == doctest::Approx(100.0));
+  CHECK(*manager.get_min_score() == doctest::Approx(70.0));
+  CHECK(manager.calculate_average_score() == doctest::Approx(245.0 / 3));
+
+  // 删除最高分
+  manager.remove_student("5000001");
+  CHECK(*manager.get_max_score() == doctest::Approx(75.0));
+  CHECK(manager.calculate_average_score() == doctest::Approx(72.5));
+
+  manager.clear();
+  CHECK(manager.get_max_score().has_value() == false);
+  CHECK(manager.calculate_average_score() == doctest::Approx(0.0));
+}
+
+TEST_CASE("StudentManager 拷贝出的学生修改成绩不影响管理器") {
+  StudentManager manager;
+  manager.add_student(Student("学生A", "5100001", 60.0));
+
+  Student copy = manager.find_student("5100001")->get();
+  copy.set_score(100.0);
+
+  CHECK(*manager.get_max_score() == doctest::Approx(60.0));
+  CHECK(manager.find_student("5100001")->get().get_score() == doctest::Approx(60.0));
+}
+
+TEST_CASE("StudentManager 拷贝和移动后统计量各自独立") {
+  StudentManager original;
+  original.add_student(Student("学生A", "5200001", 60.0));
+  original.add_student(Student("学生B", "5200002", 80.0));
+
+  StudentManager copy = original;
+  copy.find_student("5200001")->get().set_score(100.0);
+
+  CHECK(*original.get_max_score() == doctest::Approx(80.0));
+  CHECK(*copy.get_max_score() == doctest::Approx(100.0));
+
+  StudentManager moved = std::move(copy);
+  moved.find_student("5200002")->get().set_score(10.0);
+  CHECK(*moved.get_min_score() == doctest::Approx(10.0));
+  CHECK(moved.calculate_average_score() == doctest::Approx(55.0));
+
+  original = moved;
+  CHECK(*original.get_min_score() == doctest::Approx(10.0));
+  original.find_student("5200002")->get().set_score(50.0);
+  CHECK(*original.get_min_score() == doctest::Approx(50.0));
+  CHECK(*moved.get_min_score() == doctest::Approx(10.0));
+}
+
+TEST_CASE("StudentManager 增量统计与全量计算一致（随机操作）") {
+  StudentManager manager;
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> id_dist(0, 299);
+  std::uniform_int_distribution<int> score_dist(0, 10000);
+
+  for (int step = 0; step < 5000; ++step) {
+    std::string id = std::to_string(id_dist(rng));
+    double score = score_dist(rng) / 100.0;
+    switch (step % 3) {
+      case 0:
+        manager.add_student(Student("学生", id, score));
+        break;
+      case 1:
+        manager.update_score(id, score);
+        break;
+      default:
+        if (step % 7 == 0) {
+          manager.remove_student(id);
+        } else if (auto student = manager.find_student(id)) {
+          student->get().set_score(score);
+        }
+    }
+  }
+
+  REQUIRE(manager.empty() == false);
+  double sum = 0.0;
+  double max_score = 0.0;
+  double min_score = 100.0;
+  for (const auto& student : manager) {
+    sum += student.get_score();
+    max_score = std::max(max_score, student.get_score());
+    min_score = std::min(min_score, student.get_score());
+  }
+  CHECK(manager.calculate_average_score()
+        == doctest::Approx(sum / manager.get_student_count()));
+  CHECK(*manager.get_max_score() == max_score);
+  CHECK(*manager.get_min_score() == min_score);
+}
+
+// ==================== 批量添加测试 ====================
+
+TEST_CASE("StudentManager 批量添加并报告每一行的结果") {
+  StudentManager manager;
+  manager.add_student(Student("已有学生", "6000001", 80.0));
+
+  std::vector<Student> batch;
+  batch.emplace_back("新学生1", "6000002", 70.0);
+  batch.emplace_back("重复已有", "6000001", 90.0);
+  batch.emplace_back("新学生2", "6000003", 60.0);
+  batch.emplace_back("批内重复", "6000002", 50.0);
+
+  auto results = manager.add_students(batch);  // 左值：拷贝元素
+
+  REQUIRE(results.size() == 4);
+  CHECK(results[0] == AddStatus::added);
+  CHECK(results[1] == AddStatus::duplicate_existing);
+  CHECK(results[2] == AddStatus::added);
+  CHECK(results[3] == AddStatus::duplicate_in_batch);
+
+  CHECK(manager.get_student_count() == 3);
+  CHECK(batch[0].get_name() == "新学生1");  // 左值范围不会被移动
+  CHECK(manager.find_student("6000002")->get().get_score() == doctest::Approx(70.0));
+  CHECK(manager.find_student("6000001")->get().get_name() == "已有学生");
+  CHECK(manager.calculate_average_score() == doctest::Approx(70.0));
+}
+
+TEST_CASE("StudentManager 批量添加大规模数据") {
+  constexpr int count = 100000;
+  std::vector<Student> roster;
+  roster.reserve(count);
+  for (int i = 0; i < count; ++i) {
+    roster.emplace_back("学生", std::to_string(1000000 + i), static_cast<double>(i % 101));
+  }
+
+  StudentManager manager;
+  manager.reserve(count);
+  auto results = manager.add_students(std::move(roster));
+
+  CHECK(manager.get_student_count() == count);
+  CHECK(std::count(results.begin(), results.end(), AddStatus::added) == count);
+  CHECK(manager.find_student("1099999").has_value());
+
+  // 预留空间后再修改成绩，统计量依然正确
+  manager.reserve(2 * count);
+  manager.find_student("1000000")->get().set_score(100.0);
+  CHECK(*manager.get_min_score() == doctest::Approx(0.0));
+  CHECK(manager.find_student("1000000")->get().get_score() == doctest::Approx(100.0));
+}